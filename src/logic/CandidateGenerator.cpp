@@ -3,13 +3,16 @@
 // Do not distribute or modify
 // Author: DragonTaki (https://github.com/DragonTaki)
 // Create Date: 2025/10/02
-// Update Date: 2025/10/20
-// Version: v2.1
+// Update Date: 2026/10/17
+// Version: v2.5
 /* ----- ----- ----- ----- */
 
 #include "CandidateGenerator.h"
+#include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <functional>
+#include <random>
 #include <stdexcept>
 #include <unordered_map>
 
@@ -18,6 +21,8 @@
 #include "ExpressionValidator.h"
 #include "core/constants/ExpressionConstants.h"
 #include "core/logging/AppLogger.h"
+#include "util/PerfProbes.h"
+#include "util/TraceRecorder.h"
 
 #define FMT_HEADER_ONLY
 #include "core.h"
@@ -55,6 +60,37 @@ std::string tokenVecToString(const std::vector<Expression::Token>& tokensList) {
     return exprLine;
 }
 
+/**
+ * @brief Counts the ways to complete an unconstrained LHS, the way the DFS builds it.
+ *
+ * @param maxLength Longest LHS counted.
+ * @param operatorCount Number of allowed operators.
+ * @return std::vector<std::array<double, 4>> Entry [remaining][isAfterDigit * 2 + hasOperator].
+ *
+ * <summary>
+ * A number starts with 1-9 and goes on with any digit; an operator may follow a digit
+ * only. A complete LHS ends in a digit and holds at least one operator, so entry
+ * [length][0] counts every LHS of that length. Kept in `double`, since long
+ * expressions overflow 64 bits.
+ * </summary>
+ */
+std::vector<std::array<double, 4>> countLeftCompletions(int maxLength, double operatorCount) {
+    const double leadingDigitCount = static_cast<double>(Expression::DIGIT_SYMBOLS.size() - 1);  // No leading '0'
+    const double digitCount = static_cast<double>(Expression::DIGIT_SYMBOLS.size());
+
+    std::vector<std::array<double, 4>> completionsList(static_cast<size_t>((std::max)(maxLength, 0)) + 1);
+    completionsList[0] = { 0.0, 0.0, 0.0, 1.0 };  // Nothing left: valid only after a digit, with an operator
+    for (size_t remaining = 1; remaining < completionsList.size(); ++remaining) {
+        const std::array<double, 4>& nextCounts = completionsList[remaining - 1];
+        std::array<double, 4>& counts = completionsList[remaining];
+        for (int hasOperator = 0; hasOperator < 2; ++hasOperator) {
+            counts[hasOperator] = leadingDigitCount * nextCounts[2 + hasOperator];
+            counts[2 + hasOperator] = digitCount * nextCounts[2 + hasOperator] + operatorCount * nextCounts[1];
+        }
+    }
+    return completionsList;
+}
+
 }  // namespace (end of internal helpers)
 
 /** =========================
@@ -196,13 +232,132 @@ bool CandidateGenerator::isRhsLengthFeasible(
     return maxDigits >= rhsLength;
 }
 
+/**
+ * @brief Counts the LHS sequences an unconstrained generation evaluates.
+ *
+ * @param expLength Target expression length.
+ * @param operatorsSet Set of allowed operators.
+ * @return double Evaluations summed over the '=' positions that pass `isRhsLengthFeasible`.
+ *
+ * <summary>
+ * Without constraints, every LHS the DFS completes is a number, then any number of
+ * (operator, number) pairs, where a number is 1-9 followed by any digits. Counted by
+ * length, ending in a digit or an operator, and with or without an operator so far;
+ * only sequences with an operator reach the evaluation. The DFS also rejects "^^"
+ * chains, so the count is an upper bound when '^' is allowed. Kept in `double`, since
+ * long expressions overflow 64 bits.
+ * </summary>
+ */
+double CandidateGenerator::countUnconstrainedEvaluations(int expLength, const std::unordered_set<char>& operatorsSet) const {
+    const std::vector<std::array<double, 4>> completionsList =
+        countLeftCompletions(expLength, static_cast<double>(operatorsSet.size()));
+
+    double evaluationTotal = 0.0;
+    for (int eqPos = expLength - 2; eqPos >= 3; --eqPos) {
+        if (isRhsLengthFeasible(eqPos, expLength - eqPos - 1, operatorsSet))
+            evaluationTotal += completionsList[static_cast<size_t>(eqPos)][0];
+    }
+    return evaluationTotal;
+}
+
+/**
+ * @brief Draws one valid expression, every expression of the configuration being equally likely.
+ *
+ * @param expLength Target length of the full expression.
+ * @param operatorsSet Set of allowed operators.
+ * @param randomGenerator Source of randomness.
+ * @param maxAttemptCount Most LHS sequences drawn before giving up.
+ * @return std::optional<std::string> Expression, or nothing if none was found within `maxAttemptCount` attempts.
+ *
+ * <summary>
+ * Every expression has exactly one LHS, so drawing LHS sequences uniformly (weighted by
+ * `countLeftCompletions` over the feasible '=' positions) and keeping those that evaluate
+ * to a RHS of the right length draws expressions uniformly. A kept expression is
+ * confirmed by a generation pinned to it (all green), so it is exactly one the full
+ * search would produce; only that one path is searched.
+ * </summary>
+ */
+std::optional<std::string> CandidateGenerator::drawExpression(
+    int expLength,
+    const std::unordered_set<char>& operatorsSet,
+    std::mt19937_64& randomGenerator,
+    size_t maxAttemptCount
+) {
+    const std::vector<std::array<double, 4>> completionsList =
+        countLeftCompletions(expLength, static_cast<double>(operatorsSet.size()));
+    std::vector<char> operatorsList(operatorsSet.begin(), operatorsSet.end());
+    std::sort(operatorsList.begin(), operatorsList.end());  // Same draws for the same seed
+
+    std::vector<double> eqPosWeightsList(static_cast<size_t>((std::max)(expLength, 0)), 0.0);
+    double weightTotal = 0.0;
+    for (int eqPos = expLength - 2; eqPos >= 3; --eqPos) {
+        if (!isRhsLengthFeasible(eqPos, expLength - eqPos - 1, operatorsSet)) continue;
+        eqPosWeightsList[static_cast<size_t>(eqPos)] = completionsList[static_cast<size_t>(eqPos)][0];
+        weightTotal += eqPosWeightsList[static_cast<size_t>(eqPos)];
+    }
+    if (weightTotal <= 0.0 || operatorsList.empty()) return std::nullopt;
+
+    std::discrete_distribution<int> eqPosDistribution(eqPosWeightsList.begin(), eqPosWeightsList.end());
+    std::uniform_int_distribution<size_t> digitDistribution(0, Expression::DIGIT_SYMBOLS.size() - 1);
+    std::uniform_int_distribution<size_t> leadingDigitDistribution(1, Expression::DIGIT_SYMBOLS.size() - 1);
+    std::uniform_int_distribution<size_t> operatorDistribution(0, operatorsList.size() - 1);
+    const std::string allGreenLine(static_cast<size_t>(expLength), 'g');
+
+    std::string lhsLine;
+    for (size_t attemptIndex = 0; attemptIndex < maxAttemptCount; ++attemptIndex) {
+        // Step 1: Uniform LHS of a feasible length
+        const int eqPos = eqPosDistribution(randomGenerator);
+        lhsLine.clear();
+        bool isAfterDigit = false;
+        int hasOperator = 0;
+        for (int remaining = eqPos; remaining > 0; --remaining) {
+            const std::array<double, 4>& nextCounts = completionsList[static_cast<size_t>(remaining - 1)];
+            if (!isAfterDigit) {
+                lhsLine += Expression::DIGIT_SYMBOLS[leadingDigitDistribution(randomGenerator)];
+                isAfterDigit = true;
+                continue;
+            }
+            const double digitWeight = static_cast<double>(Expression::DIGIT_SYMBOLS.size()) * nextCounts[2 + hasOperator];
+            const double operatorWeight = static_cast<double>(operatorsList.size()) * nextCounts[1];
+            if (std::uniform_real_distribution<double>(0.0, digitWeight + operatorWeight)(randomGenerator) < digitWeight) {
+                lhsLine += Expression::DIGIT_SYMBOLS[digitDistribution(randomGenerator)];
+            }
+            else {
+                lhsLine += operatorsList[operatorDistribution(randomGenerator)];
+                isAfterDigit = false;
+                hasOperator = 1;
+            }
+        }
+
+        // Step 2: Non-negative integer RHS of the remaining length
+        double lhsResult;
+        try {
+            lhsResult = validator.evalExpr(lhsLine);
+        } catch (...) {
+            continue;
+        }
+        if (!validator.isInteger(lhsResult) || lhsResult < 0) continue;
+        const std::string rhsLine = fmt::format("{}", static_cast<long long>(std::round(lhsResult)));
+        if (static_cast<int>(rhsLine.size()) != expLength - eqPos - 1) continue;
+
+        // Step 3: Confirmed by the search itself
+        const std::string exprLine = lhsLine + '=' + rhsLine;
+        std::unordered_map<char, Constraint> pinnedConstraintsMap = initializeConstraintsMap();
+        updateConstraint(pinnedConstraintsMap, exprLine, allGreenLine);
+        CandidateGenerator pinnedGenerator(validator);
+        if (pinnedGenerator.generatePool(expLength, operatorsSet, { exprLine }, { allGreenLine }, pinnedConstraintsMap).size() == 1)
+            return exprLine;
+    }
+    return std::nullopt;
+}
+
 /**
  * @brief Recursive DFS to generate all valid LHS token sequences.
  *
  * @param lhsLength Length of the LHS expression.
  * @param operatorsSet Set of allowed operators.
  * @param currentTokens Current token sequence being built.
- * @param lhsCandidatesList Reference to store generated candidate token sequences.
+ * @param evaluateLeftTokens Callback receiving every complete LHS token sequence.
  * @param lhsConstraintsMap Map of constraints for symbols (min/max counts, green positions).
  * @param requiredCharsAtPos List of characters that must occupy specific positions (green positions).
  * @param dfsDepth Current recursion depth (for logging/debug purposes).
@@ -210,14 +365,15 @@ bool CandidateGenerator::isRhsLengthFeasible(
  * <summary>
  * This function attempts to append valid digits/operators at each position,
  * respects min/max counts, green positions, and merges digit tokens when necessary.
- * Backtracking ensures all valid sequences are explored.
+ * Backtracking ensures all valid sequences are explored. Complete sequences go straight
+ * to `evaluateLeftTokens`; once the evaluation limit is reached, the search unwinds.
  * </summary>
  */
 void CandidateGenerator::_dfsGenerateLeftTokens(
     int lhsLength,
     const std::unordered_set<char>& operatorsSet,
     std::vector<Expression::Token>& currentTokens,
-    std::vector<std::vector<Expression::Token>>& lhsCandidatesList,
+    const std::function<void(const std::vector<Expression::Token>&)>& evaluateLeftTokens,
     std::unordered_map<char, Constraint>& lhsConstraintsMap,
     const std::vector<char>& requiredCharsAtPos,
     int dfsDepth
@@ -229,18 +385,30 @@ void CandidateGenerator::_dfsGenerateLeftTokens(
         AppLogger::Trace(fmt::format("[_dfs, depth={}] lhsLength={}, operators=[{}]", dfsDepth, lhsLength, operatorStr));
     }*/
 
+    if (isLimitReached) return;
+    if (activeStats) ++activeStats->nodeCount;
+    SOLVER_PROBE2(dfs_enter, dfsDepth, currentTokens.size());
+
     // Count used length
     int usedLength = 0;
     for (const auto& t : currentTokens)
         usedLength += static_cast<int>(t.value.size());
     // Not enough length, finish recursion
     if (usedLength >= lhsLength) {
+        if (activeStats) ++activeStats->leafCount;
         // Only token size >= 3 makes sence, e.g. "12 + 34", "9 * 3"
         // Expression must end with digit token
         if (!currentTokens.empty() &&
             currentTokens.size() >= 3 &&
             currentTokens.back().type == Expression::TokenType::Digit) {
-            lhsCandidatesList.push_back(currentTokens);
+            if (evaluationLimit > 0 && evaluatedTotal >= evaluationLimit) {
+                isLimitReached = true;
+                return;
+            }
+            ++evaluatedTotal;
+            evaluateLeftTokens(currentTokens);
+        } else {
+            countPrune(PruneReason::IncompleteLeaf);
         }
         return;
     }
@@ -255,6 +423,7 @@ void CandidateGenerator::_dfsGenerateLeftTokens(
     if (remainingLength < totalMinRequired) {
         /*AppLogger::Trace(fmt::format("[_dfs prune] Not enough space: remainingLength={} < totalMinRequired={}", 
             remainingLength, totalMinRequired));*/
+        countPrune(PruneReason::NotEnoughSpace);
         return;
     }
 
@@ -262,10 +431,14 @@ void CandidateGenerator::_dfsGenerateLeftTokens(
     int currentPosition = usedLength;  ///< Same value as used-length, but represent the position
     auto tryAppendToken = [&](char exprChar) {
         // character-level and position-level check
-        if (!ConstraintUtils::isCharAllowed(exprChar, lhsConstraintsMap))
+        if (!ConstraintUtils::isCharAllowed(exprChar, lhsConstraintsMap)) {
+            countPrune(PruneReason::CharNotAllowed);
             return;  // Check if the character should be passed
-        if (!ConstraintUtils::isCharAllowedAtPos(exprChar, currentPosition, lhsConstraintsMap))
+        }
+        if (!ConstraintUtils::isCharAllowedAtPos(exprChar, currentPosition, lhsConstraintsMap)) {
+            countPrune(PruneReason::BannedPosition);
             return;  // Check if the position can fill in this character
+        }
 
         // Auto determin token type
         Expression::TokenType tokenType =
@@ -284,6 +457,7 @@ void CandidateGenerator::_dfsGenerateLeftTokens(
         if (hasLast && currentTokens[lastIndex].type == Expression::TokenType::Digit && tokenType == Expression::TokenType::Digit) {
             // Digit start with '0' is not allowed
             if (currentTokens[lastIndex].value.size() == 1 && currentTokens[lastIndex].value[0] == '0') {
+                countPrune(PruneReason::LeadingZero);
                 return;
             }
             currentTokens[lastIndex].value.push_back(exprChar);
@@ -299,6 +473,7 @@ void CandidateGenerator::_dfsGenerateLeftTokens(
         if (!isMerged && hasLast) {
             if (!ConstraintUtils::isTokenValid(currentTokens[lastIndex])) {
                 // Previous token invalid => rollback (don't proceed)
+                countPrune(PruneReason::InvalidToken);
                 return;
             }
         }
@@ -317,6 +492,7 @@ void CandidateGenerator::_dfsGenerateLeftTokens(
                 currentTokens[lastIndex].value.pop_back();
             else
                 currentTokens.pop_back();
+            countPrune(PruneReason::InvalidSequence);
             return;
         }
 
@@ -325,7 +501,7 @@ void CandidateGenerator::_dfsGenerateLeftTokens(
             lhsConstraintsMap[exprChar].usedCount()++;
 
         // Recursion
-        _dfsGenerateLeftTokens(lhsLength, operatorsSet, currentTokens, lhsCandidatesList,
+        _dfsGenerateLeftTokens(lhsLength, operatorsSet, currentTokens, evaluateLeftTokens,
             lhsConstraintsMap, requiredCharsAtPos, dfsDepth + 1);
 
         // Backtracking
@@ -365,7 +541,7 @@ void CandidateGenerator::_dfsGenerateLeftTokens(
  * @param lhsLength Length of the LHS expression.
  * @param operatorsSet Set of allowed operators.
  * @param currentTokens Initial token vector (can be empty).
- * @param lhsCandidatesList Reference to store generated LHS token sequences.
+ * @param evaluateLeftTokens Callback receiving every complete LHS token sequence.
  * @param lhsConstraintsMap Symbol constraints map (min/max, used count, green positions).
  * @param dfsDepth Initial DFS recursion depth (usually 0).
  *
@@ -378,7 +554,7 @@ void CandidateGenerator::generateLeftTokens(
     int lhsLength,
     const std::unordered_set<char>& operatorsSet,
     std::vector<Expression::Token> currentTokens,
-    std::vector<std::vector<Expression::Token>>& lhsCandidatesList,
+    const std::function<void(const std::vector<Expression::Token>&)>& evaluateLeftTokens,
     std::unordered_map<char, Constraint>& lhsConstraintsMap,
     int dfsDepth
 ) {
@@ -410,7 +586,7 @@ void CandidateGenerator::generateLeftTokens(
     }*/
 
     // DFS to generate tokens
-    _dfsGenerateLeftTokens(lhsLength, operatorsSet, currentTokens, lhsCandidatesList,
+    _dfsGenerateLeftTokens(lhsLength, operatorsSet, currentTokens, evaluateLeftTokens,
         lhsConstraintsMap, requiredAtPosList, dfsDepth);
 }
 
@@ -425,12 +601,8 @@ void CandidateGenerator::generateLeftTokens(
  * @return std::vector<std::string> List of valid candidate expressions matching constraints.
  *
  * <summary>
- * This is the main entry point to generate all candidate expressions for a given length.
- * - Determines possible '=' positions (respecting green positions and conflicts).
- * - Prunes impossible RHS lengths.
- * - Uses DFS to generate all valid LHS token sequences.
- * - Evaluates each LHS to produce RHS, respecting integer, non-negative, and length rules.
- * - Filters candidates according to min/max constraints using ConstraintUtils.
+ * String front end of `_generateCandidates`; every accepted candidate is copied
+ * into the returned list.
  * </summary>
  */
 std::vector<std::string> CandidateGenerator::generate(
@@ -441,7 +613,66 @@ std::vector<std::string> CandidateGenerator::generate(
     std::unordered_map<char, Constraint>& constraintsMap
 ) {
     std::vector<std::string> finalCandidatesList;  ///< Record possible answer(s)
+    _generateCandidates(expLength, operatorsSet, expressions, expressionColors, constraintsMap,
+        [&finalCandidatesList](const std::string& candidateExprLine) {
+            finalCandidatesList.push_back(candidateExprLine);
+        });
+    return finalCandidatesList;
+}
+
+/**
+ * @brief Generates candidate expressions directly into an interned candidate pool.
+ *
+ * @param expLength Target expression length.
+ * @param operatorsSet Set of allowed operators.
+ * @param expressions Previous expressions for constraint derivation.
+ * @param expressionColors Corresponding color patterns for each expression.
+ * @param constraintsMap Symbol constraints map; will be updated inside.
+ * @return CandidatePool Arena holding every accepted candidate once, in generation order.
+ */
+CandidatePool CandidateGenerator::generatePool(
+    int expLength,
+    const std::unordered_set<char>& operatorsSet,
+    const std::vector<std::string>& expressions,
+    const std::vector<std::string>& expressionColors,
+    std::unordered_map<char, Constraint>& constraintsMap
+) {
+    CandidatePool candidatePool(expLength);
+    _generateCandidates(expLength, operatorsSet, expressions, expressionColors, constraintsMap,
+        [&candidatePool](const std::string& candidateExprLine) {
+            candidatePool.add(candidateExprLine);
+        });
+    return candidatePool;
+}
 
+/**
+ * @brief Core candidate generation shared by `generate` and `generatePool`.
+ *
+ * @param expLength Target expression length.
+ * @param operatorsSet Set of allowed operators.
+ * @param expressions Previous expressions for constraint derivation.
+ * @param expressionColors Corresponding color patterns (green/yellow/gray) for each expression.
+ * @param constraintsMap Symbol constraints map; will be updated inside.
+ * @param acceptCandidate Callback receiving every candidate that passes all checks.
+ *
+ * <summary>
+ * This is the main entry point to generate all candidate expressions for a given length.
+ * - Determines possible '=' positions (respecting green positions and conflicts).
+ * - Prunes impossible RHS lengths.
+ * - Uses DFS to generate all valid LHS token sequences, evaluating each one as soon as it
+ *   is complete to produce the RHS, respecting integer, non-negative, and length rules.
+ * - Filters candidates according to min/max constraints using ConstraintUtils.
+ * </summary>
+ */
+void CandidateGenerator::_generateCandidates(
+    int expLength,
+    const std::unordered_set<char>& operatorsSet,
+    const std::vector<std::string>& expressions,
+    const std::vector<std::string>& expressionColors,
+    std::unordered_map<char, Constraint>& constraintsMap,
+    const std::function<void(const std::string&)>& acceptCandidate
+) {
+    TraceRecorder::Span generateSpan("generate");
     auto formatResult = [&](double val, bool isInt) -> std::string {
         if (isInt) {
             return fmt::format("{}", static_cast<long long>(std::round(val)));
@@ -455,8 +686,9 @@ std::vector<std::string> CandidateGenerator::generate(
         int eqSignPosition,
         int lhsLength,
         int rhsLength,
-        std::unordered_map<char, Constraint> constraintsMap
+        const std::unordered_map<char, Constraint>& constraintsMap
     ) {
+        SOLVER_PROBE2(leaf_eval, eqSignPosition, lhsLength);
         std::string lhsString = tokenVecToString(lhsTokensList);
         /*AppLogger::Trace(fmt::format("[Try eval] LHS='{}' (eqPos={}, lhsLength={})",
             lhsString, eqSignPosition, lhsLength));*/
@@ -467,9 +699,11 @@ std::vector<std::string> CandidateGenerator::generate(
             lhsResult = validator.evalExpr(lhsString);
         } catch (const std::exception& e) {
             //AppLogger::Trace(fmt::format("[Eval Fail] {} : {}", lhsString, e.what()));
+            countPrune(PruneReason::EvalFailed);
             return;
         } catch (...) {
             //AppLogger::Trace(fmt::format("[Eval Fail] {} : Unknown error", lhsString));
+            countPrune(PruneReason::EvalFailed);
             return;
         }
 
@@ -478,28 +712,34 @@ std::vector<std::string> CandidateGenerator::generate(
         std::string rhsString = formatResult(lhsResult, islhsResultInt);
         if (!islhsResultInt) {
             //AppLogger::Trace(fmt::format("[rhs] Reject non-integer rhs {} => {}", lhsString, rhsString));
+            countPrune(PruneReason::NonIntegerResult);
             return;
         }
         // The answer never be negative
         if (lhsResult < 0) {
             //AppLogger::Trace(fmt::format("[rhs] Reject negative rhs {} => {}", lhsString, rhsString));
+            countPrune(PruneReason::NegativeResult);
             return;
         }
         // Check if rhs length match rhsLength
         int rhsSize = rhsString.size();
         if (rhsSize != rhsLength) {
             //AppLogger::Trace(fmt::format("[rhs] {} = {} -> rhs length mismatch ({} != {})", lhsString, rhsString, rhsSize, rhsLength));
+            countPrune(PruneReason::RhsLengthMismatch);
             return;
         }
         // Check if "lhs + '=' + rhs" match constraint min/max
         std::string candidateExprLine = lhsString + '=' + rhsString;
         if(!ConstraintUtils::isCandidateValid(candidateExprLine, constraintsMap)) {
             //AppLogger::Trace(fmt::format("[rhs] Reject mismatch min/max exp {} = {}", lhsString, rhsString));
+            countPrune(PruneReason::ConstraintMismatch);
             return;
         }
 
         //AppLogger::Trace(fmt::format("[rhs] Accept rhs: {} = {}", lhsString, rhsString));
-        finalCandidatesList.push_back(candidateExprLine);
+        if (activeStats) ++activeStats->acceptedCount;
+        SOLVER_PROBE2(candidate_accept, eqSignPosition, candidateExprLine.c_str());
+        acceptCandidate(candidateExprLine);
     };
 
     // Build constraints
@@ -563,20 +803,31 @@ std::vector<std::string> CandidateGenerator::generate(
     }
 
     // Try to generate lhs, sort by '=' positions
+    eqPosStatsList.clear();
+    evaluatedTotal = 0;
+    isLimitReached = false;
+    if (isStatsEnabled) eqPosStatsList.reserve(eqSignPositionsList.size());  // Entries stay put while `activeStats` points at them
     for (int eqPos : eqSignPositionsList) {
         int lhsLength = eqPos;
         int rhsLength = expLength - eqPos - 1;
 
         AppLogger::Debug(fmt::format("===== Processing left tokens for length {} =====", eqPos));
+        TraceRecorder::Span eqPosSpan("eqPosSearch");
+        eqPosSpan.setArg("eqPos", eqPos);
+        if (isStatsEnabled) {
+            eqPosStatsList.push_back({});
+            activeStats = &eqPosStatsList.back();
+            activeStats->eqPos = eqPos;
+        }
 
         // Skip impossible rhs by length feasibility
         if (!isRhsLengthFeasible(lhsLength, rhsLength, operatorsSet)) {
             AppLogger::Debug(fmt::format("[Skip eqPos={}] unrealistic rhsLength {}", eqPos, rhsLength));
+            if (activeStats) activeStats->isRhsFeasible = false;
             continue;
         }
 
         std::vector<Expression::Token> tempLhsTokenList;
-        std::vector<std::vector<Expression::Token>> lhsCandidatesList;
         std::vector<std::unordered_set<char>> lhsAllowed(lhsLength);
 
         std::unordered_map<char, Constraint> lhsConstraintsMap = constraintsMap;
@@ -588,16 +839,114 @@ std::vector<std::string> CandidateGenerator::generate(
             con.minCount() = (std::max)(0, con.minCount() - rhsAvailable);
         }
 
-        AppLogger::Debug("===== Start to generate left tokens =====");
-        // call generator with forbidden and minReq and counts
-        generateLeftTokens(lhsLength, operatorsSet, tempLhsTokenList, lhsCandidatesList, lhsConstraintsMap, 0);
+        // Each complete LHS is evaluated inside the search: eval each lhs, skip negatives,
+        // check rhs length and feedback
+        auto evaluateLeftTokens = [&](const std::vector<Expression::Token>& lhsTokensList) {
+            if (!activeStats) {
+                tryCandidate(lhsTokensList, eqPos, lhsLength, rhsLength, constraintsMap);
+                return;
+            }
+            ++activeStats->evaluatedCount;
+            AllocationTracker::Meter evaluateMeter;
+            tryCandidate(lhsTokensList, eqPos, lhsLength, rhsLength, constraintsMap);
+            const AllocationTracker::Counts evaluateCounts = evaluateMeter.elapsed();
+            activeStats->evaluateAllocations.allocationCount += evaluateCounts.allocationCount;
+            activeStats->evaluateAllocations.allocatedBytes += evaluateCounts.allocatedBytes;
+        };
 
-        AppLogger::Debug("===== Start to eval left tokens =====");
-        // rest as before: eval each lhs, skip negatives, check rhs length and feedback
-        for (auto& lhs : lhsCandidatesList) {
-            tryCandidate(lhs, eqPos, lhsLength, rhsLength, constraintsMap);
+        AppLogger::Debug("===== Start to generate and eval left tokens =====");
+        // call generator with forbidden and minReq and counts
+        {
+            TraceRecorder::Span dfsSpan("dfsLeftTokens");
+            AllocationTracker::Meter dfsMeter;
+            generateLeftTokens(lhsLength, operatorsSet, tempLhsTokenList, evaluateLeftTokens, lhsConstraintsMap, 0);
+            if (activeStats) {
+                // The search total includes the evaluations; keep only the search's own share
+                const AllocationTracker::Counts dfsCounts = dfsMeter.elapsed();
+                activeStats->dfsAllocations = { dfsCounts.allocationCount - activeStats->evaluateAllocations.allocationCount,
+                    dfsCounts.allocatedBytes - activeStats->evaluateAllocations.allocatedBytes };
+            }
+        }
+        if (isLimitReached) {
+            AppLogger::Debug(fmt::format("[Stop eqPos={}] evaluation limit of {} LHS sequences reached", eqPos, evaluationLimit));
+            break;
         }
     } // for eqPos
+    activeStats = nullptr;
 
-    return finalCandidatesList;
+    if (isStatsEnabled) logStats();
+}
+
+/**
+ * @brief Short name of a prune reason, as printed in the summary.
+ *
+ * @param pruneReason Reason to name.
+ * @return const char* Kebab-case name (e.g. `not-enough-space`).
+ */
+const char* CandidateGenerator::getPruneReasonName(PruneReason pruneReason) {
+    switch (pruneReason) {
+        case PruneReason::NotEnoughSpace:     return "not-enough-space";
+        case PruneReason::CharNotAllowed:     return "not-allowed";
+        case PruneReason::BannedPosition:     return "banned-position";
+        case PruneReason::LeadingZero:        return "leading-zero";
+        case PruneReason::InvalidToken:       return "invalid-token";
+        case PruneReason::InvalidSequence:    return "invalid-sequence";
+        case PruneReason::IncompleteLeaf:     return "incomplete-leaf";
+        case PruneReason::EvalFailed:         return "eval-failed";
+        case PruneReason::NonIntegerResult:   return "non-integer";
+        case PruneReason::NegativeResult:     return "negative";
+        case PruneReason::RhsLengthMismatch:  return "rhs-length";
+        case PruneReason::ConstraintMismatch: return "constraint-mismatch";
+        default:                              return "unknown";
+    }
+}
+
+/**
+ * @brief Logs the counters of the last generation at Debug level.
+ *
+ * <summary>
+ * One line per '=' position (nodes, leaves, evaluated, accepted, then every non-zero
+ * prune reason), followed by the same counters summed over all positions. With the
+ * allocator hook compiled in, each line ends with the allocations of the search and
+ * of the evaluation, and per accepted candidate.
+ * </summary>
+ */
+void CandidateGenerator::logStats() const {
+    auto formatCounters = [](const EqPosStats& eqPosStats) {
+        std::string line = fmt::format("nodes={}, leaves={}, evaluated={}, accepted={}",
+            eqPosStats.nodeCount, eqPosStats.leafCount, eqPosStats.evaluatedCount, eqPosStats.acceptedCount);
+        for (size_t i = 0; i < eqPosStats.pruneCountsList.size(); ++i) {
+            if (eqPosStats.pruneCountsList[i] == 0) continue;
+            line += fmt::format(", {}={}", getPruneReasonName(static_cast<PruneReason>(i)), eqPosStats.pruneCountsList[i]);
+        }
+        if (AllocationTracker::isAvailable()) {
+            const std::uint64_t allocationCount =
+                eqPosStats.dfsAllocations.allocationCount + eqPosStats.evaluateAllocations.allocationCount;
+            line += fmt::format(" | allocs dfs={} ({} B), eval={} ({} B), per candidate={:.1f}",
+                eqPosStats.dfsAllocations.allocationCount, eqPosStats.dfsAllocations.allocatedBytes,
+                eqPosStats.evaluateAllocations.allocationCount, eqPosStats.evaluateAllocations.allocatedBytes,
+                static_cast<double>(allocationCount) / static_cast<double>((std::max)(size_t{1}, eqPosStats.acceptedCount)));
+        }
+        return line;
+    };
+
+    EqPosStats totalStats;
+    for (const EqPosStats& eqPosStats : eqPosStatsList) {
+        if (!eqPosStats.isRhsFeasible) {
+            AppLogger::Debug(fmt::format("[Stats eqPos={}] skipped (rhs length infeasible)", eqPosStats.eqPos));
+            continue;
+        }
+        AppLogger::Debug(fmt::format("[Stats eqPos={}] {}", eqPosStats.eqPos, formatCounters(eqPosStats)));
+        totalStats.nodeCount += eqPosStats.nodeCount;
+        totalStats.leafCount += eqPosStats.leafCount;
+        totalStats.evaluatedCount += eqPosStats.evaluatedCount;
+        totalStats.acceptedCount += eqPosStats.acceptedCount;
+        for (size_t i = 0; i < eqPosStats.pruneCountsList.size(); ++i)
+            totalStats.pruneCountsList[i] += eqPosStats.pruneCountsList[i];
+        totalStats.dfsAllocations.allocationCount += eqPosStats.dfsAllocations.allocationCount;
+        totalStats.dfsAllocations.allocatedBytes += eqPosStats.dfsAllocations.allocatedBytes;
+        totalStats.evaluateAllocations.allocationCount += eqPosStats.evaluateAllocations.allocationCount;
+        totalStats.evaluateAllocations.allocatedBytes += eqPosStats.evaluateAllocations.allocatedBytes;
+    }
+    AppLogger::Debug(fmt::format("[Stats total] {}", formatCounters(totalStats)));
 }
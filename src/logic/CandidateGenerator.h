@@ -3,18 +3,24 @@
 // Do not distribute or modify
 // Author: DragonTaki (https://github.com/DragonTaki)
 // Create Date: 2025/10/02
-// Update Date: 2025/10/16
-// Version: v2.0
+// Update Date: 2026/10/17
+// Version: v2.4
 /* ----- ----- ----- ----- */
 
 #pragma once
+#include <array>
+#include <functional>
+#include <optional>
+#include <random>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
+#include "CandidatePool.h"
 #include "Constraint.h"
 #include "ExpressionValidator.h"
 #include "core/constants/ExpressionTokens.h"
+#include "util/AllocationTracker.h"
 
 /**
  * @class CandidateGenerator
@@ -29,6 +35,42 @@
  */
 class CandidateGenerator {
 public:
+    /**
+     * @enum PruneReason
+     * @brief Why a DFS branch or an evaluated LHS was dropped.
+     */
+    enum class PruneReason {
+        NotEnoughSpace,      ///< Remaining length cannot hold the symbols still required
+        CharNotAllowed,      ///< Symbol is forbidden or already at its maximum count
+        BannedPosition,      ///< Symbol is known not to be at this position
+        LeadingZero,         ///< Digit appended to a number starting with '0'
+        InvalidToken,        ///< Finished token rejected by `ConstraintUtils::isTokenValid`
+        InvalidSequence,     ///< Rejected by `ConstraintUtils::isTokenSequenceValid`
+        IncompleteLeaf,      ///< Full length, but fewer than 3 tokens or ending in an operator
+        EvalFailed,          ///< LHS evaluation threw
+        NonIntegerResult,    ///< LHS value is not an integer
+        NegativeResult,      ///< LHS value is negative
+        RhsLengthMismatch,   ///< LHS value does not fit the RHS length
+        ConstraintMismatch,  ///< Full expression fails the min/max counts
+        Count
+    };
+
+    /**
+     * @struct EqPosStats
+     * @brief DFS work done for one '=' position by the last `generate`/`generatePool`.
+     */
+    struct EqPosStats {
+        int eqPos = 0;                  ///< Position of '=' (= LHS length)
+        bool isRhsFeasible = true;      ///< False if the position was skipped by `isRhsLengthFeasible`
+        size_t nodeCount = 0;           ///< DFS calls
+        size_t leafCount = 0;           ///< DFS calls that reached the full LHS length
+        size_t evaluatedCount = 0;      ///< Complete LHS sequences evaluated
+        size_t acceptedCount = 0;       ///< Candidates accepted
+        std::array<size_t, static_cast<size_t>(PruneReason::Count)> pruneCountsList{};  ///< Prunes per `PruneReason`
+        AllocationTracker::Counts dfsAllocations;       ///< Heap allocations of the LHS search (see `AllocationTracker`)
+        AllocationTracker::Counts evaluateAllocations;  ///< Heap allocations of the LHS evaluation
+    };
+
     /**
      * @brief Constructs a CandidateGenerator with a reference to an ExpressionValidator.
      * @param validator Reference to an ExpressionValidator used for safe evaluation of expressions.
@@ -66,8 +108,136 @@ public:
         std::unordered_map<char, Constraint>& constraintsMap
     );
 
+    /**
+     * @brief Generates all valid candidate expressions into an interned candidate pool.
+     * @param expLength Target length of the full expression (LHS + '=' + RHS).
+     * @param operatorsSet Set of allowed operators (e.g., '+', '-', '*', '/', '^').
+     * @param expressions Previously guessed expressions used to derive symbol constraints.
+     * @param expressionColors Corresponding color hints for each expression (green/yellow/gray).
+     * @param constraintsMap Map of symbol constraints; will be updated based on input expressions and colors.
+     * @return CandidatePool Arena holding each accepted candidate once, addressed by 32-bit handles.
+     *
+     * <summary>
+     * Same search as `generate()`, but candidates are appended straight into a contiguous
+     * `CandidatePool` instead of individual strings. Handle order equals generation order.
+     * </summary>
+     */
+    CandidatePool generatePool(
+        int expLength,
+        const std::unordered_set<char>& operatorsSet,
+        const std::vector<std::string>& expressions,
+        const std::vector<std::string>& expressionColors,
+        std::unordered_map<char, Constraint>& constraintsMap
+    );
+
+    /**
+     * @brief Enables the DFS counters; each generation then logs a summary at Debug level.
+     *
+     * <summary>
+     * Off by default. When off, the search only tests a null pointer where it would count.
+     * </summary>
+     */
+    void setStatsEnabled(bool isEnabled) { isStatsEnabled = isEnabled; }
+
+    /**
+     * @brief Stops a generation once this many complete LHS sequences have been evaluated (0 = no limit).
+     *
+     * <summary>
+     * Bounds the work of a search whose constraints hardly prune anything, such as the
+     * unconstrained search of `GuessUniverse::build`. A stopped generation keeps the
+     * candidates accepted so far; `isEvaluationLimitReached` tells it from a complete one.
+     * </summary>
+     */
+    void setEvaluationLimit(size_t maxEvaluatedCount) { evaluationLimit = maxEvaluatedCount; }
+
+    /**
+     * @brief True if the last generation stopped at the evaluation limit, so its candidates are incomplete.
+     */
+    bool isEvaluationLimitReached() const { return isLimitReached; }
+
+    /**
+     * @brief Number of LHS sequences a generation without any previous guess evaluates (an upper bound with '^').
+     * @param expLength Target length of the full expression.
+     * @param operatorsSet Set of allowed operators.
+     * @return double Evaluations summed over the feasible '=' positions, without running the search.
+     *
+     * <summary>
+     * Counts the sequences the DFS accepts: numbers without a leading zero, one operator
+     * between two numbers, at least two numbers. Lets a caller refuse a search that could
+     * never finish within `setEvaluationLimit` before spending any time on it.
+     * </summary>
+     */
+    double countUnconstrainedEvaluations(int expLength, const std::unordered_set<char>& operatorsSet) const;
+
+    /**
+     * @brief Draws one valid expression uniformly, without generating the others.
+     * @param expLength Target length of the full expression.
+     * @param operatorsSet Set of allowed operators.
+     * @param randomGenerator Source of randomness.
+     * @param maxAttemptCount Most LHS sequences drawn before giving up.
+     * @return std::optional<std::string> Expression, or nothing if none was found within `maxAttemptCount` attempts.
+     *
+     * <summary>
+     * Draws LHS sequences uniformly and keeps the first one that makes a valid expression,
+     * so each expression of the configuration is equally likely. Costs a few evaluations
+     * per expression drawn instead of a whole `GuessUniverse`.
+     * </summary>
+     */
+    std::optional<std::string> drawExpression(
+        int expLength,
+        const std::unordered_set<char>& operatorsSet,
+        std::mt19937_64& randomGenerator,
+        size_t maxAttemptCount
+    );
+
+    /**
+     * @brief Counters of the last generation, one entry per '=' position tried (empty when disabled).
+     */
+    const std::vector<EqPosStats>& getStats() const { return eqPosStatsList; }
+
+    /**
+     * @brief Short name of a prune reason, as printed in the summary (e.g. `not-enough-space`).
+     */
+    static const char* getPruneReasonName(PruneReason pruneReason);
+
 private:
     ExpressionValidator& validator;  ///< Reference to ExpressionValidator for evaluating expressions
+    bool isStatsEnabled = false;     ///< Collect `eqPosStatsList` during generation
+    std::vector<EqPosStats> eqPosStatsList;  ///< Counters of the last generation
+    EqPosStats* activeStats = nullptr;       ///< Entry of the '=' position being searched; null when disabled
+    size_t evaluationLimit = 0;              ///< Most LHS sequences evaluated per generation (0 = no limit)
+    size_t evaluatedTotal = 0;               ///< LHS sequences evaluated by the current generation
+    bool isLimitReached = false;             ///< The current generation stopped at `evaluationLimit`
+
+    /**
+     * @brief Counts one prune of the position being searched (no-op when disabled).
+     */
+    void countPrune(PruneReason pruneReason) {
+        if (activeStats) ++activeStats->pruneCountsList[static_cast<size_t>(pruneReason)];
+    }
+
+    /**
+     * @brief Logs `eqPosStatsList` at Debug level: one line per '=' position plus totals.
+     */
+    void logStats() const;
+
+    /**
+     * @brief Shared generation core; hands every accepted candidate to `acceptCandidate`.
+     * @param expLength Target length of the full expression.
+     * @param operatorsSet Set of allowed operators.
+     * @param expressions Previously guessed expressions used to derive symbol constraints.
+     * @param expressionColors Corresponding color hints for each expression.
+     * @param constraintsMap Map of symbol constraints; rebuilt from `expressions` and `expressionColors`.
+     * @param acceptCandidate Callback invoked once per valid candidate, in generation order.
+     */
+    void _generateCandidates(
+        int expLength,
+        const std::unordered_set<char>& operatorsSet,
+        const std::vector<std::string>& expressions,
+        const std::vector<std::string>& expressionColors,
+        std::unordered_map<char, Constraint>& constraintsMap,
+        const std::function<void(const std::string&)>& acceptCandidate
+    );
 
     /**
      * @brief Checks whether a RHS length is feasible given a LHS length and operators.
@@ -92,7 +262,7 @@ private:
      * @param lhsLength Total length of the LHS expression.
      * @param operatorsSet Set of allowed operators.
      * @param currentTokens Current token sequence under construction.
-     * @param lhsCandidatesList Reference to store all generated valid LHS token sequences.
+     * @param evaluateLeftTokens Callback invoked with every complete LHS token sequence, as soon as it is found.
      * @param lhsConstraintsMap Symbol constraints map (min/max counts, used count, green positions).
      * @param requiredCharsAtPos Precomputed list of characters fixed at specific positions (green positions).
      * @param dfsDepth Current recursion depth (mainly for logging/debugging).
@@ -100,13 +270,14 @@ private:
      * <summary>
      * This function tries all valid digits/operators at each position, merges digit tokens when possible,
      * respects min/max symbol counts and green positions, and backtracks after recursive calls.
+     * Complete sequences are evaluated on the spot, so the search never holds more than one.
      * </summary>
      */
     void _dfsGenerateLeftTokens(
         int lhsLength,
         const std::unordered_set<char>& operatorsSet,
         std::vector<Expression::Token>& currentTokens,
-        std::vector<std::vector<Expression::Token>>& lhsCandidatesList,
+        const std::function<void(const std::vector<Expression::Token>&)>& evaluateLeftTokens,
         std::unordered_map<char, Constraint>& lhsConstraintsMap,
         const std::vector<char>& requiredCharsAtPos,
         int dfsDepth
@@ -117,7 +288,7 @@ private:
      * @param lhsLength Length of the LHS expression.
      * @param operatorsSet Set of allowed operators.
      * @param currentTokens Initial token sequence (can be empty).
-     * @param lhsCandidatesList Reference to store generated LHS token sequences.
+     * @param evaluateLeftTokens Callback invoked with every complete LHS token sequence.
      * @param lhsConstraintsMap Symbol constraints map (min/max, used count, green positions).
      * @param dfsDepth Initial recursion depth for DFS (usually 0).
      *
@@ -130,7 +301,7 @@ private:
         int lhsLength,
         const std::unordered_set<char>& operatorsSet,
         std::vector<Expression::Token> currentTokens,
-        std::vector<std::vector<Expression::Token>>& lhsCandidatesList,
+        const std::function<void(const std::vector<Expression::Token>&)>& evaluateLeftTokens,
         std::unordered_map<char, Constraint>& lhsConstraintsMap,
         int dfsDepth
     );
@@ -0,0 +1,112 @@
+/* ----- ----- ----- ----- */
+// CandidatePool.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#include "CandidatePool.h"
+#include <format>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+/**
+ * @brief Clears the pool and sets the expression length for new entries.
+ *
+ * @param newExprLength Length of every expression stored afterwards.
+ */
+void CandidatePool::reset(int newExprLength) {
+    clear();
+    exprLength = newExprLength;
+}
+
+/**
+ * @brief Releases every candidate together with the arena memory.
+ */
+void CandidatePool::clear() {
+    std::string().swap(charsArena);  // Swap with an empty container to actually free the buffer
+    std::vector<SymbolHistogram::Histogram>().swap(histogramsList);
+    candidateCount = 0;
+}
+
+/**
+ * @brief Appends a candidate expression to the arena.
+ *
+ * <summary>
+ * The expression is copied once into the contiguous buffer; every later use
+ * refers to it through the returned handle. Its symbol histogram is packed
+ * at the same time when the expression is short enough.
+ * </summary>
+ *
+ * @param exprLine Expression to store.
+ * @return CandidateHandle Handle (arena index) of the stored expression.
+ */
+CandidateHandle CandidatePool::add(std::string_view exprLine) {
+    // Error handling: Every entry must share the same stride
+    if (static_cast<int>(exprLine.size()) != exprLength) {
+        throw std::length_error(std::format(
+            "CandidatePool: expression '{}' has length {}, expected {}", exprLine, exprLine.size(), exprLength));
+    }
+    // Error handling: Handles are 32-bit
+    if (candidateCount >= std::numeric_limits<CandidateHandle>::max()) {
+        throw std::length_error("CandidatePool: too many candidates for 32-bit handles");
+    }
+
+    charsArena.append(exprLine);
+    if (hasHistograms())
+        histogramsList.push_back(SymbolHistogram::build(exprLine));
+    return static_cast<CandidateHandle>(candidateCount++);
+}
+
+/**
+ * @brief Reserves arena space for `expectedCount` expressions.
+ *
+ * @param expectedCount Expected number of candidates.
+ */
+void CandidatePool::reserve(size_t expectedCount) {
+    charsArena.reserve(expectedCount * static_cast<size_t>(exprLength));
+    if (hasHistograms())
+        histogramsList.reserve(expectedCount);
+}
+
+/**
+ * @brief Returns the handles of every stored candidate in insertion order.
+ *
+ * @return std::vector<CandidateHandle> Handles `0 .. size() - 1`.
+ */
+std::vector<CandidateHandle> CandidatePool::getAllHandles() const {
+    std::vector<CandidateHandle> handlesList(candidateCount);
+    std::iota(handlesList.begin(), handlesList.end(), CandidateHandle{0});
+    return handlesList;
+}
+
+/**
+ * @brief Resolves a list of handles into string views.
+ *
+ * @param handlesList Handles to resolve.
+ * @return std::vector<std::string_view> Views into the arena, in the same order.
+ */
+std::vector<std::string_view> CandidatePool::getViews(const std::vector<CandidateHandle>& handlesList) const {
+    std::vector<std::string_view> viewsList;
+    viewsList.reserve(handlesList.size());
+    for (CandidateHandle handle : handlesList)
+        viewsList.push_back(view(handle));
+    return viewsList;
+}
+
+/**
+ * @brief Materialises a list of handles as owned strings.
+ *
+ * @param handlesList Handles to materialise.
+ * @return std::vector<std::string> Copies of the referenced expressions.
+ */
+std::vector<std::string> CandidatePool::toStringList(const std::vector<CandidateHandle>& handlesList) const {
+    std::vector<std::string> stringsList;
+    stringsList.reserve(handlesList.size());
+    for (CandidateHandle handle : handlesList)
+        stringsList.emplace_back(view(handle));
+    return stringsList;
+}
@@ -0,0 +1,158 @@
+/* ----- ----- ----- ----- */
+// CandidatePool.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SymbolHistogram.h"
+
+/**
+ * @brief 32-bit handle identifying one candidate expression inside a `CandidatePool`.
+ *
+ * Handles are assigned in insertion order (0, 1, 2, ...), so sorting handles
+ * restores the original generation order of the candidates.
+ */
+using CandidateHandle = std::uint32_t;
+
+/**
+ * @class CandidatePool
+ * @brief Contiguous arena holding every generated candidate expression exactly once.
+ *
+ * <summary>
+ * All candidates of a game share the same expression length, so the pool stores them
+ * back to back in a single character buffer with a fixed stride of `exprLength`.
+ * A candidate is addressed by its `CandidateHandle` (its index in the arena).
+ *
+ * Round-level lists (current survivors, rollback state, printing) only keep handles,
+ * which costs 4 bytes per candidate instead of a full `std::string`. The memory used
+ * by a session therefore stays around one copy of the candidate universe, no matter
+ * how many rounds are played or undone.
+ *
+ * The generator never produces the same expression twice, so `add()` appends
+ * without a lookup.
+ *
+ * For expressions up to `SymbolHistogram::MAX_COUNTABLE_LENGTH` characters, `add()` also
+ * stores the packed symbol histogram of the candidate, so count checks in later rounds
+ * never have to recount characters.
+ * </summary>
+ */
+class CandidatePool {
+public:
+    CandidatePool() = default;
+
+    /**
+     * @brief Creates an empty pool for expressions of the given length.
+     * @param exprLength Length of every expression stored in the pool.
+     */
+    explicit CandidatePool(int exprLength) : exprLength(exprLength) {}
+
+    /**
+     * @brief Clears the pool and sets the expression length for new entries.
+     * @param newExprLength Length of every expression stored afterwards.
+     */
+    void reset(int newExprLength);
+
+    /**
+     * @brief Releases every candidate and the arena memory.
+     */
+    void clear();
+
+    /**
+     * @brief Appends a candidate expression to the arena.
+     *
+     * @param exprLine Expression to store; its length must equal `getExprLength()`.
+     * @return CandidateHandle Handle of the stored expression.
+     * @throws std::length_error if the expression length does not match the pool,
+     *         or if the pool would exceed the 32-bit handle range.
+     */
+    CandidateHandle add(std::string_view exprLine);
+
+    /**
+     * @brief Reserves arena space for `expectedCount` expressions.
+     * @param expectedCount Expected number of candidates.
+     */
+    void reserve(size_t expectedCount);
+
+    /**
+     * @brief Returns a read-only view on a stored expression.
+     *
+     * @param handle Handle returned by `add()`.
+     * @return std::string_view View into the arena; valid until the pool is modified.
+     */
+    std::string_view view(CandidateHandle handle) const {
+        return std::string_view(charsArena.data() + static_cast<size_t>(handle) * exprLength, exprLength);
+    }
+
+    /**
+     * @brief True if a packed symbol histogram is stored for every candidate.
+     */
+    bool hasHistograms() const {
+        return exprLength > 0 && exprLength <= SymbolHistogram::MAX_COUNTABLE_LENGTH;
+    }
+
+    /**
+     * @brief Returns the packed symbol histogram computed when the candidate was added.
+     *
+     * @param handle Handle returned by `add()`; only valid when `hasHistograms()` is true.
+     */
+    SymbolHistogram::Histogram getHistogram(CandidateHandle handle) const {
+        return histogramsList[handle];
+    }
+
+    /**
+     * @brief Number of candidates stored in the pool.
+     */
+    size_t size() const { return candidateCount; }
+
+    /**
+     * @brief True if the pool holds no candidates.
+     */
+    bool empty() const { return candidateCount == 0; }
+
+    /**
+     * @brief Length of every expression stored in the pool.
+     */
+    int getExprLength() const { return exprLength; }
+
+    /**
+     * @brief Approximate heap memory held by the pool, in bytes.
+     */
+    size_t getMemoryBytes() const {
+        return charsArena.capacity() + histogramsList.capacity() * sizeof(SymbolHistogram::Histogram);
+    }
+
+    /**
+     * @brief Returns the handles of every stored candidate in insertion order.
+     * @return std::vector<CandidateHandle> Handles `0 .. size() - 1`.
+     */
+    std::vector<CandidateHandle> getAllHandles() const;
+
+    /**
+     * @brief Resolves a list of handles into string views, keeping the list order.
+     * @param handlesList Handles to resolve.
+     * @return std::vector<std::string_view> Views into the arena.
+     */
+    std::vector<std::string_view> getViews(const std::vector<CandidateHandle>& handlesList) const;
+
+    /**
+     * @brief Materialises a list of handles as owned strings.
+     * @param handlesList Handles to materialise.
+     * @return std::vector<std::string> Copies of the referenced expressions.
+     */
+    std::vector<std::string> toStringList(const std::vector<CandidateHandle>& handlesList) const;
+
+private:
+    int exprLength = 0;         ///< Fixed length (stride) of every stored expression
+    size_t candidateCount = 0;  ///< Number of stored expressions
+    std::string charsArena;     ///< All expressions concatenated, `exprLength` characters each
+    std::vector<SymbolHistogram::Histogram> histogramsList;  ///< Packed symbol counts per candidate (short expressions only)
+};
@@ -0,0 +1,145 @@
+/* ----- ----- ----- ----- */
+// CandidateTrie.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#include "CandidateTrie.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @struct HandleRange
+ * @brief Range `[begin, end)` of sorted handles sharing the prefix of one trie node.
+ */
+struct HandleRange {
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+}  // namespace (end of anonymous)
+
+/**
+ * @brief Builds the trie over every candidate of a pool.
+ *
+ * <summary>
+ * 1. Sorts the handles by their lane sequence, so candidates sharing a prefix are
+ *    adjacent and siblings appear in lane order.
+ * 2. Builds one level at a time: each node's range is split into runs of equal
+ *    symbol at the current depth; each run becomes a child (a node, or a leaf at
+ *    the last level). Children of a node are therefore contiguous.
+ * </summary>
+ *
+ * @param candidatePool Pool whose candidates are inserted.
+ * @return CandidateTrie The built trie.
+ */
+CandidateTrie CandidateTrie::build(const CandidatePool& candidatePool) {
+    CandidateTrie trie;
+    trie.exprLength = candidatePool.getExprLength();
+    if (candidatePool.empty() || trie.exprLength <= 0) return trie;
+
+    // Step 1: Lane-order sort
+    std::vector<CandidateHandle> sortedHandlesList = candidatePool.getAllHandles();
+    std::sort(sortedHandlesList.begin(), sortedHandlesList.end(),
+        [&](CandidateHandle lhs, CandidateHandle rhs) {
+            std::string_view lhsView = candidatePool.view(lhs);
+            std::string_view rhsView = candidatePool.view(rhs);
+            for (size_t position = 0; position < lhsView.size(); ++position) {
+                int lhsLane = SymbolHistogram::laneOf(lhsView[position]);
+                int rhsLane = SymbolHistogram::laneOf(rhsView[position]);
+                if (lhsLane != rhsLane) return lhsLane < rhsLane;
+            }
+            return false;
+        });
+
+    // Step 2: Level-by-level construction
+    trie.childMasksList.push_back(0);
+    trie.firstChildList.push_back(0);
+    trie.leafHandlesList.reserve(sortedHandlesList.size());
+
+    std::vector<HandleRange> levelRangesList{ { 0, sortedHandlesList.size() } };  ///< Ranges of the current level, node order
+    std::vector<HandleRange> nextRangesList;
+    std::uint32_t levelFirstNode = 0;  ///< Node index of the first range in `levelRangesList`
+
+    for (int depth = 0; depth < trie.exprLength; ++depth) {
+        const bool isLastLevel = (depth == trie.exprLength - 1);
+        nextRangesList.clear();
+
+        for (size_t rangeIndex = 0; rangeIndex < levelRangesList.size(); ++rangeIndex) {
+            const HandleRange& range = levelRangesList[rangeIndex];
+            const std::uint32_t nodeIndex = levelFirstNode + static_cast<std::uint32_t>(rangeIndex);
+
+            trie.firstChildList[nodeIndex] = static_cast<std::uint32_t>(
+                isLastLevel ? trie.leafHandlesList.size() : trie.childMasksList.size());
+
+            size_t runBegin = range.begin;
+            while (runBegin < range.end) {
+                const char runChar = candidatePool.view(sortedHandlesList[runBegin])[depth];
+                const int lane = SymbolHistogram::laneOf(runChar);
+                // Error handling: Only expression symbols have a lane
+                if (lane < 0) {
+                    throw std::invalid_argument("CandidateTrie: candidate contains a non-expression symbol");
+                }
+
+                size_t runEnd = runBegin + 1;
+                while (runEnd < range.end && candidatePool.view(sortedHandlesList[runEnd])[depth] == runChar)
+                    ++runEnd;
+
+                trie.childMasksList[nodeIndex] |= static_cast<std::uint16_t>(1u << lane);
+                if (isLastLevel) {
+                    trie.leafHandlesList.push_back(sortedHandlesList[runBegin]);  // Candidates are unique
+                }
+                else {
+                    trie.childMasksList.push_back(0);
+                    trie.firstChildList.push_back(0);
+                    nextRangesList.push_back({ runBegin, runEnd });
+                }
+                runBegin = runEnd;
+            }
+        }
+
+        levelFirstNode += static_cast<std::uint32_t>(levelRangesList.size());
+        levelRangesList.swap(nextRangesList);
+    }
+
+    trie.childMasksList.shrink_to_fit();
+    trie.firstChildList.shrink_to_fit();
+    trie.leafHandlesList.shrink_to_fit();
+    return trie;
+}
+
+/**
+ * @brief Counts the candidates satisfying `constraintSnapshot` without collecting them.
+ *
+ * @param constraintSnapshot Flattened constraints to apply.
+ * @return size_t Number of surviving candidates.
+ */
+size_t CandidateTrie::countSurvivors(const ConstraintSnapshot& constraintSnapshot) const {
+    size_t survivorCount = 0;
+    forEachSurvivor(constraintSnapshot, [&](CandidateHandle) {
+        ++survivorCount;
+        return true;
+    });
+    return survivorCount;
+}
+
+/**
+ * @brief Collects the handles of every surviving candidate.
+ *
+ * @param constraintSnapshot Flattened constraints to apply.
+ * @return std::vector<CandidateHandle> Surviving handles, sorted ascending.
+ */
+std::vector<CandidateHandle> CandidateTrie::collectSurvivors(const ConstraintSnapshot& constraintSnapshot) const {
+    std::vector<CandidateHandle> survivorsList;
+    forEachSurvivor(constraintSnapshot, [&](CandidateHandle handle) {
+        survivorsList.push_back(handle);
+        return true;
+    });
+    std::sort(survivorsList.begin(), survivorsList.end());  // Trie order -> generation order
+    return survivorsList;
+}
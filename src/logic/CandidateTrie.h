@@ -0,0 +1,165 @@
+/* ----- ----- ----- ----- */
+// CandidateTrie.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "CandidatePool.h"
+#include "ConstraintSnapshot.h"
+#include "SymbolHistogram.h"
+
+/**
+ * @class CandidateTrie
+ * @brief Prefix trie over the candidates of a `CandidatePool`, used to prune whole subtrees while filtering.
+ *
+ * <summary>
+ * Candidates share long prefixes (e.g. every "12+..." expression), yet a flat filter checks
+ * each of them independently. The trie stores every distinct prefix once, so a position rule
+ * violated at depth `d` discards the whole subtree below that node in one step.
+ *
+ * Layout (structure of arrays, breadth-first):
+ * - `childMasksList[node]`: 16-bit mask of symbol lanes (see `SymbolHistogram`) having a child.
+ * - `firstChildList[node]`: index of the first child; children are contiguous in lane order,
+ *   so child `lane` is at `firstChild + popcount(mask & ((1 << lane) - 1))`.
+ * - Nodes at depth `exprLength - 1` point into `leafHandlesList` instead of the node arrays.
+ * A node costs 6 bytes and a leaf 4 bytes; the characters themselves stay in the pool.
+ *
+ * While walking, symbol counts along the path are tracked so that subtrees exceeding a
+ * maximum count, or unable to reach the minimum counts in the remaining positions, are
+ * pruned as well. Survivors can be counted or visited lazily without materialising strings.
+ * </summary>
+ */
+class CandidateTrie {
+public:
+    CandidateTrie() = default;
+
+    /**
+     * @brief Builds the trie over every candidate of a pool.
+     *
+     * @param candidatePool Pool whose candidates are inserted.
+     * @return CandidateTrie The built trie (empty if the pool is empty).
+     */
+    static CandidateTrie build(const CandidatePool& candidatePool);
+
+    /**
+     * @brief Visits every candidate satisfying `constraintSnapshot`, in trie (lane) order.
+     *
+     * @param constraintSnapshot Flattened constraints to apply.
+     * @param visitFunc Callable `bool(CandidateHandle)`; return false to stop the walk early.
+     */
+    template <typename VisitFunc>
+    void forEachSurvivor(const ConstraintSnapshot& constraintSnapshot, VisitFunc&& visitFunc) const {
+        if (empty() || !constraintSnapshot.isSatisfiable
+            || constraintSnapshot.exprLength != exprLength) return;
+
+        WalkState walkState;
+        walkState.requiredLeft = 0;
+        for (int lane = 0; lane < SymbolHistogram::LANE_COUNT; ++lane)
+            walkState.requiredLeft += constraintSnapshot.minCountsList[lane];
+
+        _walk(0, 0, constraintSnapshot, walkState, visitFunc);
+    }
+
+    /**
+     * @brief Counts the candidates satisfying `constraintSnapshot` without collecting them.
+     */
+    size_t countSurvivors(const ConstraintSnapshot& constraintSnapshot) const;
+
+    /**
+     * @brief Collects the handles of every surviving candidate, sorted ascending (generation order).
+     */
+    std::vector<CandidateHandle> collectSurvivors(const ConstraintSnapshot& constraintSnapshot) const;
+
+    /**
+     * @brief True if the trie holds no candidates.
+     */
+    bool empty() const { return leafHandlesList.empty(); }
+
+    /**
+     * @brief Number of candidates (leaves) in the trie.
+     */
+    size_t size() const { return leafHandlesList.size(); }
+
+    /**
+     * @brief Number of internal nodes (distinct proper prefixes, root included).
+     */
+    size_t getNodeCount() const { return childMasksList.size(); }
+
+    /**
+     * @brief Heap memory held by the trie structure, in bytes.
+     */
+    size_t getMemoryBytes() const {
+        return childMasksList.capacity() * sizeof(std::uint16_t)
+             + firstChildList.capacity() * sizeof(std::uint32_t)
+             + leafHandlesList.capacity() * sizeof(CandidateHandle);
+    }
+
+private:
+    /**
+     * @struct WalkState
+     * @brief Symbol counts of the current path, updated and restored while walking.
+     */
+    struct WalkState {
+        std::array<int, SymbolHistogram::LANE_COUNT> pathCountsList{};  ///< Occurrences of each lane on the path
+        int requiredLeft = 0;  ///< Symbols still needed to reach every minimum count
+    };
+
+    int exprLength = 0;                           ///< Depth of every leaf
+    std::vector<std::uint16_t> childMasksList;    ///< Lanes having a child, per node
+    std::vector<std::uint32_t> firstChildList;    ///< First child index (node, or leaf at the last level)
+    std::vector<CandidateHandle> leafHandlesList; ///< Pool handle of each leaf
+
+    /**
+     * @brief Recursive walk shared by every query; returns false once the visitor asked to stop.
+     */
+    template <typename VisitFunc>
+    bool _walk(
+        std::uint32_t nodeIndex,
+        int depth,
+        const ConstraintSnapshot& constraintSnapshot,
+        WalkState& walkState,
+        VisitFunc& visitFunc
+    ) const {
+        const std::uint16_t childMask = childMasksList[nodeIndex];
+        std::uint16_t candidateMask = childMask & constraintSnapshot.allowedSymbolsAtPos[depth];
+        const int remainingAfter = exprLength - depth - 1;  ///< Positions left below the child
+
+        while (candidateMask != 0) {
+            const int lane = std::countr_zero(candidateMask);
+            candidateMask &= static_cast<std::uint16_t>(candidateMask - 1);
+
+            int& laneCount = walkState.pathCountsList[lane];
+            if (laneCount + 1 > constraintSnapshot.maxCountsList[lane]) continue;  // Max count exceeded
+
+            const bool isRequired = laneCount < constraintSnapshot.minCountsList[lane];
+            const int requiredAfter = walkState.requiredLeft - (isRequired ? 1 : 0);
+            if (requiredAfter > remainingAfter) continue;  // Minimum counts cannot be met anymore
+
+            const std::uint32_t childIndex = firstChildList[nodeIndex]
+                + static_cast<std::uint32_t>(std::popcount(static_cast<unsigned>(childMask & ((1u << lane) - 1u))));
+
+            if (remainingAfter == 0) {
+                // requiredAfter == 0 here, so every min/max bound holds
+                if (!visitFunc(leafHandlesList[childIndex])) return false;
+                continue;
+            }
+
+            ++laneCount;
+            walkState.requiredLeft = requiredAfter;
+            bool shouldContinue = _walk(childIndex, depth + 1, constraintSnapshot, walkState, visitFunc);
+            walkState.requiredLeft += (isRequired ? 1 : 0);
+            --laneCount;
+            if (!shouldContinue) return false;
+        }
+        return true;
+    }
+};
@@ -17,6 +17,7 @@
 
 #include "core/constants/ExpressionConstants.h"
 #include "core/logging/AppLogger.h"
+#include "util/TraceRecorder.h"
 
 #define FMT_HEADER_ONLY
 #include "core.h"
@@ -272,6 +273,7 @@ std::unordered_map<char, Constraint> deriveConstraints(
     const std::vector<std::string>& expressionColors,
     int expLength)
 {
+    TraceRecorder::Span traceSpan("deriveConstraints");
     const int INF = expLength;                             ///< Reasonable upper bound for symbol occurrences
     std::unordered_map<char, Constraint> constraintsMap;   ///< Final result container
     bool hasGlobalConflict = false;                        ///< Tracks global conflict status
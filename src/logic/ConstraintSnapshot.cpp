@@ -0,0 +1,136 @@
+/* ----- ----- ----- ----- */
+// ConstraintSnapshot.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#include "ConstraintSnapshot.h"
+#include <algorithm>
+
+#include "core/constants/ExpressionConstants.h"
+
+/**
+ * @brief Flattens a constraints map into a snapshot.
+ *
+ * <summary>
+ * Mirrors the three per-character checks of `ConstraintUtils::isCandidateValid`:
+ * - `isCharAllowed`: symbol missing from the map, forbidden (min = max = 0), or
+ *   already at its maximum usage => removed from every position mask.
+ * - `isCharAllowedAtPos`: banned positions => removed from that position's mask.
+ * - `isCharSafeAtPosition`: another symbol is green at a position => only that symbol
+ *   stays allowed there (two different green symbols leave nothing allowed).
+ * Count bounds are copied per lane; symbols missing from the map are unbounded.
+ * </summary>
+ *
+ * @param constraintsMap Map of symbol → Constraint to flatten.
+ * @param exprLength Length of the expressions that will be checked.
+ * @return ConstraintSnapshot The flattened constraints.
+ */
+ConstraintSnapshot ConstraintSnapshot::build(
+    const std::unordered_map<char, Constraint>& constraintsMap,
+    int exprLength
+) {
+    ConstraintSnapshot snapshot;
+    snapshot.exprLength = exprLength;
+    snapshot.allowedSymbolsAtPos.assign(exprLength, 0);
+    snapshot.minCountsList.fill(0);
+    snapshot.maxCountsList.fill(exprLength);
+
+    std::uint16_t allowedAnywhereMask = 0;                 ///< Symbols passing the character-level check
+    std::vector<std::uint16_t> greenSymbolsAtPos(exprLength, 0);  ///< Symbols marked green at each position
+
+    for (int lane = 0; lane < SymbolHistogram::LANE_COUNT; ++lane) {
+        char exprChar = Expression::SYMBOLS[lane];
+        auto constraintIt = constraintsMap.find(exprChar);
+        if (constraintIt == constraintsMap.end()) {
+            continue;  // Not in the map => never allowed, count stays unbounded
+        }
+        const Constraint& constraint = constraintIt->second;
+
+        snapshot.minCountsList[lane] = constraint.minCount();
+        snapshot.maxCountsList[lane] = constraint.maxCount();
+        if (constraint.minCount() > exprLength || constraint.maxCount() < 0) {
+            snapshot.isSatisfiable = false;  // No expression of this length can meet the bound
+        }
+
+        bool isForbidden = (constraint.minCount() == 0 && constraint.maxCount() == 0);
+        bool isUsedUp = (constraint.usedCount() >= constraint.maxCount());
+        if (!isForbidden && !isUsedUp)
+            allowedAnywhereMask |= static_cast<std::uint16_t>(1u << lane);
+
+        for (int greenPosition : constraint.greenPos()) {
+            if (greenPosition >= 0 && greenPosition < exprLength)
+                greenSymbolsAtPos[greenPosition] |= static_cast<std::uint16_t>(1u << lane);
+        }
+    }
+
+    // Pack count bounds into histogram lanes
+    for (int lane = 0; lane < SymbolHistogram::LANE_COUNT; ++lane) {
+        snapshot.minCounts = SymbolHistogram::setCount(snapshot.minCounts, lane, snapshot.minCountsList[lane]);
+        snapshot.maxCounts = SymbolHistogram::setCount(snapshot.maxCounts, lane, snapshot.maxCountsList[lane]);
+    }
+
+    // Per-position masks
+    for (int position = 0; position < exprLength; ++position) {
+        std::uint16_t positionMask = allowedAnywhereMask;
+
+        for (int lane = 0; lane < SymbolHistogram::LANE_COUNT; ++lane) {
+            auto constraintIt = constraintsMap.find(Expression::SYMBOLS[lane]);
+            if (constraintIt != constraintsMap.end() && constraintIt->second.bannedPos().count(position))
+                positionMask &= static_cast<std::uint16_t>(~(1u << lane));
+        }
+
+        std::uint16_t greenMask = greenSymbolsAtPos[position];
+        if (greenMask != 0) {
+            bool isSingleGreen = (greenMask & (greenMask - 1)) == 0;
+            positionMask &= isSingleGreen ? greenMask : 0;  // Any other symbol would collide with the green one
+        }
+
+        snapshot.allowedSymbolsAtPos[position] = positionMask;
+    }
+
+    return snapshot;
+}
+
+/**
+ * @brief Checks the per-position rules of a full expression.
+ *
+ * @param exprLine Candidate expression.
+ * @return true if every character is allowed at its position.
+ */
+bool ConstraintSnapshot::isPositionValid(std::string_view exprLine) const {
+    if (static_cast<int>(exprLine.size()) > exprLength) return false;
+    for (size_t position = 0; position < exprLine.size(); ++position) {
+        if (!isSymbolAllowedAt(exprLine[position], static_cast<int>(position)))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Full candidate check, building the symbol counts on the fly.
+ *
+ * @param exprLine Candidate expression.
+ * @return true if the candidate satisfies every flattened constraint.
+ */
+bool ConstraintSnapshot::isCandidateValid(std::string_view exprLine) const {
+    if (!isSatisfiable || !isPositionValid(exprLine)) return false;
+
+    if (static_cast<int>(exprLine.size()) <= SymbolHistogram::MAX_COUNTABLE_LENGTH)
+        return isCountValid(SymbolHistogram::build(exprLine));
+
+    // Long expressions: lanes could overflow, count into plain integers instead
+    std::array<int, SymbolHistogram::LANE_COUNT> appearCountsList{};
+    for (char exprChar : exprLine) {
+        int lane = SymbolHistogram::laneOf(exprChar);
+        if (lane >= 0) ++appearCountsList[lane];
+    }
+    for (int lane = 0; lane < SymbolHistogram::LANE_COUNT; ++lane) {
+        if (appearCountsList[lane] < minCountsList[lane] || appearCountsList[lane] > maxCountsList[lane])
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,102 @@
+/* ----- ----- ----- ----- */
+// ConstraintSnapshot.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Constraint.h"
+#include "SymbolHistogram.h"
+
+/**
+ * @struct ConstraintSnapshot
+ * @brief Flattened, read-only copy of a constraints map, prepared for fast candidate checks.
+ *
+ * <summary>
+ * `ConstraintUtils::isCandidateValid` walks `constraintsMap` (hash lookups plus a
+ * per-candidate `unordered_map<char,int>` of counts) for every candidate. A snapshot
+ * precomputes the same rules once per filter pass:
+ * - `allowedSymbolsAtPos`: one 16-bit lane mask per position, combining character-level
+ *   (forbidden / max reached), banned-position and foreign-green-position rules.
+ * - `minCounts` / `maxCounts`: count bounds packed like `SymbolHistogram`, so the count
+ *   check is two SWAR comparisons against the candidate's precomputed histogram.
+ *
+ * `isCandidateValid` on a snapshot gives exactly the same answer as
+ * `ConstraintUtils::isCandidateValid` on the map it was built from.
+ * Snapshots are immutable after `build()` and safe to share between threads.
+ * </summary>
+ */
+struct ConstraintSnapshot {
+    int exprLength = 0;                              ///< Expression length the snapshot was built for
+    bool isSatisfiable = true;                       ///< False when a bound can never be met (e.g., min > length)
+    SymbolHistogram::Histogram minCounts = 0;        ///< Packed minimum count per symbol lane
+    SymbolHistogram::Histogram maxCounts = 0;        ///< Packed maximum count per symbol lane (clamped to 15)
+    std::array<int, SymbolHistogram::LANE_COUNT> minCountsList{};  ///< Unpacked minimum counts (long expressions)
+    std::array<int, SymbolHistogram::LANE_COUNT> maxCountsList{};  ///< Unpacked maximum counts (long expressions)
+    std::vector<std::uint16_t> allowedSymbolsAtPos;  ///< Bit `lane` set => symbol may appear at that position
+
+    /**
+     * @brief Flattens a constraints map into a snapshot.
+     *
+     * @param constraintsMap Map of symbol → Constraint to flatten.
+     * @param exprLength Length of the expressions that will be checked.
+     * @return ConstraintSnapshot Snapshot equivalent to `constraintsMap` for candidate checks.
+     */
+    static ConstraintSnapshot build(
+        const std::unordered_map<char, Constraint>& constraintsMap,
+        int exprLength
+    );
+
+    /**
+     * @brief True if `exprChar` may appear at `position` (character- and position-level rules).
+     */
+    bool isSymbolAllowedAt(char exprChar, int position) const {
+        int lane = SymbolHistogram::laneOf(exprChar);
+        return lane >= 0 && (allowedSymbolsAtPos[position] >> lane) & 1u;
+    }
+
+    /**
+     * @brief Checks the per-position rules of a full expression.
+     * @param exprLine Candidate expression of length `exprLength`.
+     */
+    bool isPositionValid(std::string_view exprLine) const;
+
+    /**
+     * @brief Checks the min/max count rules against a precomputed packed histogram.
+     * @param histogram Histogram of the candidate (see `SymbolHistogram::build`).
+     */
+    bool isCountValid(SymbolHistogram::Histogram histogram) const {
+        return isSatisfiable && SymbolHistogram::isWithinBounds(histogram, minCounts, maxCounts);
+    }
+
+    /**
+     * @brief Full candidate check using a precomputed histogram.
+     * @param exprLine Candidate expression.
+     * @param histogram Packed histogram of `exprLine`.
+     */
+    bool isCandidateValid(std::string_view exprLine, SymbolHistogram::Histogram histogram) const {
+        return isCountValid(histogram) && isPositionValid(exprLine);
+    }
+
+    /**
+     * @brief Full candidate check without a precomputed histogram.
+     *
+     * <summary>
+     * Builds the histogram on the fly for expressions up to
+     * `SymbolHistogram::MAX_COUNTABLE_LENGTH`; longer expressions fall back to
+     * plain per-lane counters.
+     * </summary>
+     *
+     * @param exprLine Candidate expression.
+     */
+    bool isCandidateValid(std::string_view exprLine) const;
+};
@@ -3,8 +3,8 @@
 // Do not distribute or modify
 // Author: DragonTaki (https://github.com/DragonTaki)
 // Create Date: 2025/10/16
-// Update Date: 2025/10/16
-// Version: v1.0
+// Update Date: 2026/10/16
+// Version: v1.1
 /* ----- ----- ----- ----- */
 
 #include "ConstraintUtils.h"
@@ -232,7 +232,7 @@ bool isCharSafeAtPosition(
  * @return `true` if the candidate satisfies all constraint conditions; `false` otherwise.
  */
 bool isCandidateValid(
-    const std::string& exprLine,
+    std::string_view exprLine,
     const std::unordered_map<char, Constraint>& constraintsMap
 ) {
     // Character-level and position-level check
@@ -250,7 +250,7 @@ bool isCandidateValid(
         }
 
         // If no other symbol occupied the position
-        if (!isCharSafeAtPosition(exprChar, exprCharPosition, constraintsMap)) {
+        if (!isCharSafeAtPosition(exprChar, static_cast<int>(exprCharPosition), constraintsMap)) {
             return false;
         }
     }
@@ -3,12 +3,13 @@
 // Do not distribute or modify
 // Author: DragonTaki (https://github.com/DragonTaki)
 // Create Date: 2025/10/16
-// Update Date: 2025/10/16
-// Version: v1.0
+// Update Date: 2026/10/16
+// Version: v1.1
 /* ----- ----- ----- ----- */
 
 #pragma once
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include "Constraint.h"
@@ -115,7 +116,7 @@ bool isTokenSequenceValid(const std::vector<Expression::Token>& tokensList);
      * @return `true` if the expression satisfies all constraints; `false` otherwise.
      */
 bool isCandidateValid(
-    const std::string& exprLine,
+    std::string_view exprLine,
     const std::unordered_map<char, Constraint>& constraintsMap
 );
 
@@ -0,0 +1,409 @@
+/* ----- ----- ----- ----- */
+// DifferentialCheck.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/17
+// Update Date: 2026/10/17
+// Version: v1.2
+/* ----- ----- ----- ----- */
+
+#include "DifferentialCheck.h"
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string_view>
+#include <unordered_map>
+
+#include "CandidateGenerator.h"
+#include "CandidateTrie.h"
+#include "Constraint.h"
+#include "ConstraintUtils.h"
+#include "ExpressionValidator.h"
+#include "FeedbackCode.h"
+#include "SpeculativePartition.h"
+#include "SurvivorSet.h"
+#include "core/logging/AppLogger.h"
+
+namespace DifferentialCheck {
+
+namespace {
+
+constexpr int MAX_CASE_ROUNDS = 4;                      ///< Most guesses of a random case
+constexpr std::string_view CASE_OPERATORS = "+-*/";     ///< Operators a case draws its set from
+
+/**
+ * @struct GenerationInput
+ * @brief What a round-1 engine is given.
+ */
+struct GenerationInput {
+    int exprLength = 0;
+    const std::unordered_set<char>* operatorsSet = nullptr;
+    const GuessRound* guessRound = nullptr;
+    const GuessUniverse* guessUniverse = nullptr;
+    ExpressionValidator* validator = nullptr;
+};
+
+/**
+ * @struct FilterInput
+ * @brief What a later-round engine is given.
+ */
+struct FilterInput {
+    const CandidatePool* candidatePool = nullptr;                 ///< Reference candidates of round 1
+    const CandidateTrie* candidateTrie = nullptr;                 ///< Trie over `candidatePool`
+    const std::vector<CandidateHandle>* survivorHandlesList = nullptr;  ///< Reference survivors of the previous round, sorted
+    const std::unordered_map<char, Constraint>* constraintsMap = nullptr;  ///< Constraints after this round's feedback
+    const GuessRound* guessRound = nullptr;                       ///< Guess and feedback of this round
+    ExpressionValidator* validator = nullptr;
+};
+
+/**
+ * @struct GenerationEngine
+ * @brief A round-1 engine checked against `CandidateGenerator::generate`.
+ */
+struct GenerationEngine {
+    const char* engineName;
+    std::vector<std::string> (*generate)(const GenerationInput& generationInput);
+};
+
+/**
+ * @struct FilterEngine
+ * @brief A later-round engine checked against `ExpressionValidator::filterExpressions`.
+ */
+struct FilterEngine {
+    const char* engineName;
+    std::vector<std::string> (*filter)(const FilterInput& filterInput);
+};
+
+/**
+ * @brief Expressions of `candidateHandlesList` as strings.
+ */
+std::vector<std::string> toLinesList(const CandidatePool& candidatePool, const std::vector<CandidateHandle>& candidateHandlesList) {
+    std::vector<std::string> linesList;
+    linesList.reserve(candidateHandlesList.size());
+    for (CandidateHandle handle : candidateHandlesList)
+        linesList.emplace_back(candidatePool.view(handle));
+    return linesList;
+}
+
+// Registered engines: add a fast path here to have it checked by `--verify`
+const GenerationEngine GENERATION_ENGINES[] = {
+    { "generatePool", [](const GenerationInput& generationInput) {
+        std::unordered_map<char, Constraint> constraintsMap = initializeConstraintsMap();
+        CandidateGenerator generator(*generationInput.validator);
+        const CandidatePool candidatePool = generator.generatePool(generationInput.exprLength, *generationInput.operatorsSet,
+            {generationInput.guessRound->exprLine}, {generationInput.guessRound->exprColorLine}, constraintsMap);
+        std::vector<std::string> linesList;
+        linesList.reserve(candidatePool.size());
+        for (size_t handle = 0; handle < candidatePool.size(); ++handle)
+            linesList.emplace_back(candidatePool.view(static_cast<CandidateHandle>(handle)));
+        return linesList;
+    } },
+    { "universeFilter", [](const GenerationInput& generationInput) {
+        const std::unordered_map<char, Constraint> constraintsMap = deriveConstraints(
+            {generationInput.guessRound->exprLine}, {generationInput.guessRound->exprColorLine}, generationInput.exprLength);
+        const CandidatePool& universePool = generationInput.guessUniverse->getPool();
+        std::vector<std::string> linesList;
+        for (size_t handle = 0; handle < universePool.size(); ++handle) {
+            const std::string_view exprLine = universePool.view(static_cast<CandidateHandle>(handle));
+            if (ConstraintUtils::isCandidateValid(exprLine, constraintsMap)) linesList.emplace_back(exprLine);
+        }
+        return linesList;
+    } },
+};
+
+const FilterEngine FILTER_ENGINES[] = {
+    { "filterCandidatesInPlace", [](const FilterInput& filterInput) {
+        std::vector<CandidateHandle> candidateHandlesList = *filterInput.survivorHandlesList;
+        filterInput.validator->filterCandidatesInPlace(*filterInput.candidatePool, candidateHandlesList, *filterInput.constraintsMap);
+        return toLinesList(*filterInput.candidatePool, candidateHandlesList);
+    } },
+    { "filterSurvivors", [](const FilterInput& filterInput) {
+        const SurvivorSet survivorSet = filterInput.validator->filterSurvivors(*filterInput.candidatePool,
+            SurvivorSet::fromSortedHandles(*filterInput.survivorHandlesList), *filterInput.constraintsMap);
+        return toLinesList(*filterInput.candidatePool, survivorSet.toSortedHandles());
+    } },
+    { "filterSurvivorsByTrie", [](const FilterInput& filterInput) {
+        const SurvivorSet survivorSet = filterInput.validator->filterSurvivorsByTrie(*filterInput.candidatePool,
+            *filterInput.candidateTrie, SurvivorSet::fromSortedHandles(*filterInput.survivorHandlesList), *filterInput.constraintsMap);
+        return toLinesList(*filterInput.candidatePool, survivorSet.toSortedHandles());
+    } },
+    { "feedbackCode", [](const FilterInput& filterInput) {
+        const std::string& guessLine = filterInput.guessRound->exprLine;
+        const FeedbackCode::Code code = FeedbackCode::fromColorLine(filterInput.guessRound->exprColorLine);
+        std::vector<CandidateHandle> candidateHandlesList;
+        for (CandidateHandle handle : *filterInput.survivorHandlesList) {
+            if (FeedbackCode::compute(guessLine, filterInput.candidatePool->view(handle)) == code)
+                candidateHandlesList.push_back(handle);
+        }
+        return toLinesList(*filterInput.candidatePool, candidateHandlesList);
+    } },
+    { "speculativePartition", [](const FilterInput& filterInput) {
+        const std::string& guessLine = filterInput.guessRound->exprLine;
+        SurvivorSet survivorSet = SurvivorSet::fromSortedHandles(*filterInput.survivorHandlesList);
+        SpeculativePartition speculativePartition;
+        speculativePartition.start(*filterInput.candidatePool, survivorSet, guessLine);
+        SurvivorSet partitionSet;
+        if (!speculativePartition.take(guessLine, FeedbackCode::fromColorLine(filterInput.guessRound->exprColorLine), partitionSet))
+            return std::vector<std::string>{};
+        return toLinesList(*filterInput.candidatePool, partitionSet.toSortedHandles());
+    } },
+};
+
+/**
+ * @brief Compares an engine's candidates with the reference's.
+ *
+ * @param referenceLinesList Reference candidates, sorted.
+ * @param engineLinesList Engine candidates, in any order (sorted here).
+ * @param engineName Engine, for the report.
+ * @param roundIndex Round, for the report.
+ * @return std::optional<Divergence> The difference, or nothing if both sets are equal.
+ */
+std::optional<Divergence> compareLines(
+    const std::vector<std::string>& referenceLinesList,
+    std::vector<std::string> engineLinesList,
+    const char* engineName,
+    size_t roundIndex
+) {
+    std::sort(engineLinesList.begin(), engineLinesList.end());
+    if (engineLinesList == referenceLinesList) return std::nullopt;
+
+    Divergence divergence;
+    divergence.engineName = engineName;
+    divergence.roundIndex = roundIndex;
+    divergence.referenceCount = referenceLinesList.size();
+    divergence.engineCount = engineLinesList.size();
+    std::vector<std::string> differenceList;
+    std::set_difference(referenceLinesList.begin(), referenceLinesList.end(),
+        engineLinesList.begin(), engineLinesList.end(), std::back_inserter(differenceList));
+    if (!differenceList.empty()) divergence.missingLine = differenceList.front();
+    differenceList.clear();
+    std::set_difference(engineLinesList.begin(), engineLinesList.end(),
+        referenceLinesList.begin(), referenceLinesList.end(), std::back_inserter(differenceList));
+    if (!differenceList.empty()) divergence.extraLine = differenceList.front();
+    return divergence;
+}
+
+/**
+ * @brief Drops rounds from a diverging history while it still diverges.
+ *
+ * <summary>
+ * The history is first cut after the diverging round; then each round is removed in
+ * turn, and the removal is kept whenever the shorter history still diverges (it stays a
+ * valid game, since every color line was computed against the same answer).
+ * </summary>
+ *
+ * @param[in,out] guessRoundsList Diverging history; shrunk in place.
+ * @param[in,out] divergence Divergence of the history; updated to the shrunk one.
+ */
+void shrinkHistory(
+    int exprLength,
+    const std::unordered_set<char>& operatorsSet,
+    const GuessUniverse& guessUniverse,
+    std::vector<GuessRound>& guessRoundsList,
+    Divergence& divergence
+) {
+    guessRoundsList.resize(divergence.roundIndex + 1);
+    size_t dropIndex = 0;
+    while (guessRoundsList.size() > 1 && dropIndex < guessRoundsList.size()) {
+        std::vector<GuessRound> trialRoundsList = guessRoundsList;
+        trialRoundsList.erase(trialRoundsList.begin() + static_cast<std::ptrdiff_t>(dropIndex));
+        std::optional<Divergence> trialDivergence = checkGame(exprLength, operatorsSet, guessUniverse, trialRoundsList);
+        if (!trialDivergence) {
+            ++dropIndex;
+            continue;
+        }
+        trialRoundsList.resize(trialDivergence->roundIndex + 1);
+        guessRoundsList = std::move(trialRoundsList);
+        divergence = std::move(*trialDivergence);
+    }
+}
+
+}  // namespace (end of anonymous)
+
+/**
+ * @brief Replays one history through the reference and every engine.
+ *
+ * <summary>
+ * Round 1 compares the generation engines with `generate`; from round 2 on, the
+ * constraints are updated with `updateConstraint` (as `RoundManager` does) and the filter
+ * engines are compared with `filterExpressions`, all starting from the reference's
+ * previous survivors so a divergence is pinned to the round that caused it.
+ * </summary>
+ *
+ * @param exprLength Expression length of the game.
+ * @param operatorsSet Operators of the game.
+ * @param guessUniverse Every valid expression of the game.
+ * @param guessRoundsList Guesses and feedback, in play order.
+ * @return std::optional<Divergence> First disagreement, or nothing if every engine agreed on every round.
+ */
+std::optional<Divergence> checkGame(
+    int exprLength,
+    const std::unordered_set<char>& operatorsSet,
+    const GuessUniverse& guessUniverse,
+    const std::vector<GuessRound>& guessRoundsList
+) {
+    if (guessRoundsList.empty()) return std::nullopt;
+    ExpressionValidator validator;
+    validator.setValidOps(operatorsSet);
+
+    // Round 1: generation
+    const GuessRound& firstRound = guessRoundsList.front();
+    std::unordered_map<char, Constraint> constraintsMap = initializeConstraintsMap();
+    CandidateGenerator generator(validator);
+    std::vector<std::string> referenceLinesList = generator.generate(
+        exprLength, operatorsSet, {firstRound.exprLine}, {firstRound.exprColorLine}, constraintsMap);
+
+    const GenerationInput generationInput{ exprLength, &operatorsSet, &firstRound, &guessUniverse, &validator };
+    std::vector<std::string> sortedReferenceLinesList = referenceLinesList;
+    std::sort(sortedReferenceLinesList.begin(), sortedReferenceLinesList.end());
+    for (const GenerationEngine& generationEngine : GENERATION_ENGINES) {
+        std::optional<Divergence> divergence = compareLines(sortedReferenceLinesList,
+            generationEngine.generate(generationInput), generationEngine.engineName, 0);
+        if (divergence) return divergence;
+    }
+    if (guessRoundsList.size() == 1) return std::nullopt;
+
+    // Later rounds: filtering, over a pool of the reference candidates
+    CandidatePool candidatePool(exprLength);
+    for (const std::string& referenceLine : referenceLinesList) candidatePool.add(referenceLine);
+    const CandidateTrie candidateTrie = CandidateTrie::build(candidatePool);
+    std::unordered_map<std::string, CandidateHandle> handlesMap;  ///< Reference candidate -> handle in `candidatePool`
+    std::vector<CandidateHandle> survivorHandlesList(candidatePool.size());
+    for (size_t handle = 0; handle < survivorHandlesList.size(); ++handle) {
+        survivorHandlesList[handle] = static_cast<CandidateHandle>(handle);
+        handlesMap.emplace(referenceLinesList[handle], static_cast<CandidateHandle>(handle));
+    }
+
+    for (size_t roundIndex = 1; roundIndex < guessRoundsList.size(); ++roundIndex) {
+        updateConstraint(constraintsMap, guessRoundsList[roundIndex].exprLine, guessRoundsList[roundIndex].exprColorLine);
+        referenceLinesList = validator.filterExpressions(referenceLinesList, constraintsMap);
+        sortedReferenceLinesList = referenceLinesList;
+        std::sort(sortedReferenceLinesList.begin(), sortedReferenceLinesList.end());
+
+        const FilterInput filterInput{ &candidatePool, &candidateTrie, &survivorHandlesList, &constraintsMap,
+            &guessRoundsList[roundIndex], &validator };
+        for (const FilterEngine& filterEngine : FILTER_ENGINES) {
+            std::optional<Divergence> divergence = compareLines(sortedReferenceLinesList,
+                filterEngine.filter(filterInput), filterEngine.engineName, roundIndex);
+            if (divergence) return divergence;
+        }
+
+        // Carry the reference survivors forward
+        std::vector<CandidateHandle> nextHandlesList;
+        nextHandlesList.reserve(referenceLinesList.size());
+        for (const std::string& referenceLine : referenceLinesList)
+            nextHandlesList.push_back(handlesMap.at(referenceLine));
+        std::sort(nextHandlesList.begin(), nextHandlesList.end());
+        survivorHandlesList = std::move(nextHandlesList);
+        if (survivorHandlesList.empty()) break;
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Checks `SolverOptions::verifyCaseCount` random cases and prints the outcome.
+ *
+ * <summary>
+ * Cases come from one generator seeded with `SolverOptions::verifySeed`, so a run is
+ * repeatable. Universes are built once per length and operator set, within
+ * `SolverOptions::universeMaxEvaluations`; cases of a configuration over that limit are
+ * skipped, since their answers and guesses are drawn from the universe. The run stops at
+ * the first divergence, logs it at Error level and prints the shrunk history as the
+ * solver's own input (spec line, then guess and color lines).
+ * </summary>
+ *
+ * @param solverOptions Case count, lengths and seed.
+ * @return true if no engine diverged.
+ */
+bool run(const SolverOptions& solverOptions) {
+    AppLogger::SetLogLevel(LogLevel::Info);
+    AppLogger::Info(std::format("Verify: {} case(s), lengths {}-{}, seed {}; {} generation and {} filter engine(s).",
+        solverOptions.verifyCaseCount, solverOptions.verifyMinLength, solverOptions.verifyMaxLength, solverOptions.verifySeed,
+        std::size(GENERATION_ENGINES), std::size(FILTER_ENGINES)));
+
+    std::mt19937_64 caseGenerator(solverOptions.verifySeed);
+    std::uniform_int_distribution<int> lengthDistribution(solverOptions.verifyMinLength, solverOptions.verifyMaxLength);
+    std::uniform_int_distribution<int> operatorMaskDistribution(1, (1 << CASE_OPERATORS.size()) - 1);
+    std::uniform_int_distribution<int> roundCountDistribution(1, MAX_CASE_ROUNDS);
+    std::map<std::string, GuessUniverse> guessUniversesMap;  ///< Spec (e.g. "8+-*\/") -> universe
+
+    size_t checkedCaseCount = 0;
+    size_t skippedCaseCount = 0;
+    size_t overLimitCaseCount = 0;
+    size_t checkedRoundCount = 0;
+    const auto startTime = std::chrono::steady_clock::now();
+    for (size_t caseIndex = 0; caseIndex < solverOptions.verifyCaseCount; ++caseIndex) {
+        // Game of the case
+        const int exprLength = lengthDistribution(caseGenerator);
+        const int operatorMask = operatorMaskDistribution(caseGenerator);
+        std::string operatorsText;
+        for (size_t operatorIndex = 0; operatorIndex < CASE_OPERATORS.size(); ++operatorIndex) {
+            if (operatorMask & (1 << operatorIndex)) operatorsText += CASE_OPERATORS[operatorIndex];
+        }
+        const std::unordered_set<char> operatorsSet(operatorsText.begin(), operatorsText.end());
+        const std::string specLine = std::format("{}{}", exprLength, operatorsText);
+        auto [universeIt, isNewUniverse] = guessUniversesMap.try_emplace(specLine);
+        if (isNewUniverse) {
+            ExpressionValidator universeValidator;
+            universeValidator.setValidOps(operatorsSet);
+            if (!universeIt->second.build(exprLength, operatorsSet, universeValidator, solverOptions.universeMaxEvaluations))
+                AppLogger::Warn(std::format("Verify: {} skipped, its universe needs more than {} evaluations (--universe-limit).",
+                    specLine, solverOptions.universeMaxEvaluations));
+        }
+        const GuessUniverse& guessUniverse = universeIt->second;
+        if (guessUniverse.isOverLimitFor(exprLength, operatorsSet)) {
+            ++overLimitCaseCount;
+            continue;
+        }
+        if (guessUniverse.empty()) {
+            ++skippedCaseCount;
+            continue;
+        }
+
+        // Hidden answer and guesses, with computed feedback
+        const CandidatePool& universePool = guessUniverse.getPool();
+        std::uniform_int_distribution<size_t> exprDistribution(0, universePool.size() - 1);
+        const std::string answerLine(universePool.view(static_cast<CandidateHandle>(exprDistribution(caseGenerator))));
+        const int roundCount = roundCountDistribution(caseGenerator);
+        std::vector<GuessRound> guessRoundsList;
+        for (int roundIndex = 0; roundIndex < roundCount; ++roundIndex) {
+            GuessRound guessRound;
+            guessRound.exprLine = std::string(universePool.view(static_cast<CandidateHandle>(exprDistribution(caseGenerator))));
+            guessRound.exprColorLine = FeedbackCode::toColorLine(FeedbackCode::compute(guessRound.exprLine, answerLine), exprLength);
+            guessRoundsList.push_back(std::move(guessRound));
+        }
+
+        std::optional<Divergence> divergence = checkGame(exprLength, operatorsSet, guessUniverse, guessRoundsList);
+        ++checkedCaseCount;
+        checkedRoundCount += guessRoundsList.size();
+        if (!divergence) continue;
+
+        // Report the first divergence with the shortest history that still shows it
+        shrinkHistory(exprLength, operatorsSet, guessUniverse, guessRoundsList, *divergence);
+        AppLogger::Error(std::format("Verify: case {} ({}, answer {}): {} diverges from the reference at round {} ({}): "
+            "reference {} candidate(s), engine {}.", caseIndex + 1, specLine, answerLine, divergence->engineName,
+            divergence->roundIndex + 1, divergence->roundIndex == 0 ? "generation" : "filtering",
+            divergence->referenceCount, divergence->engineCount));
+        if (!divergence->missingLine.empty())
+            AppLogger::Error(std::format("  only in the reference: {}", divergence->missingLine));
+        if (!divergence->extraLine.empty())
+            AppLogger::Error(std::format("  only in {}: {}", divergence->engineName, divergence->extraLine));
+        AppLogger::Info(std::format("Reproducer ({} round(s), solver input):", guessRoundsList.size()));
+        AppLogger::Info(specLine);
+        for (const GuessRound& guessRound : guessRoundsList) {
+            AppLogger::Info(guessRound.exprLine);
+            AppLogger::Info(guessRound.exprColorLine);
+        }
+        return false;
+    }
+
+    AppLogger::Info(std::format("Verify: {} case(s) and {} round(s) agree ({} skipped: no valid expression, {} over the universe limit), {:.0f} ms.",
+        checkedCaseCount, checkedRoundCount, skippedCaseCount, overLimitCaseCount,
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count()));
+    return true;
+}
+
+}  // namespace DifferentialCheck
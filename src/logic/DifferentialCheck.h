@@ -0,0 +1,86 @@
+/* ----- ----- ----- ----- */
+// DifferentialCheck.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/17
+// Update Date: 2026/10/17
+// Version: v1.1
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "GuessUniverse.h"
+#include "SolverOptions.h"
+
+/**
+ * @namespace DifferentialCheck
+ * @brief Random games replayed through the reference path and every fast engine (`--verify=<cases>`).
+ *
+ * <summary>
+ * The reference path is `CandidateGenerator::generate` for round 1 and
+ * `ExpressionValidator::filterExpressions` for later rounds. Each registered engine gets
+ * the same inputs (round 1: the guess and its colors; later rounds: the reference
+ * survivors of the previous round, the updated constraints and the round's guess and
+ * feedback) and must return exactly the same candidate set. Later rounds also check the
+ * feedback-bucket path (`SpeculativePartition`) that replaces the constraint filter with
+ * `--speculate`. A new fast path is registered in `DifferentialCheck.cpp`.
+ *
+ * Each case draws a random length, operator set, hidden answer and up to four
+ * guesses; the colors are computed (`FeedbackCode::compute`). The first divergence is
+ * shrunk to the fewest rounds that still diverge and printed as solver input.
+ * </summary>
+ */
+namespace DifferentialCheck {
+
+    /**
+     * @struct GuessRound
+     * @brief One guess of a case and its feedback.
+     */
+    struct GuessRound {
+        std::string exprLine;       ///< Guess
+        std::string exprColorLine;  ///< Feedback ('g', 'y', 'r')
+    };
+
+    /**
+     * @struct Divergence
+     * @brief First candidate set on which an engine and the reference disagree.
+     */
+    struct Divergence {
+        std::string engineName;           ///< Engine that disagreed
+        size_t roundIndex = 0;            ///< Round of the history (0 = generation)
+        size_t referenceCount = 0;        ///< Candidates kept by the reference
+        size_t engineCount = 0;           ///< Candidates kept by the engine
+        std::string missingLine;          ///< A candidate only the reference kept (empty if none)
+        std::string extraLine;            ///< A candidate only the engine kept (empty if none)
+    };
+
+    /**
+     * @brief Replays one history through the reference and every engine.
+     *
+     * @param exprLength Expression length of the game.
+     * @param operatorsSet Operators of the game.
+     * @param guessUniverse Every valid expression of the game (source of the `universeFilter` engine).
+     * @param guessRoundsList Guesses and feedback, in play order.
+     * @return std::optional<Divergence> First disagreement, or nothing if every engine agreed on every round.
+     */
+    std::optional<Divergence> checkGame(
+        int exprLength,
+        const std::unordered_set<char>& operatorsSet,
+        const GuessUniverse& guessUniverse,
+        const std::vector<GuessRound>& guessRoundsList
+    );
+
+    /**
+     * @brief Checks `SolverOptions::verifyCaseCount` random cases and prints the outcome.
+     *
+     * @param solverOptions Case count, lengths and seed.
+     * @return true if no engine diverged.
+     */
+    bool run(const SolverOptions& solverOptions);
+
+}  // namespace DifferentialCheck
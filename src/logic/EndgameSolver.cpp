@@ -0,0 +1,341 @@
+/* ----- ----- ----- ----- */
+// EndgameSolver.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#include "EndgameSolver.h"
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+#include "core/logging/AppLogger.h"
+
+namespace {
+
+constexpr std::uint64_t COST_KEY_WEIGHT = 1ull << 16;  ///< Above any secondary cost (64 answers x 64 guesses)
+constexpr std::uint64_t NO_LIMIT_KEY = std::numeric_limits<std::uint64_t>::max();
+
+/**
+ * @brief Number of answers in a subset mask.
+ */
+std::uint32_t getSubsetSize(std::uint64_t subsetMask) {
+    return static_cast<std::uint32_t>(std::popcount(subsetMask));
+}
+
+}  // namespace (end of anonymous)
+
+/**
+ * @brief Renders the tree as indented lines, two spaces per guess already played.
+ *
+ * @param candidatePool Pool the node handles refer to.
+ * @return std::vector<std::string> One line per node, root first.
+ */
+std::vector<std::string> EndgameTree::toLines(const CandidatePool& candidatePool) const {
+    std::vector<std::string> linesList;
+    if (nodesList.empty()) return linesList;
+
+    const int exprLength = candidatePool.getExprLength();
+    auto appendLines = [&](auto& self, std::uint32_t nodeIndex, int depth, const std::string& prefix) -> void {
+        const Node& node = nodesList[nodeIndex];
+        std::string nodeLine = std::string(static_cast<size_t>(depth) * 2, ' ') + prefix;
+        nodeLine += candidatePool.view(node.guessHandle);
+        if (node.answerCount > 1) nodeLine += std::format(" ({})", node.answerCount);
+        linesList.push_back(std::move(nodeLine));
+
+        for (const Branch& branch : node.branchesList)
+            self(self, branch.childIndex, depth + 1, FeedbackCode::toColorLine(branch.code, exprLength) + " -> ");
+    };
+    appendLines(appendLines, 0, 0, "");
+    return linesList;
+}
+
+/**
+ * @brief Writes the tree to a text file, one node per line.
+ *
+ * @param filePath Output file.
+ * @param candidatePool Pool the node handles refer to.
+ * @return true if the file was written.
+ */
+bool EndgameTree::save(const std::string& filePath, const CandidatePool& candidatePool) const {
+    std::ofstream ofs(filePath);
+    if (!ofs.is_open()) {
+        AppLogger::Error(std::format("Failed to write endgame tree: {}", filePath));
+        return false;
+    }
+    ofs << std::format("# {} answers, {:.3f} guesses on average, at most {}\n",
+        answerCount, getExpectedGuesses(), worstGuesses);
+    for (const std::string& line : toLines(candidatePool))
+        ofs << line << '\n';
+    return static_cast<bool>(ofs);
+}
+
+/**
+ * @brief Computes the optimal strategy for the given answers.
+ *
+ * @param candidatePool Pool the handles refer to.
+ * @param answerHandlesList Possible answers (at most `MAX_ANSWER_COUNT`); each is also a possible guess.
+ * @param extraGuessHandlesList Other expressions that may be played as probing guesses.
+ * @param objective What to minimise.
+ * @param timeBudgetMs Search deadline in milliseconds.
+ * @return std::optional<EndgameTree> Optimal strategy, or nothing if there are too many
+ *         answers or the deadline was reached.
+ */
+std::optional<EndgameTree> EndgameSolver::solve(
+    const CandidatePool& candidatePool,
+    const std::vector<CandidateHandle>& answerHandlesList,
+    const std::vector<CandidateHandle>& extraGuessHandlesList,
+    Objective objective,
+    long long timeBudgetMs
+) {
+    searchStats = SearchStats{};
+    memoMap.clear();
+    if (answerHandlesList.empty() || answerHandlesList.size() > MAX_ANSWER_COUNT) return std::nullopt;
+
+    auto startTime = std::chrono::steady_clock::now();
+    this->objective = objective;
+    answerCount = answerHandlesList.size();
+    deadline = startTime + std::chrono::milliseconds(timeBudgetMs);
+
+    // Guesses: the answers first (guess i = answer i), then the probing expressions
+    guessHandlesList = answerHandlesList;
+    guessHandlesList.insert(guessHandlesList.end(), extraGuessHandlesList.begin(), extraGuessHandlesList.end());
+
+    // Feedback of every guess against every answer, computed once
+    const int exprLength = candidatePool.getExprLength();
+    std::vector<std::uint8_t> lanesList(guessHandlesList.size() * static_cast<size_t>(exprLength));
+    for (size_t guessIndex = 0; guessIndex < guessHandlesList.size(); ++guessIndex)
+        FeedbackCode::toLanes(candidatePool.view(guessHandlesList[guessIndex]), lanesList.data() + guessIndex * exprLength);
+    feedbackMatrix.resize(guessHandlesList.size() * answerCount);
+    for (size_t guessIndex = 0; guessIndex < guessHandlesList.size(); ++guessIndex) {
+        for (size_t answerIndex = 0; answerIndex < answerCount; ++answerIndex) {
+            feedbackMatrix[guessIndex * answerCount + answerIndex] = FeedbackCode::compute(
+                lanesList.data() + guessIndex * exprLength, lanesList.data() + answerIndex * exprLength, exprLength);
+        }
+    }
+    allGreenCode = FeedbackCode::getAllGreenCode(exprLength);
+
+    const std::uint64_t fullMask = (answerCount == MAX_ANSWER_COUNT) ? ~0ull : ((1ull << answerCount) - 1);
+    SubsetCost rootCost;
+    const bool isSolved = solveSubset(fullMask, NO_LIMIT_KEY, rootCost);
+
+    searchStats.memoEntryCount = memoMap.size();
+    searchStats.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+    if (!isSolved) return std::nullopt;
+
+    EndgameTree endgameTree;
+    endgameTree.answerCount = answerCount;
+    endgameTree.totalGuesses = rootCost.totalGuesses;
+    endgameTree.worstGuesses = static_cast<int>(rootCost.worstGuesses);
+    appendNode(fullMask, endgameTree);
+    return endgameTree;
+}
+
+/**
+ * @brief Packs a cost into one integer ordered by the objective (primary cost in the high part).
+ */
+std::uint64_t EndgameSolver::toKey(const SubsetCost& subsetCost) const {
+    if (objective == Objective::WorstGuesses)
+        return subsetCost.worstGuesses * COST_KEY_WEIGHT + subsetCost.totalGuesses;
+    return subsetCost.totalGuesses * COST_KEY_WEIGHT + subsetCost.worstGuesses;
+}
+
+/**
+ * @brief Cheapest cost any strategy can reach for a subset.
+ *
+ * <summary>
+ * One answer takes one guess. Otherwise at most one answer is found by the first guess
+ * and every other one needs at least a second: 2n - 1 guesses in total, 2 in the worst case.
+ * </summary>
+ */
+EndgameSolver::SubsetCost EndgameSolver::getLowerBound(std::uint64_t subsetMask) {
+    const std::uint32_t subsetSize = getSubsetSize(subsetMask);
+    if (subsetSize <= 1) return SubsetCost{ subsetSize, subsetSize };
+    return SubsetCost{ 2 * subsetSize - 1, 2 };
+}
+
+/**
+ * @brief Groups a subset by the feedback of one guess (the all-green answer is left out).
+ *
+ * @param subsetMask Answers to group.
+ * @param guessIndex Guess (index into the guess list).
+ * @param[out] guessSplit Groups, largest first.
+ */
+void EndgameSolver::splitSubset(std::uint64_t subsetMask, std::uint32_t guessIndex, GuessSplit& guessSplit) const {
+    std::vector<std::pair<FeedbackCode::Code, std::uint64_t>> groupsList;
+    const FeedbackCode::Code* guessCodes = feedbackMatrix.data() + static_cast<size_t>(guessIndex) * answerCount;
+    for (std::uint64_t remainingMask = subsetMask; remainingMask != 0; remainingMask &= remainingMask - 1) {
+        const int answerIndex = std::countr_zero(remainingMask);
+        const FeedbackCode::Code code = guessCodes[answerIndex];
+        if (code == allGreenCode) continue;
+        auto groupIt = std::find_if(groupsList.begin(), groupsList.end(),
+            [code](const std::pair<FeedbackCode::Code, std::uint64_t>& group) { return group.first == code; });
+        if (groupIt == groupsList.end())
+            groupsList.emplace_back(code, 1ull << answerIndex);
+        else
+            groupIt->second |= 1ull << answerIndex;
+    }
+
+    guessSplit.guessIndex = guessIndex;
+    guessSplit.squaredSizeSum = 0;
+    guessSplit.groupMasksList.clear();
+    for (const auto& [code, groupMask] : groupsList) {
+        const std::uint64_t groupSize = getSubsetSize(groupMask);
+        guessSplit.squaredSizeSum += groupSize * groupSize;
+        guessSplit.groupMasksList.push_back(groupMask);
+    }
+    std::sort(guessSplit.groupMasksList.begin(), guessSplit.groupMasksList.end(),
+        [](std::uint64_t lhs, std::uint64_t rhs) { return getSubsetSize(lhs) > getSubsetSize(rhs); });
+}
+
+/**
+ * @brief Finds the optimal cost of a subset, if it is below a limit.
+ *
+ * @param subsetMask Answers still possible.
+ * @param limitKey Exclusive upper bound on the cost key worth finding.
+ * @param[out] subsetCost Optimal cost (only set when true is returned).
+ * @return true if the optimum is below `limitKey`; false if it is not or the deadline passed.
+ */
+bool EndgameSolver::solveSubset(std::uint64_t subsetMask, std::uint64_t limitKey, SubsetCost& subsetCost) {
+    const std::uint32_t subsetSize = getSubsetSize(subsetMask);
+    if (subsetSize <= 2) {
+        // Guess either answer: found at once, or the other one is certain next
+        subsetCost = (subsetSize == 1) ? SubsetCost{ 1, 1 } : SubsetCost{ 3, 2 };
+        return toKey(subsetCost) < limitKey;
+    }
+
+    auto memoIt = memoMap.find(subsetMask);
+    if (memoIt != memoMap.end()) {
+        if (memoIt->second.isExact) {
+            ++searchStats.memoHitCount;
+            subsetCost = memoIt->second.exactCost;
+            return toKey(subsetCost) < limitKey;
+        }
+        if (memoIt->second.lowerBoundKey >= limitKey) {
+            ++searchStats.memoHitCount;
+            return false;
+        }
+    }
+
+    const std::uint64_t subsetBoundKey = toKey(getLowerBound(subsetMask));
+    if (subsetBoundKey >= limitKey) return false;
+    if (searchStats.isTimedOut || std::chrono::steady_clock::now() >= deadline) {
+        searchStats.isTimedOut = true;
+        return false;
+    }
+    ++searchStats.nodeCount;
+
+    // Split by every guess that tells something; try the most even splits first
+    std::vector<GuessSplit> guessSplitsList;
+    guessSplitsList.reserve(guessHandlesList.size());
+    for (std::uint32_t guessIndex = 0; guessIndex < guessHandlesList.size(); ++guessIndex) {
+        GuessSplit guessSplit;
+        splitSubset(subsetMask, guessIndex, guessSplit);
+        if (guessSplit.groupMasksList.size() == 1 && guessSplit.groupMasksList.front() == subsetMask) continue;
+        guessSplitsList.push_back(std::move(guessSplit));
+    }
+    std::sort(guessSplitsList.begin(), guessSplitsList.end(), [](const GuessSplit& lhs, const GuessSplit& rhs) {
+        if (lhs.squaredSizeSum != rhs.squaredSizeSum) return lhs.squaredSizeSum < rhs.squaredSizeSum;
+        return lhs.guessIndex < rhs.guessIndex;
+    });
+
+    std::uint64_t bestKey = limitKey;
+    SubsetCost bestCost;
+    std::uint32_t bestGuessIndex = 0;
+    bool isFound = false;
+    std::vector<SubsetCost> groupCostsList;
+    for (const GuessSplit& guessSplit : guessSplitsList) {
+        // Lower bound of this guess, refined as its groups get solved
+        groupCostsList.clear();
+        for (std::uint64_t groupMask : guessSplit.groupMasksList)
+            groupCostsList.push_back(getLowerBound(groupMask));
+        auto combineCosts = [&]() {
+            SubsetCost combinedCost{ subsetSize, 1 };
+            for (const SubsetCost& groupCost : groupCostsList) {
+                combinedCost.totalGuesses += groupCost.totalGuesses;
+                combinedCost.worstGuesses = (std::max)(combinedCost.worstGuesses, groupCost.worstGuesses + 1);
+            }
+            return combinedCost;
+        };
+        if (toKey(combineCosts()) >= bestKey) continue;
+
+        bool isCandidate = true;
+        for (size_t groupIndex = 0; groupIndex < guessSplit.groupMasksList.size(); ++groupIndex) {
+            // Largest cost of this group that can still beat the best guess (primary cost only)
+            const std::uint64_t bestPrimary = (bestKey - 1) / COST_KEY_WEIGHT;
+            std::uint64_t childLimitKey = 0;
+            if (objective == Objective::WorstGuesses) {
+                childLimitKey = bestPrimary * COST_KEY_WEIGHT;
+            } else {
+                const std::uint64_t otherTotal = combineCosts().totalGuesses - groupCostsList[groupIndex].totalGuesses;
+                childLimitKey = (bestPrimary >= otherTotal) ? (bestPrimary - otherTotal + 1) * COST_KEY_WEIGHT : 0;
+            }
+
+            SubsetCost groupCost;
+            if (!solveSubset(guessSplit.groupMasksList[groupIndex], childLimitKey, groupCost)) {
+                isCandidate = false;
+                break;
+            }
+            groupCostsList[groupIndex] = groupCost;
+            if (toKey(combineCosts()) >= bestKey) {
+                isCandidate = false;
+                break;
+            }
+        }
+        if (searchStats.isTimedOut) return false;
+        if (!isCandidate) continue;
+
+        bestCost = combineCosts();
+        bestKey = toKey(bestCost);
+        bestGuessIndex = guessSplit.guessIndex;
+        isFound = true;
+        if (bestKey == subsetBoundKey) break;
+    }
+
+    MemoEntry& memoEntry = memoMap[subsetMask];
+    if (!isFound) {
+        memoEntry.lowerBoundKey = (std::max)(memoEntry.lowerBoundKey, limitKey);
+        return false;
+    }
+    memoEntry.isExact = true;
+    memoEntry.exactCost = bestCost;
+    memoEntry.bestGuessIndex = bestGuessIndex;
+    subsetCost = bestCost;
+    return true;
+}
+
+/**
+ * @brief Appends the solved strategy of a subset to a tree.
+ *
+ * @param subsetMask Solved subset (exact in the memo when it has more than two answers).
+ * @param endgameTree Tree to extend.
+ * @return std::uint32_t Index of the subset's node.
+ */
+std::uint32_t EndgameSolver::appendNode(std::uint64_t subsetMask, EndgameTree& endgameTree) const {
+    const std::uint32_t nodeIndex = static_cast<std::uint32_t>(endgameTree.nodesList.size());
+    const std::uint32_t subsetSize = getSubsetSize(subsetMask);
+    const std::uint32_t guessIndex = (subsetSize <= 2)
+        ? static_cast<std::uint32_t>(std::countr_zero(subsetMask))
+        : memoMap.at(subsetMask).bestGuessIndex;
+
+    endgameTree.nodesList.push_back(EndgameTree::Node{ guessHandlesList[guessIndex], subsetSize, {} });
+    if (subsetSize == 1) return nodeIndex;
+
+    GuessSplit guessSplit;
+    splitSubset(subsetMask, guessIndex, guessSplit);
+    std::vector<EndgameTree::Branch> branchesList;
+    for (std::uint64_t groupMask : guessSplit.groupMasksList) {
+        const FeedbackCode::Code code = feedbackMatrix[static_cast<size_t>(guessIndex) * answerCount + std::countr_zero(groupMask)];
+        branchesList.push_back(EndgameTree::Branch{ code, appendNode(groupMask, endgameTree) });
+    }
+    std::sort(branchesList.begin(), branchesList.end(),
+        [](const EndgameTree::Branch& lhs, const EndgameTree::Branch& rhs) { return lhs.code < rhs.code; });
+    endgameTree.nodesList[nodeIndex].branchesList = std::move(branchesList);
+    return nodeIndex;
+}
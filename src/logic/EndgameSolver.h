@@ -0,0 +1,200 @@
+/* ----- ----- ----- ----- */
+// EndgameSolver.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/17
+// Version: v1.1
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CandidatePool.h"
+#include "FeedbackCode.h"
+
+/**
+ * @class EndgameTree
+ * @brief Complete guessing strategy for a small survivor set: one guess per reachable situation.
+ *
+ * <summary>
+ * Node 0 is the guess to play now. Every branch is one feedback the guess can produce
+ * (all-green excluded) and points to the node played next. A node without branches is an
+ * answer that is certain by then.
+ * </summary>
+ */
+class EndgameTree {
+public:
+    /**
+     * @struct Branch
+     * @brief Feedback of a node's guess and the node played after it.
+     */
+    struct Branch {
+        FeedbackCode::Code code = 0;  ///< Feedback of the parent guess
+        std::uint32_t childIndex = 0; ///< Index of the next node in `nodesList`
+    };
+
+    /**
+     * @struct Node
+     * @brief One guess of the strategy.
+     */
+    struct Node {
+        CandidateHandle guessHandle = 0;   ///< Guess (handle into the solved pool)
+        std::uint32_t answerCount = 0;     ///< Answers still possible when this guess is played
+        std::vector<Branch> branchesList;  ///< Next node per non-green feedback, sorted by code
+    };
+
+    std::vector<Node> nodesList;  ///< Strategy nodes; node 0 is the root
+    size_t answerCount = 0;       ///< Answers covered by the strategy
+    size_t totalGuesses = 0;      ///< Guesses needed to find every answer, summed over answers
+    int worstGuesses = 0;         ///< Guesses needed for the hardest answer
+
+    /**
+     * @brief Average number of guesses, the answers being equally likely.
+     */
+    double getExpectedGuesses() const {
+        return answerCount == 0 ? 0.0 : static_cast<double>(totalGuesses) / static_cast<double>(answerCount);
+    }
+
+    /**
+     * @brief Renders the tree as indented lines (`"<feedback> -> <guess> (<answers>)"`).
+     *
+     * @param candidatePool Pool the node handles refer to.
+     * @return std::vector<std::string> One line per node, root first.
+     */
+    std::vector<std::string> toLines(const CandidatePool& candidatePool) const;
+
+    /**
+     * @brief Writes `toLines` to a text file.
+     *
+     * @param filePath Output file.
+     * @param candidatePool Pool the node handles refer to.
+     * @return true if the file was written.
+     */
+    bool save(const std::string& filePath, const CandidatePool& candidatePool) const;
+};
+
+/**
+ * @class EndgameSolver
+ * @brief Exact optimal strategy for a small survivor set, by memoised recursive partitioning.
+ *
+ * <summary>
+ * With at most `MAX_ANSWER_COUNT` answers left, the survivors of any later round are a
+ * subset of them and fit in one 64-bit mask. The cost of a subset is solved once and
+ * memoised on its mask:
+ *     cost(S) = min over guesses g of  combine(|S|, cost(S_k) for every non-green group S_k of g).
+ * Every answer pays the current guess (|S| guesses), so the total over answers is
+ * |S| + sum_k total(S_k), and the worst case is 1 + max_k worst(S_k).
+ *
+ * The search is a branch-and-bound: guesses are tried best-split first, a guess is
+ * dropped as soon as its lower bound (a group of n answers needs at least 2n - 1 guesses,
+ * and 2 in the worst case) reaches the best cost found, and each recursive call gets the
+ * largest cost that can still improve its parent. A subset that could not beat a limit
+ * keeps that limit as a memoised lower bound.
+ *
+ * The search stops at a deadline (`solve` then returns no tree), so it never holds up a round.
+ * </summary>
+ */
+class EndgameSolver {
+public:
+    static constexpr size_t MAX_ANSWER_COUNT = 64;  ///< Answers that fit in one subset mask
+    static constexpr size_t UNIVERSE_PROBE_COUNT = 16;  ///< Best universe guesses added as probes when guessing from the universe
+
+    /**
+     * @enum Objective
+     * @brief What the strategy minimises.
+     */
+    enum class Objective {
+        ExpectedGuesses,  ///< Average guesses (ties: fewest guesses for the hardest answer)
+        WorstGuesses      ///< Guesses for the hardest answer (ties: fewest on average)
+    };
+
+    /**
+     * @struct SearchStats
+     * @brief Work done by the last `solve`.
+     */
+    struct SearchStats {
+        size_t nodeCount = 0;        ///< Subsets searched (memo hits excluded)
+        size_t memoHitCount = 0;     ///< Subsets answered from the memo
+        size_t memoEntryCount = 0;   ///< Subsets memoised
+        long long elapsedMs = 0;     ///< Wall time of the search
+        bool isTimedOut = false;     ///< True if the deadline stopped the search
+    };
+
+    EndgameSolver() = default;
+
+    /**
+     * @brief Computes the optimal strategy for the given answers.
+     *
+     * @param candidatePool Pool the handles refer to.
+     * @param answerHandlesList Possible answers (at most `MAX_ANSWER_COUNT`); each is also a possible guess.
+     * @param extraGuessHandlesList Other expressions that may be played as probing guesses.
+     * @param objective What to minimise.
+     * @param timeBudgetMs Search deadline in milliseconds.
+     * @return std::optional<EndgameTree> Optimal strategy, or nothing if there are too many
+     *         answers or the deadline was reached.
+     */
+    std::optional<EndgameTree> solve(
+        const CandidatePool& candidatePool,
+        const std::vector<CandidateHandle>& answerHandlesList,
+        const std::vector<CandidateHandle>& extraGuessHandlesList,
+        Objective objective,
+        long long timeBudgetMs
+    );
+
+    /**
+     * @brief Work done by the last `solve`.
+     */
+    const SearchStats& getStats() const { return searchStats; }
+
+private:
+    /**
+     * @struct SubsetCost
+     * @brief Guesses needed by a strategy for one subset.
+     */
+    struct SubsetCost {
+        std::uint32_t totalGuesses = 0;  ///< Summed over the subset's answers
+        std::uint32_t worstGuesses = 0;  ///< For the hardest answer
+    };
+
+    /**
+     * @struct MemoEntry
+     * @brief What is known about one subset.
+     */
+    struct MemoEntry {
+        std::uint64_t lowerBoundKey = 0;  ///< No strategy costs less than this (when not exact)
+        SubsetCost exactCost;             ///< Optimal cost (when exact)
+        std::uint32_t bestGuessIndex = 0; ///< Optimal guess (when exact)
+        bool isExact = false;             ///< True once the optimum is known
+    };
+
+    /**
+     * @struct GuessSplit
+     * @brief Non-green feedback groups of one guess over a subset.
+     */
+    struct GuessSplit {
+        std::uint32_t guessIndex = 0;              ///< Guess (index into the guess list)
+        std::uint64_t squaredSizeSum = 0;          ///< Sum of squared group sizes (ordering heuristic)
+        std::vector<std::uint64_t> groupMasksList; ///< Non-green groups, largest first
+    };
+
+    std::uint64_t toKey(const SubsetCost& subsetCost) const;
+    static SubsetCost getLowerBound(std::uint64_t subsetMask);
+    void splitSubset(std::uint64_t subsetMask, std::uint32_t guessIndex, GuessSplit& guessSplit) const;
+    bool solveSubset(std::uint64_t subsetMask, std::uint64_t limitKey, SubsetCost& subsetCost);
+    std::uint32_t appendNode(std::uint64_t subsetMask, EndgameTree& endgameTree) const;
+
+    Objective objective = Objective::ExpectedGuesses;
+    size_t answerCount = 0;
+    std::vector<CandidateHandle> guessHandlesList;      ///< Answers first, then the extra guesses
+    std::vector<FeedbackCode::Code> feedbackMatrix;     ///< Code of guess g against answer a at [g * answerCount + a]
+    FeedbackCode::Code allGreenCode = 0;
+    std::unordered_map<std::uint64_t, MemoEntry> memoMap;  ///< Subset mask -> what is known about it
+    std::chrono::steady_clock::time_point deadline;
+    SearchStats searchStats;
+};
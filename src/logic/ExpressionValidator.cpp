@@ -3,13 +3,14 @@
 // Do not distribute or modify
 // Author: DragonTaki (https://github.com/DragonTaki)
 // Create Date: 2025/10/01
-// Update Date: 2025/10/16
-// Version: v1.1
+// Update Date: 2026/10/17
+// Version: v1.4
 /* ----- ----- ----- ----- */
 
 #include "ExpressionValidator.h"
 #include <algorithm>
 #include <iostream>
+#include <numeric>
 #include <optional>
 #include <stack>
 #include <stdexcept>
@@ -19,10 +20,15 @@
 #include <unordered_set>
 
 #include "Constraint.h"
+#include "ConstraintSnapshot.h"
 #include "ConstraintUtils.h"
+#include "util/ParallelUtils.h"
+#include "util/TraceRecorder.h"
 
 namespace {
 
+constexpr size_t MIN_FILTER_ITEMS_PER_WORKER = 8192;  ///< Below this chunk size, threads cost more than they save
+
 /**
  * @brief Get operator precedence.
  *
@@ -278,6 +284,13 @@ bool ExpressionValidator::isInteger(double value, double epsilon) {
 /**
  * @brief Filter candidate expressions according to current constraints.
  *
+ * <summary>
+ * The positions of the survivors are found in parallel chunks (see
+ * `ParallelUtils::compactInPlace`), then only the survivors are copied, in their
+ * original order. `ConstraintUtils::isCandidateValid` only reads `constraintsMap`,
+ * so the workers can share it without locking.
+ * </summary>
+ *
  * @param candidates List of candidate expressions to filter
  * @param constraintsMap Current constraints mapping character -> Constraint
  * @return Filtered list of candidates satisfying all constraints
@@ -286,12 +299,118 @@ std::vector<std::string> ExpressionValidator::filterExpressions(
     const std::vector<std::string>& candidatesList,
     const std::unordered_map<char, Constraint>& constraintsMap
 ) {
+    TraceRecorder::Span traceSpan("filterExpressions");
+    std::vector<size_t> survivorIndicesList(candidatesList.size());
+    std::iota(survivorIndicesList.begin(), survivorIndicesList.end(), size_t{0});
+    ParallelUtils::compactInPlace(
+        survivorIndicesList,
+        [&candidatesList, &constraintsMap](size_t candidateIndex) {
+            return ConstraintUtils::isCandidateValid(candidatesList[candidateIndex], constraintsMap);
+        },
+        MIN_FILTER_ITEMS_PER_WORKER
+    );
+
     std::vector<std::string> filteredCandidatesList;
+    filteredCandidatesList.reserve(survivorIndicesList.size());
+    for (size_t candidateIndex : survivorIndicesList)
+        filteredCandidatesList.push_back(candidatesList[candidateIndex]);
+    return filteredCandidatesList;
+}
 
-    for (auto& c : candidatesList) {
-        if (ConstraintUtils::isCandidateValid(c, constraintsMap))
-            filteredCandidatesList.push_back(c);
+/**
+ * @brief Filter candidate handles in place, chunked across threads.
+ *
+ * <summary>
+ * The constraints map is flattened once into a `ConstraintSnapshot`; each candidate is
+ * then checked with per-position lane masks and, when the pool stores histograms,
+ * a SWAR min/max comparison against its precomputed symbol histogram.
+ * </summary>
+ *
+ * @param candidatePool Arena holding the candidate expressions
+ * @param candidateHandlesList Handles of the candidates; rejected handles are removed in place
+ * @param constraintsMap Current constraints mapping character -> Constraint
+ * @return size_t Number of surviving candidates
+ */
+size_t ExpressionValidator::filterCandidatesInPlace(
+    const CandidatePool& candidatePool,
+    std::vector<CandidateHandle>& candidateHandlesList,
+    const std::unordered_map<char, Constraint>& constraintsMap
+) {
+    const ConstraintSnapshot constraintSnapshot =
+        ConstraintSnapshot::build(constraintsMap, candidatePool.getExprLength());
+
+    if (!candidatePool.hasHistograms()) {
+        return ParallelUtils::compactInPlace(
+            candidateHandlesList,
+            [&candidatePool, &constraintSnapshot](CandidateHandle handle) {
+                return constraintSnapshot.isCandidateValid(candidatePool.view(handle));
+            },
+            MIN_FILTER_ITEMS_PER_WORKER
+        );
     }
 
-    return filteredCandidatesList;
+    return ParallelUtils::compactInPlace(
+        candidateHandlesList,
+        [&candidatePool, &constraintSnapshot](CandidateHandle handle) {
+            return constraintSnapshot.isCandidateValid(candidatePool.view(handle), candidatePool.getHistogram(handle));
+        },
+        MIN_FILTER_ITEMS_PER_WORKER
+    );
+}
+
+/**
+ * @brief Filter a compressed survivor set according to current constraints
+ *
+ * @param candidatePool Arena holding the candidate expressions
+ * @param survivorSet Current survivors
+ * @param constraintsMap Current constraints mapping character -> Constraint
+ * @return SurvivorSet Survivors satisfying the constraints
+ */
+SurvivorSet ExpressionValidator::filterSurvivors(
+    const CandidatePool& candidatePool,
+    const SurvivorSet& survivorSet,
+    const std::unordered_map<char, Constraint>& constraintsMap
+) {
+    TraceRecorder::Span traceSpan("filterSurvivors");
+    const ConstraintSnapshot constraintSnapshot =
+        ConstraintSnapshot::build(constraintsMap, candidatePool.getExprLength());
+
+    if (!candidatePool.hasHistograms()) {
+        return survivorSet.filter(
+            [&candidatePool, &constraintSnapshot](CandidateHandle handle) {
+                return constraintSnapshot.isCandidateValid(candidatePool.view(handle));
+            },
+            MIN_FILTER_ITEMS_PER_WORKER
+        );
+    }
+
+    return survivorSet.filter(
+        [&candidatePool, &constraintSnapshot](CandidateHandle handle) {
+            return constraintSnapshot.isCandidateValid(candidatePool.view(handle), candidatePool.getHistogram(handle));
+        },
+        MIN_FILTER_ITEMS_PER_WORKER
+    );
+}
+
+/**
+ * @brief Filter a survivor set by walking a prefix trie of the pool
+ *
+ * @param candidatePool Arena holding the candidate expressions
+ * @param candidateTrie Trie built over `candidatePool`
+ * @param survivorSet Current survivors
+ * @param constraintsMap Current constraints mapping character -> Constraint
+ * @return SurvivorSet Survivors satisfying the constraints
+ */
+SurvivorSet ExpressionValidator::filterSurvivorsByTrie(
+    const CandidatePool& candidatePool,
+    const CandidateTrie& candidateTrie,
+    const SurvivorSet& survivorSet,
+    const std::unordered_map<char, Constraint>& constraintsMap
+) {
+    TraceRecorder::Span traceSpan("filterSurvivorsByTrie");
+    const ConstraintSnapshot constraintSnapshot =
+        ConstraintSnapshot::build(constraintsMap, candidatePool.getExprLength());
+
+    SurvivorSet trieSurvivorSet = SurvivorSet::fromSortedHandles(candidateTrie.collectSurvivors(constraintSnapshot));
+    return trieSurvivorSet.intersect(survivorSet);
 }
@@ -3,8 +3,8 @@
 // Do not distribute or modify
 // Author: DragonTaki (https://github.com/DragonTaki)
 // Create Date: 2025/10/01
-// Update Date: 2025/10/16
-// Version: v1.1
+// Update Date: 2026/10/17
+// Version: v1.4
 /* ----- ----- ----- ----- */
 
 #pragma once
@@ -15,8 +15,11 @@
 #include <unordered_set>
 #include <vector>
 
+#include "CandidatePool.h"
+#include "CandidateTrie.h"
 #include "Constraint.h"
 #include "ExpressionValidator.h"
+#include "SurvivorSet.h"
 
 /**
  * @class ExpressionValidator
@@ -132,13 +135,73 @@ public:
      * @return Filtered list of candidates satisfying all constraints.
      *
      * <summary>
-     * Iterates through each candidate and checks it against `constraintsMap` using
-     * ConstraintUtils::isCandidateValid. Only candidates passing all constraints
-     * are returned.
+     * Checks each candidate against `constraintsMap` using
+     * ConstraintUtils::isCandidateValid, in parallel chunks. Only candidates passing
+     * all constraints are copied into the result, in their original order.
      * </summary>
      */
     std::vector<std::string> filterExpressions(
         const std::vector<std::string>& candidatesList,
         const std::unordered_map<char, Constraint>& constraintsMap
     );
+
+    /**
+     * @brief Filter candidate handles in place according to current constraints.
+     *
+     * @param candidatePool Arena the handles point into.
+     * @param candidateHandlesList Handles of the current candidates; rejected handles are removed.
+     * @param constraintsMap Mapping from character to Constraint object.
+     * @return size_t Number of surviving candidates.
+     *
+     * <summary>
+     * Parallel, order-preserving compaction (`ParallelUtils::compactInPlace`) of
+     * 4-byte handles; the expressions themselves stay in the pool.
+     * Checks run against a `ConstraintSnapshot` and the pool's precomputed histograms.
+     * </summary>
+     */
+    size_t filterCandidatesInPlace(
+        const CandidatePool& candidatePool,
+        std::vector<CandidateHandle>& candidateHandlesList,
+        const std::unordered_map<char, Constraint>& constraintsMap
+    );
+
+    /**
+     * @brief Filter a compressed survivor set according to current constraints.
+     *
+     * @param candidatePool Arena the handles point into.
+     * @param survivorSet Current survivors.
+     * @param constraintsMap Mapping from character to Constraint object.
+     * @return SurvivorSet Survivors satisfying `constraintsMap`.
+     *
+     * <summary>
+     * Only the handles already in `survivorSet` are checked (64K chunks in parallel),
+     * so late rounds cost time proportional to the number of survivors.
+     * </summary>
+     */
+    SurvivorSet filterSurvivors(
+        const CandidatePool& candidatePool,
+        const SurvivorSet& survivorSet,
+        const std::unordered_map<char, Constraint>& constraintsMap
+    );
+
+    /**
+     * @brief Filter a survivor set by walking a prefix trie of the pool.
+     *
+     * @param candidatePool Arena the handles point into.
+     * @param candidateTrie Trie built over `candidatePool`.
+     * @param survivorSet Current survivors.
+     * @param constraintsMap Mapping from character to Constraint object.
+     * @return SurvivorSet Survivors satisfying `constraintsMap`.
+     *
+     * <summary>
+     * The trie discards whole prefixes at once, then its survivors are intersected
+     * with `survivorSet`, so the result is exactly what `filterSurvivors` would keep.
+     * </summary>
+     */
+    SurvivorSet filterSurvivorsByTrie(
+        const CandidatePool& candidatePool,
+        const CandidateTrie& candidateTrie,
+        const SurvivorSet& survivorSet,
+        const std::unordered_map<char, Constraint>& constraintsMap
+    );
 };
@@ -0,0 +1,336 @@
+/* ----- ----- ----- ----- */
+// FeedbackCode.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "SymbolHistogram.h"
+
+/**
+ * @file FeedbackCode.h
+ * @brief Packed color feedback of a guess against an answer (one base-3 digit per position).
+ *
+ * <summary>
+ * The color line "gyr..." the game shows for a guess is encoded as a single integer:
+ * position `i` contributes `digit * 3^i` with r = 0, y = 1, g = 2. Two answers give the
+ * same feedback for a guess exactly when their codes are equal, so partitioning the
+ * candidates by feedback is a plain histogram over codes.
+ *
+ * Feedback follows the game rules used by `updateConstraint`:
+ * 1. Every exact match is green.
+ * 2. Remaining guess symbols, left to right, are yellow while the answer still has an
+ *    unmatched occurrence of that symbol; otherwise red.
+ *
+ * The kernels work on lane indices (see `SymbolHistogram::laneOf`) instead of characters,
+ * so callers can convert candidates once and score them many times:
+ * - `compute()`: reference kernel for any length up to `MAX_LENGTH`.
+ * - `GuessKernel` + `PackedAnswer`: the same result for expressions up to
+ *   `MAX_PACKED_LENGTH`, with the per-guess work hoisted out of the answer loop.
+ * </summary>
+ */
+namespace FeedbackCode {
+
+using Code = std::uint32_t;  ///< Base-3 packed color line
+
+inline constexpr int MAX_LENGTH = 20;         ///< 3^20 still fits in 32 bits
+inline constexpr int MAX_PACKED_LENGTH = SymbolHistogram::MAX_COUNTABLE_LENGTH;  ///< Longest expression for `GuessKernel`
+
+inline constexpr Code DIGIT_RED = 0;     ///< 'r': symbol not (or no longer) in the answer
+inline constexpr Code DIGIT_YELLOW = 1;  ///< 'y': symbol in the answer, other position
+inline constexpr Code DIGIT_GREEN = 2;   ///< 'g': symbol at the right position
+
+/**
+ * @brief Returns 3^exponent.
+ */
+constexpr Code pow3(int exponent) {
+    Code result = 1;
+    for (int i = 0; i < exponent; ++i) result *= 3;
+    return result;
+}
+
+/**
+ * @brief Number of distinct codes for a given expression length (3^length).
+ */
+constexpr std::uint64_t getCodeCount(int exprLength) {
+    std::uint64_t result = 1;
+    for (int i = 0; i < exprLength; ++i) result *= 3;
+    return result;
+}
+
+/**
+ * @brief Code of an all-green line, i.e. the guess is the answer.
+ */
+constexpr Code getAllGreenCode(int exprLength) {
+    return pow3(exprLength) - 1;
+}
+
+/**
+ * @brief Converts an expression into lane indices (one byte per position).
+ *
+ * @param exprLine Expression made of `Expression::SYMBOLS` only.
+ * @param lanesOut Output buffer of at least `exprLine.size()` bytes.
+ */
+inline void toLanes(std::string_view exprLine, std::uint8_t* lanesOut) {
+    for (size_t position = 0; position < exprLine.size(); ++position)
+        lanesOut[position] = static_cast<std::uint8_t>(SymbolHistogram::laneOf(exprLine[position]));
+}
+
+/**
+ * @brief Computes the feedback code of a guess against an answer.
+ *
+ * <summary>
+ * Unmatched answer symbols are counted in the 4-bit lanes of one register (like
+ * `SymbolHistogram`) for expressions up to `SymbolHistogram::MAX_COUNTABLE_LENGTH`,
+ * byte counters otherwise. Both passes are branch-free: on real candidate sets the
+ * green / yellow outcome is close to random and branches would mispredict constantly.
+ * </summary>
+ *
+ * @param guessLanes Lane indices of the guess.
+ * @param answerLanes Lane indices of the answer.
+ * @param exprLength Length of both expressions (at most `MAX_LENGTH`).
+ * @return Code Packed feedback.
+ */
+inline Code compute(const std::uint8_t* guessLanes, const std::uint8_t* answerLanes, int exprLength) {
+    std::uint32_t greenMask = 0;
+    Code code = 0;
+    Code weight = 1;
+
+    if (exprLength <= SymbolHistogram::MAX_COUNTABLE_LENGTH) {
+        SymbolHistogram::Histogram unmatchedCounts = 0;
+
+        // Pass 1: greens, and answer symbols left for yellows
+        for (int position = 0; position < exprLength; ++position) {
+            std::uint32_t isGreen = (guessLanes[position] == answerLanes[position]);
+            greenMask |= isGreen << position;
+            unmatchedCounts += static_cast<SymbolHistogram::Histogram>(isGreen ^ 1u) << (answerLanes[position] * SymbolHistogram::LANE_BITS);
+        }
+
+        // Pass 2: yellows, left to right, limited by the unmatched answer symbols
+        for (int position = 0; position < exprLength; ++position, weight *= 3) {
+            const int shift = guessLanes[position] * SymbolHistogram::LANE_BITS;
+            std::uint32_t isGreen = (greenMask >> position) & 1u;
+            std::uint32_t isYellow = (((unmatchedCounts >> shift) & 0xF) != 0) & (isGreen ^ 1u);
+            unmatchedCounts -= static_cast<SymbolHistogram::Histogram>(isYellow) << shift;
+            code += (isGreen * DIGIT_GREEN + isYellow * DIGIT_YELLOW) * weight;
+        }
+        return code;
+    }
+
+    // Long expressions: a lane could overflow, use byte counters
+    std::uint8_t unmatchedCountsList[SymbolHistogram::LANE_COUNT] = {};
+    for (int position = 0; position < exprLength; ++position) {
+        std::uint32_t isGreen = (guessLanes[position] == answerLanes[position]);
+        greenMask |= isGreen << position;
+        unmatchedCountsList[answerLanes[position]] += static_cast<std::uint8_t>(isGreen ^ 1u);
+    }
+    for (int position = 0; position < exprLength; ++position, weight *= 3) {
+        std::uint32_t isGreen = (greenMask >> position) & 1u;
+        std::uint8_t& unmatchedCount = unmatchedCountsList[guessLanes[position]];
+        std::uint32_t isYellow = (unmatchedCount != 0) & (isGreen ^ 1u);
+        unmatchedCount -= static_cast<std::uint8_t>(isYellow);
+        code += (isGreen * DIGIT_GREEN + isYellow * DIGIT_YELLOW) * weight;
+    }
+    return code;
+}
+
+/**
+ * @brief Computes the feedback code of two expressions given as text.
+ */
+inline Code compute(std::string_view guessLine, std::string_view answerLine) {
+    std::uint8_t guessLanes[MAX_LENGTH];
+    std::uint8_t answerLanes[MAX_LENGTH];
+    toLanes(guessLine, guessLanes);
+    toLanes(answerLine, answerLanes);
+    return compute(guessLanes, answerLanes, static_cast<int>(guessLine.size()));
+}
+
+/**
+ * @brief Encodes a color line such as "ryyg" (unknown colors count as red).
+ */
+inline Code fromColorLine(std::string_view exprColorLine) {
+    Code code = 0;
+    Code weight = 1;
+    for (char colorChar : exprColorLine) {
+        if (colorChar == 'g') code += DIGIT_GREEN * weight;
+        else if (colorChar == 'y') code += DIGIT_YELLOW * weight;
+        weight *= 3;
+    }
+    return code;
+}
+
+/**
+ * @brief Decodes a code back into its color line.
+ */
+inline std::string toColorLine(Code code, int exprLength) {
+    std::string exprColorLine(exprLength, 'r');
+    for (int position = 0; position < exprLength; ++position, code /= 3) {
+        Code digit = code % 3;
+        if (digit == DIGIT_GREEN) exprColorLine[position] = 'g';
+        else if (digit == DIGIT_YELLOW) exprColorLine[position] = 'y';
+    }
+    return exprColorLine;
+}
+
+/**
+ * @brief Base-3 value of every 8-bit position mask (bit i set => digit 1 at position i).
+ */
+constexpr std::array<Code, 256> makeBase3OfByte() {
+    std::array<Code, 256> table{};
+    for (int mask = 0; mask < 256; ++mask) {
+        Code value = 0;
+        for (int bit = 0; bit < 8; ++bit) {
+            if ((mask >> bit) & 1) value += pow3(bit);
+        }
+        table[mask] = value;
+    }
+    return table;
+}
+
+inline constexpr std::array<Code, 256> BASE3_OF_BYTE = makeBase3OfByte();  ///< 8-bit mask -> base-3 digits
+
+/**
+ * @brief Converts a position mask (at most 16 positions) into base-3 digits of value 1.
+ */
+constexpr Code maskToBase3(std::uint32_t positionMask) {
+    return BASE3_OF_BYTE[positionMask & 0xFF] + BASE3_OF_BYTE[(positionMask >> 8) & 0xFF] * pow3(8);
+}
+
+/**
+ * @brief Bit i set for every zero byte i of `word` (portable `movemask(cmpeq(...))`).
+ */
+constexpr std::uint32_t zeroBytesMask(std::uint64_t word) {
+    constexpr std::uint64_t LOW_SEVEN_BITS = 0x7F7F7F7F7F7F7F7FULL;
+    std::uint64_t highBits = ~(((word & LOW_SEVEN_BITS) + LOW_SEVEN_BITS) | word | LOW_SEVEN_BITS);  // 0x80 in zero bytes
+    return static_cast<std::uint32_t>(((highBits >> 7) * 0x0102040810204080ULL) >> 56);
+}
+
+/**
+ * @struct PackedAnswer
+ * @brief An answer prepared once for `GuessKernel::compute`.
+ */
+struct PackedAnswer {
+    std::uint64_t laneWords[2] = {};              ///< Lane indices, one per byte, padded with 0xFF
+    SymbolHistogram::Histogram histogram = 0;     ///< Packed symbol counts
+
+    PackedAnswer() = default;
+
+    /**
+     * @param answerLanes Lane indices of the answer.
+     * @param exprLength Length of the answer (at most `MAX_PACKED_LENGTH`).
+     */
+    PackedAnswer(const std::uint8_t* answerLanes, int exprLength) {
+        std::uint8_t paddedLanes[16];
+        std::memset(paddedLanes, 0xFF, sizeof(paddedLanes));
+        std::memcpy(paddedLanes, answerLanes, exprLength);
+        std::memcpy(laneWords, paddedLanes, sizeof(paddedLanes));
+        for (int position = 0; position < exprLength; ++position)
+            histogram += SymbolHistogram::Histogram{1} << (answerLanes[position] * SymbolHistogram::LANE_BITS);
+    }
+};
+
+/**
+ * @class GuessKernel
+ * @brief Feedback of one fixed guess against many answers.
+ *
+ * <summary>
+ * Everything that only depends on the guess is prepared once:
+ * - Greens: one byte-equality mask between the padded lane words (SWAR).
+ * - Symbols used once in the guess: yellow iff not green and the answer contains the
+ *   symbol at all (a green on that symbol would be this very position).
+ * - Symbols used several times: the answer count minus the greens on that symbol gives
+ *   the yellows available, handed out to the non-green occurrences left to right.
+ * Every per-answer step is branch-free, and loop trip counts only depend on the guess,
+ * so they are predicted perfectly across the answer loop.
+ * The result equals `FeedbackCode::compute()`.
+ * </summary>
+ */
+class GuessKernel {
+public:
+    /**
+     * @param guessLanes Lane indices of the guess.
+     * @param exprLength Length of the guess (at most `MAX_PACKED_LENGTH`).
+     */
+    GuessKernel(const std::uint8_t* guessLanes, int exprLength) {
+        std::uint8_t paddedLanes[16];
+        std::memset(paddedLanes, 0xFE, sizeof(paddedLanes));  // Never equal to the answer padding
+        std::memcpy(paddedLanes, guessLanes, exprLength);
+        std::memcpy(laneWords, paddedLanes, sizeof(paddedLanes));
+
+        std::uint32_t positionMasksList[SymbolHistogram::LANE_COUNT] = {};
+        for (int position = 0; position < exprLength; ++position)
+            positionMasksList[guessLanes[position]] |= 1u << position;
+
+        for (int lane = 0; lane < SymbolHistogram::LANE_COUNT; ++lane) {
+            const std::uint32_t positionMask = positionMasksList[lane];
+            if (positionMask == 0) continue;
+            if (std::has_single_bit(positionMask)) {
+                singleShiftsList[singleCount] = static_cast<std::uint8_t>(lane * SymbolHistogram::LANE_BITS);
+                singleBitsList[singleCount] = positionMask;
+                ++singleCount;
+            }
+            else {
+                repeatedShiftsList[repeatedCount] = static_cast<std::uint8_t>(lane * SymbolHistogram::LANE_BITS);
+                repeatedMasksList[repeatedCount] = positionMask;
+                ++repeatedCount;
+            }
+        }
+    }
+
+    /**
+     * @brief Feedback code of the guess against one answer.
+     */
+    Code compute(const PackedAnswer& answer) const {
+        const std::uint32_t greenMask =
+            zeroBytesMask(laneWords[0] ^ answer.laneWords[0]) | (zeroBytesMask(laneWords[1] ^ answer.laneWords[1]) << 8);
+        std::uint32_t yellowMask = 0;
+
+        // Symbols used once: present in the answer => yellow (unless green)
+        for (int i = 0; i < singleCount; ++i) {
+            std::uint32_t isPresent = static_cast<std::uint32_t>(((answer.histogram >> singleShiftsList[i]) & 0xF) + 0xF) >> 4;
+            yellowMask |= singleBitsList[i] & (0u - isPresent);
+        }
+        yellowMask &= ~greenMask;
+
+        // Symbols used several times: hand out the unmatched answer occurrences left to right
+        for (int i = 0; i < repeatedCount; ++i) {
+            const std::uint32_t positionMask = repeatedMasksList[i];
+            int availableCount = static_cast<int>((answer.histogram >> repeatedShiftsList[i]) & 0xF);
+            // Same trip count as below; avoids a library popcount call on targets without POPCNT
+            for (std::uint32_t remainingMask = positionMask; remainingMask != 0; remainingMask &= remainingMask - 1)
+                availableCount -= static_cast<int>((greenMask & remainingMask & (0u - remainingMask)) != 0);
+
+            int nonGreenRank = 0;
+            for (std::uint32_t remainingMask = positionMask; remainingMask != 0; remainingMask &= remainingMask - 1) {
+                std::uint32_t positionBit = remainingMask & (0u - remainingMask);
+                std::uint32_t isNonGreen = (greenMask & positionBit) == 0;
+                std::uint32_t isYellow = isNonGreen & static_cast<std::uint32_t>(nonGreenRank < availableCount);
+                yellowMask |= positionBit & (0u - isYellow);
+                nonGreenRank += static_cast<int>(isNonGreen);
+            }
+        }
+
+        return maskToBase3(greenMask) * DIGIT_GREEN + maskToBase3(yellowMask) * DIGIT_YELLOW;
+    }
+
+private:
+    std::uint64_t laneWords[2] = {};  ///< Lane indices, one per byte, padded with 0xFE
+    int singleCount = 0;              ///< Symbols used exactly once
+    int repeatedCount = 0;            ///< Symbols used more than once
+    std::uint8_t singleShiftsList[SymbolHistogram::LANE_COUNT] = {};      ///< Histogram shift of each single symbol
+    std::uint32_t singleBitsList[SymbolHistogram::LANE_COUNT] = {};       ///< Position bit of each single symbol
+    std::uint8_t repeatedShiftsList[SymbolHistogram::LANE_COUNT] = {};    ///< Histogram shift of each repeated symbol
+    std::uint32_t repeatedMasksList[SymbolHistogram::LANE_COUNT] = {};    ///< Positions of each repeated symbol
+};
+
+}  // namespace (end of FeedbackCode)
@@ -0,0 +1,210 @@
+/* ----- ----- ----- ----- */
+// FeedbackMatrix.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#include "FeedbackMatrix.h"
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+#include "OpeningBook.h"
+#include "core/logging/AppLogger.h"
+#include "util/ParallelUtils.h"
+
+namespace {
+
+constexpr std::string_view MATRIX_MAGIC = "MEFM";  ///< File signature
+constexpr std::uint32_t MATRIX_VERSION = 1;        ///< Bumped on layout changes
+constexpr size_t ROWS_PER_BATCH = 256;             ///< Rows computed in parallel between two writes
+constexpr size_t MIN_ROWS_PER_WORKER = 16;         ///< Below this, threads cost more than they save
+
+static_assert(std::endian::native == std::endian::little, "Matrix codes are stored in host order");
+
+/**
+ * @brief FNV-1a hash of every expression of a pool, in handle order.
+ */
+std::uint64_t getFingerprint(const CandidatePool& universePool) {
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t handle = 0; handle < universePool.size(); ++handle) {
+        for (char symbol : universePool.view(static_cast<CandidateHandle>(handle))) {
+            hash ^= static_cast<unsigned char>(symbol);
+            hash *= 0x100000001B3ull;
+        }
+    }
+    return hash;
+}
+
+/**
+ * @brief Fills the fixed-size file header.
+ */
+void writeHeader(unsigned char* header, int exprLength, std::uint8_t operatorMask, int codeBytes,
+                 std::uint32_t expressionCount, std::uint64_t fingerprint) {
+    std::memset(header, 0, FeedbackMatrix::HEADER_BYTES);
+    std::memcpy(header, MATRIX_MAGIC.data(), MATRIX_MAGIC.size());
+    std::memcpy(header + 4, &MATRIX_VERSION, sizeof(MATRIX_VERSION));
+    header[8] = static_cast<unsigned char>(exprLength);
+    header[9] = operatorMask;
+    header[10] = static_cast<unsigned char>(codeBytes);
+    std::memcpy(header + 12, &expressionCount, sizeof(expressionCount));
+    std::memcpy(header + 16, &fingerprint, sizeof(fingerprint));
+}
+
+}  // namespace (end of anonymous)
+
+/**
+ * @brief File name used for a configuration.
+ *
+ * @param exprLength Expression length.
+ * @param operatorsSet Allowed operators.
+ * @return std::string `"feedback_<length>_<operator mask>.bin"`.
+ */
+std::string FeedbackMatrix::getFileName(int exprLength, const std::unordered_set<char>& operatorsSet) {
+    return std::format("feedback_{}_{}.bin", exprLength, OpeningBook::getOperatorMask(operatorsSet));
+}
+
+/**
+ * @brief Computes the matrix of a universe and writes it to a file.
+ *
+ * <summary>
+ * Rows are computed in parallel batches of `ROWS_PER_BATCH` and appended in order, so
+ * memory stays at one batch whatever the universe size. The file is written under a
+ * temporary name and renamed at the end: another process never maps a partial matrix.
+ * </summary>
+ *
+ * @param filePath Output file.
+ * @param universePool Every expression of the configuration.
+ * @param operatorsSet Operators the universe was built for.
+ * @return true if the file was written.
+ */
+bool FeedbackMatrix::build(const std::string& filePath, const CandidatePool& universePool, const std::unordered_set<char>& operatorsSet) {
+    const int exprLength = universePool.getExprLength();
+    const size_t expressionCount = universePool.size();
+    if (exprLength > FeedbackCode::MAX_LENGTH || expressionCount == 0) return false;
+
+    const std::filesystem::path outputPath(filePath);
+    std::error_code errorCode;
+    if (outputPath.has_parent_path())
+        std::filesystem::create_directories(outputPath.parent_path(), errorCode);
+    const std::filesystem::path temporaryPath = outputPath.string() + ".tmp";
+    std::ofstream ofs(temporaryPath, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+        AppLogger::Error(std::format("Failed to write feedback matrix: {}", filePath));
+        return false;
+    }
+
+    const int codeBytes = getCodeBytes(exprLength);
+    unsigned char header[HEADER_BYTES];
+    writeHeader(header, exprLength, OpeningBook::getOperatorMask(operatorsSet), codeBytes,
+        static_cast<std::uint32_t>(expressionCount), getFingerprint(universePool));
+    ofs.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    // Every expression once as lanes (guesses) and packed (answers)
+    std::vector<std::uint8_t> lanesList(expressionCount * static_cast<size_t>(exprLength));
+    for (size_t handle = 0; handle < expressionCount; ++handle)
+        FeedbackCode::toLanes(universePool.view(static_cast<CandidateHandle>(handle)), lanesList.data() + handle * exprLength);
+    const bool isPacked = (exprLength <= FeedbackCode::MAX_PACKED_LENGTH);
+    std::vector<FeedbackCode::PackedAnswer> packedAnswersList;
+    if (isPacked) {
+        packedAnswersList.reserve(expressionCount);
+        for (size_t handle = 0; handle < expressionCount; ++handle)
+            packedAnswersList.emplace_back(lanesList.data() + handle * exprLength, exprLength);
+    }
+
+    std::vector<FeedbackCode::Code> batchCodesList(ROWS_PER_BATCH * expressionCount);
+    std::vector<std::uint16_t> narrowCodesList(codeBytes == 2 ? batchCodesList.size() : 0);
+    for (size_t batchBegin = 0; batchBegin < expressionCount; batchBegin += ROWS_PER_BATCH) {
+        const size_t batchRows = (std::min)(ROWS_PER_BATCH, expressionCount - batchBegin);
+        const size_t workerCount = ParallelUtils::getWorkerCount(batchRows, MIN_ROWS_PER_WORKER);
+        ParallelUtils::runChunks(ParallelUtils::splitRanges(batchRows, workerCount),
+            [&](size_t, const ParallelUtils::ChunkRange& range) {
+                for (size_t row = range.begin; row < range.end; ++row) {
+                    const std::uint8_t* guessLanes = lanesList.data() + (batchBegin + row) * exprLength;
+                    FeedbackCode::Code* rowCodes = batchCodesList.data() + row * expressionCount;
+                    if (isPacked) {
+                        const FeedbackCode::GuessKernel guessKernel(guessLanes, exprLength);
+                        for (size_t answer = 0; answer < expressionCount; ++answer)
+                            rowCodes[answer] = guessKernel.compute(packedAnswersList[answer]);
+                    } else {
+                        for (size_t answer = 0; answer < expressionCount; ++answer)
+                            rowCodes[answer] = FeedbackCode::compute(guessLanes, lanesList.data() + answer * exprLength, exprLength);
+                    }
+                }
+            });
+
+        const size_t batchCodeCount = batchRows * expressionCount;
+        if (codeBytes == 2) {
+            for (size_t i = 0; i < batchCodeCount; ++i)
+                narrowCodesList[i] = static_cast<std::uint16_t>(batchCodesList[i]);
+            ofs.write(reinterpret_cast<const char*>(narrowCodesList.data()), static_cast<std::streamsize>(batchCodeCount * 2));
+        } else {
+            ofs.write(reinterpret_cast<const char*>(batchCodesList.data()), static_cast<std::streamsize>(batchCodeCount * 4));
+        }
+    }
+
+    ofs.close();
+    if (!ofs) {
+        AppLogger::Error(std::format("Failed to write feedback matrix: {}", filePath));
+        std::filesystem::remove(temporaryPath, errorCode);
+        return false;
+    }
+    std::filesystem::rename(temporaryPath, outputPath, errorCode);
+    if (errorCode) {
+        AppLogger::Error(std::format("Failed to write feedback matrix: {} ({})", filePath, errorCode.message()));
+        std::filesystem::remove(temporaryPath, errorCode);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Maps a matrix file built for exactly this universe.
+ *
+ * <summary>
+ * A missing file is not an error (the caller builds it); a file for another universe or
+ * with a wrong size is reported and left unmapped.
+ * </summary>
+ *
+ * @param filePath Matrix file.
+ * @param universePool Universe the matrix must describe.
+ * @param operatorsSet Operators the universe was built for.
+ * @return true if the file matches and was mapped.
+ */
+bool FeedbackMatrix::open(const std::string& filePath, const CandidatePool& universePool, const std::unordered_set<char>& operatorsSet) {
+    close();
+    if (!mappedFile.open(filePath)) return false;
+
+    const int exprLength = universePool.getExprLength();
+    unsigned char expectedHeader[HEADER_BYTES];
+    writeHeader(expectedHeader, exprLength, OpeningBook::getOperatorMask(operatorsSet), getCodeBytes(exprLength),
+        static_cast<std::uint32_t>(universePool.size()), getFingerprint(universePool));
+    if (mappedFile.size() != getFileBytes(universePool.size(), exprLength)
+        || std::memcmp(mappedFile.data(), expectedHeader, HEADER_BYTES) != 0) {
+        AppLogger::Error(std::format("Feedback matrix {} ignored: built for another universe.", filePath));
+        mappedFile.close();
+        return false;
+    }
+
+    codesData = mappedFile.data() + HEADER_BYTES;
+    expressionCount = universePool.size();
+    codeBytes = getCodeBytes(exprLength);
+    return true;
+}
+
+/**
+ * @brief Unmaps the matrix.
+ */
+void FeedbackMatrix::close() {
+    mappedFile.close();
+    codesData = nullptr;
+    expressionCount = 0;
+    codeBytes = 0;
+}
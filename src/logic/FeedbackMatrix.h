@@ -0,0 +1,129 @@
+/* ----- ----- ----- ----- */
+// FeedbackMatrix.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+
+#include "CandidatePool.h"
+#include "FeedbackCode.h"
+#include "util/MappedFile.h"
+
+/**
+ * @class FeedbackMatrix
+ * @brief Feedback code of every guess against every answer of a universe, stored in a memory-mapped file.
+ *
+ * <summary>
+ * Row `g` holds `FeedbackCode::compute(g, a)` for every expression `a` of the universe, in
+ * handle order. Codes take 2 bytes up to length 10 (3^10 < 65536) and 4 bytes above, so
+ * the file has `HEADER_BYTES + n * n * getCodeBytes(length)` bytes for `n` expressions.
+ *
+ * The file is written once (`build`) and then mapped read-only (`open`), so several solver
+ * processes share the same pages. It is only valid for the exact universe it was built from:
+ * the header stores the length, the operator mask, the expression count and a fingerprint
+ * of the expressions in handle order, and `open` rejects any mismatch.
+ *
+ * File layout (little endian):
+ *     "MEFM" | version u32 | length u8 | operator mask u8 | code bytes u8 | 0 u8
+ *     | expression count u32 | fingerprint u64 | 0 u64 | codes (row-major)
+ * </summary>
+ */
+class FeedbackMatrix {
+public:
+    static constexpr size_t HEADER_BYTES = 32;  ///< Header size; keeps the codes aligned
+
+    FeedbackMatrix() = default;
+
+    /**
+     * @brief Bytes per code for an expression length (2 or 4).
+     */
+    static constexpr int getCodeBytes(int exprLength) {
+        return FeedbackCode::getCodeCount(exprLength) <= 0x10000 ? 2 : 4;
+    }
+
+    /**
+     * @brief Size of the matrix file for a universe.
+     */
+    static std::uint64_t getFileBytes(size_t expressionCount, int exprLength) {
+        return HEADER_BYTES + static_cast<std::uint64_t>(expressionCount) * expressionCount * getCodeBytes(exprLength);
+    }
+
+    /**
+     * @brief File name used for a configuration (e.g., `"feedback_8_15.bin"`).
+     */
+    static std::string getFileName(int exprLength, const std::unordered_set<char>& operatorsSet);
+
+    /**
+     * @brief Computes the matrix of a universe and writes it to a file.
+     *
+     * @param filePath Output file (written under a temporary name, then renamed).
+     * @param universePool Every expression of the configuration.
+     * @param operatorsSet Operators the universe was built for.
+     * @return true if the file was written.
+     */
+    static bool build(const std::string& filePath, const CandidatePool& universePool, const std::unordered_set<char>& operatorsSet);
+
+    /**
+     * @brief Maps a matrix file built for exactly this universe.
+     *
+     * @param filePath Matrix file.
+     * @param universePool Universe the matrix must describe.
+     * @param operatorsSet Operators the universe was built for.
+     * @return true if the file matches and was mapped.
+     */
+    bool open(const std::string& filePath, const CandidatePool& universePool, const std::unordered_set<char>& operatorsSet);
+
+    /**
+     * @brief Unmaps the matrix.
+     */
+    void close();
+
+    /**
+     * @brief True if a matrix is mapped.
+     */
+    bool isOpen() const { return codesData != nullptr; }
+
+    /**
+     * @brief Bytes per code of the mapped matrix (2 or 4).
+     */
+    int getCodeBytes() const { return codeBytes; }
+
+    /**
+     * @brief Codes of one guess against every answer, when codes take 2 bytes.
+     */
+    const std::uint16_t* getRow16(CandidateHandle guessHandle) const {
+        return reinterpret_cast<const std::uint16_t*>(codesData) + static_cast<size_t>(guessHandle) * expressionCount;
+    }
+
+    /**
+     * @brief Codes of one guess against every answer, when codes take 4 bytes.
+     */
+    const std::uint32_t* getRow32(CandidateHandle guessHandle) const {
+        return reinterpret_cast<const std::uint32_t*>(codesData) + static_cast<size_t>(guessHandle) * expressionCount;
+    }
+
+    /**
+     * @brief Code of one guess against one answer.
+     */
+    FeedbackCode::Code get(CandidateHandle guessHandle, CandidateHandle answerHandle) const {
+        return codeBytes == 2 ? getRow16(guessHandle)[answerHandle] : getRow32(guessHandle)[answerHandle];
+    }
+
+    /**
+     * @brief Number of expressions (rows and columns).
+     */
+    size_t size() const { return expressionCount; }
+
+private:
+    MappedFile mappedFile;                      ///< Mapped matrix file
+    const unsigned char* codesData = nullptr;   ///< First code (after the header)
+    size_t expressionCount = 0;                 ///< Rows and columns
+    int codeBytes = 0;                          ///< Bytes per code
+};
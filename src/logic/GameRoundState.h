@@ -3,15 +3,18 @@
 // Do not distribute or modify
 // Author: DragonTaki (https://github.com/DragonTaki)
 // Create Date: 2025/10/18
-// Update Date: 2025/10/18
-// Version: v1.0
+// Update Date: 2026/10/16
+// Version: v1.3
 /* ----- ----- ----- ----- */
 
 #pragma once
 #include <unordered_set>
 #include <vector>
 
+#include "CandidatePool.h"
+#include "CandidateTrie.h"
 #include "RoundRecord.h"
+#include "SurvivorSet.h"
 
 /**
  * @struct GameRoundState
@@ -28,8 +31,10 @@
 struct GameRoundState {
     int exprLength = 0;                              ///< The required expression length for this game session
     std::unordered_set<char> operatorsSet;           ///< Avaliable operator(s) for this game
-    std::vector<std::string> initialCandidatesList;  ///< Candidate lists after first guess
+    CandidatePool candidatePool;                     ///< Interned candidates after first guess (shared by every round)
+    CandidateTrie candidateTrie;                     ///< Prefix trie over `candidatePool` (empty unless enabled in `SolverOptions`)
     std::vector<RoundRecord> roundHistory;           ///< Player-guessed expressions and game-feedback colors for each round
+    std::vector<SurvivorSet> survivorsHistory;       ///< Survivors after each round of `roundHistory` (undo stack)
     
     /**
      * @brief Clears all round-related data while keeping the configuration (expression length and operators).
@@ -38,11 +43,13 @@ struct GameRoundState {
      * It preserves the expression length and operator set, allowing re-use of the same configuration
      * without having to fully reinitialize the game.
      *
-     * @note The `initialCandidatesList` and `roundHistory` are both cleared.
+     * @note The `candidatePool`, `candidateTrie`, `roundHistory` and `survivorsHistory` are all cleared.
      */
     void resetRoundData() {
-        initialCandidatesList.clear();
+        candidatePool.clear();
+        candidateTrie = CandidateTrie();
         roundHistory.clear();
+        survivorsHistory.clear();
     }
 
     /**
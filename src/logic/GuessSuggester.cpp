@@ -0,0 +1,1003 @@
+/* ----- ----- ----- ----- */
+// GuessSuggester.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/17
+// Version: v1.2
+/* ----- ----- ----- ----- */
+
+#include "GuessSuggester.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+#include "FeedbackCode.h"
+#include "FeedbackMatrix.h"
+#include "GuessUniverse.h"
+#include "SymbolHistogram.h"
+#include "util/ParallelUtils.h"
+
+namespace {
+
+constexpr size_t MIN_GUESSES_PER_WORKER = 8;                  ///< Each guess already costs one pass over every survivor
+constexpr std::uint64_t MAX_DENSE_CODE_COUNT = 1ull << 20;  ///< Up to 3^12 codes, a dense counter array is used
+constexpr double PRUNE_SLACK = 1e-9;                         ///< Entropy costs are summed in a different order mid-pass
+constexpr size_t GUESS_BLOCK_SIZE = 256;                     ///< Guesses claimed by a worker at a time
+constexpr size_t INITIAL_SAMPLE_SIZE = 512;                  ///< Answers of the first anytime stage
+constexpr size_t SAMPLE_GROWTH = 4;                          ///< Sample growth (and guess shrink) per anytime stage
+constexpr size_t MIN_KEPT_GUESSES = 64;                      ///< Guesses always carried to the next anytime stage
+constexpr size_t SAMPLED_ANSWER_COUNT = 4096;                ///< Survivors of a sampled pre-ranking
+constexpr size_t SAMPLED_KEPT_GUESSES = 256;                 ///< Best sampled guesses given a confidence interval
+constexpr size_t MAX_CONTENDER_COUNT = 64;                   ///< Most guesses rescored on every survivor
+constexpr double CONTENTION_Z = 2.576;                       ///< Two-sided 99% normal quantile of the intervals
+
+/**
+ * @class FeedbackHistogram
+ * @brief Per-worker counter of feedback codes for one guess, reused across guesses.
+ *
+ * <summary>
+ * Short expressions have few enough codes (3^length) for a dense counter array. Longer
+ * expressions count codes in an open-addressing table sized for the survivors. Either
+ * way only the touched entries are visited and reset afterwards, so the cost follows the
+ * number of survivors, and `add` returns the running bucket size for early exits.
+ * </summary>
+ */
+class FeedbackHistogram {
+public:
+    FeedbackHistogram(std::uint64_t codeCount, size_t answerCount) : isDense(codeCount <= MAX_DENSE_CODE_COUNT) {
+        if (isDense) {
+            countsList.assign(static_cast<size_t>(codeCount), 0);
+            return;
+        }
+        // At least twice the most distinct codes one guess can produce, as a power of two
+        size_t capacity = 16;
+        hashShift = 28;
+        while (capacity < 2 * (std::min)(static_cast<std::uint64_t>(answerCount), codeCount)) {
+            capacity <<= 1;
+            --hashShift;
+        }
+        countsList.assign(capacity, 0);
+        keysList.assign(capacity, EMPTY_KEY);
+    }
+
+    /**
+     * @brief Counts one survivor producing `code`.
+     * @return std::uint32_t Size of that bucket after the survivor was added.
+     */
+    std::uint32_t add(FeedbackCode::Code code) {
+        if (isDense) {
+            if (countsList[code] == 0) touchedSlotsList.push_back(code);
+            return ++countsList[code];
+        }
+        const size_t slotMask = keysList.size() - 1;
+        for (size_t slot = static_cast<std::uint32_t>(code * 0x9E3779B1u) >> hashShift;; slot = (slot + 1) & slotMask) {
+            if (keysList[slot] == code) return ++countsList[slot];
+            if (keysList[slot] == EMPTY_KEY) {
+                keysList[slot] = code;
+                touchedSlotsList.push_back(static_cast<std::uint32_t>(slot));
+                return countsList[slot] = 1;
+            }
+        }
+    }
+
+    /**
+     * @brief Calls `bucketFunc(count)` for every non-empty bucket, then empties the histogram.
+     */
+    template <typename BucketFunc>
+    void drainBuckets(BucketFunc&& bucketFunc) {
+        for (std::uint32_t slot : touchedSlotsList)
+            bucketFunc(static_cast<size_t>(countsList[slot]));
+        clear();
+    }
+
+    /**
+     * @brief Empties the histogram without visiting the buckets (abandoned guess).
+     */
+    void clear() {
+        for (std::uint32_t slot : touchedSlotsList) {
+            countsList[slot] = 0;
+            if (!isDense) keysList[slot] = EMPTY_KEY;
+        }
+        touchedSlotsList.clear();
+    }
+
+private:
+    static constexpr FeedbackCode::Code EMPTY_KEY = 0xFFFFFFFFu;  ///< Above every code (3^20 < 2^32 - 1)
+
+    bool isDense;                                  ///< Dense counters or hashed codes
+    int hashShift = 0;                             ///< Hashed: 32 - log2(table size)
+    std::vector<std::uint32_t> countsList;         ///< Survivors per code (dense) or per slot (hashed)
+    std::vector<FeedbackCode::Code> keysList;      ///< Hashed: code held by each slot
+    std::vector<std::uint32_t> touchedSlotsList;   ///< Codes (dense) or slots (hashed) seen at least once
+};
+
+/**
+ * @struct RankedGuess
+ * @brief A fully scored guess and its policy cost (lower is better).
+ */
+struct RankedGuess {
+    GuessScore guessScore;  ///< Reported score
+    double cost = 0.0;      ///< Policy cost used for ranking and pruning
+};
+
+/**
+ * @class ScoringPass
+ * @brief Answers, guesses and tables shared by every worker of one `suggest` call.
+ *
+ * <summary>
+ * Each policy is expressed as a cost that never decreases while survivors are added to
+ * a guess's histogram (`bucketSize` is the size of the bucket that just grew):
+ * - Entropy: sum n_k * log2(n_k), grows by `bucketLogDeltasList[bucketSize]`.
+ * - Minimax: max n_k.
+ * - ExpectedSize: sum n_k^2, grows by 2 * bucketSize - 1.
+ * - WinChance: like ExpectedSize, plus `N^2 + 1` when the guess cannot be the answer, so
+ *   every possible answer ranks first.
+ * A worker keeps the costs of its `topCount` best guesses; once a partial cost is above
+ * the worst of them, the rest of the pass cannot help and the guess is dropped.
+ *
+ * Guesses are handed out to the workers in blocks of `GUESS_BLOCK_SIZE`: how long a
+ * guess takes depends on how early it is pruned, so fixed per-worker ranges would leave
+ * some workers idle on large guess pools.
+ * </summary>
+ */
+struct ScoringPass {
+    int exprLength = 0;                                         ///< Length of every expression
+    bool isPacked = false;                                      ///< `GuessKernel` or reference kernel
+    size_t answerCount = 0;                                     ///< Number of survivors
+    std::vector<FeedbackCode::PackedAnswer> packedAnswersList;  ///< Packed answers
+    std::vector<std::uint8_t> answerLanesList;                  ///< Answer lanes (reference kernel)
+    std::vector<double> weightedLogsList;                       ///< n * log2(n) for every bucket size
+    std::vector<double> bucketLogDeltasList;                    ///< n * log2(n) - (n - 1) * log2(n - 1)
+
+    const std::uint8_t* guessLanesData = nullptr;  ///< Lane form of the pool the guesses come from
+    std::vector<CandidateHandle> guessHandlesList;  ///< Guesses to score
+    std::vector<std::uint8_t> possibleAnswerFlags;  ///< 1 for every guess (by index) that is a survivor
+    const FeedbackMatrix* feedbackMatrix = nullptr; ///< Precomputed codes of the guess pool, if every answer is in it
+    std::vector<CandidateHandle> answerColumnsList; ///< Column of every answer in `feedbackMatrix`
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();  ///< Blocks claimed later are skipped
+    mutable std::atomic<bool> isExpired{false};     ///< True once a block was skipped for the deadline
+    mutable std::atomic<size_t> scoredGuessCount{0}; ///< Guesses scored by the last `rank` (less than all if expired)
+    size_t topCount = 0;                            ///< Guesses kept per worker
+
+    /**
+     * @brief Packs the answers once for the whole pass and fills the log tables.
+     *
+     * @param answerLanesData Lane form of the pool the answers come from.
+     * @param answerHandlesList Survivors, in handle order.
+     */
+    void prepareAnswers(const std::uint8_t* answerLanesData, const std::vector<CandidateHandle>& answerHandlesList) {
+        answerCount = answerHandlesList.size();
+        isPacked = (exprLength <= FeedbackCode::MAX_PACKED_LENGTH);
+        if (isPacked) {
+            packedAnswersList.reserve(answerCount);
+            for (CandidateHandle answerHandle : answerHandlesList)
+                packedAnswersList.emplace_back(answerLanesData + static_cast<size_t>(answerHandle) * exprLength, exprLength);
+        }
+        else {
+            answerLanesList.resize(answerCount * static_cast<size_t>(exprLength));
+            for (size_t i = 0; i < answerCount; ++i)
+                std::copy_n(answerLanesData + static_cast<size_t>(answerHandlesList[i]) * exprLength, exprLength,
+                    answerLanesList.data() + i * exprLength);
+        }
+
+        weightedLogsList.assign(answerCount + 1, 0.0);
+        bucketLogDeltasList.assign(answerCount + 1, 0.0);
+        for (size_t count = 2; count <= answerCount; ++count) {
+            weightedLogsList[count] = static_cast<double>(count) * std::log2(static_cast<double>(count));
+            bucketLogDeltasList[count] = weightedLogsList[count] - weightedLogsList[count - 1];
+        }
+    }
+
+    /**
+     * @brief Scores the guesses `[range.begin, range.end)` under one policy.
+     *
+     * @param range Guess indices of one block.
+     * @param histogram Histogram of the calling worker.
+     * @param keptCostsQueue Costs of the worker's best guesses so far (worst on top).
+     * @param[out] rankedGuessesList Guesses scored to the end (pruned guesses are left out).
+     */
+    template <ScoringPolicy Policy>
+    void scoreRange(
+        const ParallelUtils::ChunkRange& range,
+        FeedbackHistogram& histogram,
+        std::priority_queue<double>& keptCostsQueue,
+        std::vector<RankedGuess>& rankedGuessesList
+    ) const {
+        const double answerTotal = static_cast<double>(answerCount);
+        const double answerLog = std::log2(answerTotal);
+        const double missPenalty = answerTotal * answerTotal + 1.0;
+
+        for (size_t guessIndex = range.begin; guessIndex < range.end; ++guessIndex) {
+            const CandidateHandle guessHandle = guessHandlesList[guessIndex];
+            const std::uint8_t* guessLanes = guessLanesData + static_cast<size_t>(guessHandle) * exprLength;
+            const bool isPossibleAnswer = (possibleAnswerFlags[guessIndex] != 0);
+            const double costLimit = (keptCostsQueue.size() < topCount)
+                ? std::numeric_limits<double>::infinity()
+                : keptCostsQueue.top() + PRUNE_SLACK;
+
+            double partialCost = (Policy == ScoringPolicy::WinChance && !isPossibleAnswer) ? missPenalty : 0.0;
+            auto addCode = [&](FeedbackCode::Code code) {
+                const std::uint32_t bucketSize = histogram.add(code);
+                if constexpr (Policy == ScoringPolicy::Entropy)
+                    partialCost += bucketLogDeltasList[bucketSize];
+                else if constexpr (Policy == ScoringPolicy::Minimax)
+                    partialCost = (std::max)(partialCost, static_cast<double>(bucketSize));
+                else
+                    partialCost += static_cast<double>(2 * bucketSize - 1);
+                return partialCost <= costLimit;
+            };
+
+            bool isComplete = (partialCost <= costLimit);
+            if (isComplete && feedbackMatrix && feedbackMatrix->getCodeBytes() == 2) {
+                const std::uint16_t* guessCodes = feedbackMatrix->getRow16(guessHandle);
+                for (CandidateHandle answerColumn : answerColumnsList) {
+                    if (!addCode(guessCodes[answerColumn])) { isComplete = false; break; }
+                }
+            }
+            else if (isComplete && feedbackMatrix) {
+                const std::uint32_t* guessCodes = feedbackMatrix->getRow32(guessHandle);
+                for (CandidateHandle answerColumn : answerColumnsList) {
+                    if (!addCode(guessCodes[answerColumn])) { isComplete = false; break; }
+                }
+            }
+            else if (isComplete && isPacked) {
+                const FeedbackCode::GuessKernel guessKernel(guessLanes, exprLength);
+                for (const FeedbackCode::PackedAnswer& packedAnswer : packedAnswersList) {
+                    if (!addCode(guessKernel.compute(packedAnswer))) { isComplete = false; break; }
+                }
+            }
+            else if (isComplete) {
+                const std::uint8_t* answerLanes = answerLanesList.data();
+                for (size_t i = 0; i < answerCount; ++i, answerLanes += exprLength) {
+                    if (!addCode(FeedbackCode::compute(guessLanes, answerLanes, exprLength))) { isComplete = false; break; }
+                }
+            }
+            if (!isComplete) {
+                histogram.clear();
+                continue;
+            }
+
+            // Every statistic comes from the same buckets, whatever the policy
+            RankedGuess rankedGuess;
+            GuessScore& guessScore = rankedGuess.guessScore;
+            guessScore.handle = guessHandle;
+            guessScore.isPossibleAnswer = isPossibleAnswer;
+
+            double weightedLogSum = 0.0;
+            double squareSum = 0.0;
+            histogram.drainBuckets([&](size_t bucketSize) {
+                weightedLogSum += weightedLogsList[bucketSize];
+                squareSum += static_cast<double>(bucketSize) * static_cast<double>(bucketSize);
+                ++guessScore.bucketCount;
+                guessScore.largestBucket = (std::max)(guessScore.largestBucket, bucketSize);
+            });
+            guessScore.entropyBits = answerLog - weightedLogSum / answerTotal;
+            guessScore.expectedSize = squareSum / answerTotal;
+            guessScore.winChance = isPossibleAnswer ? 1.0 / answerTotal : 0.0;
+
+            switch (Policy) {
+                case ScoringPolicy::Entropy:
+                    rankedGuess.cost = weightedLogSum;
+                    guessScore.score = guessScore.entropyBits;
+                    break;
+                case ScoringPolicy::Minimax:
+                    rankedGuess.cost = static_cast<double>(guessScore.largestBucket);
+                    guessScore.score = rankedGuess.cost;
+                    break;
+                case ScoringPolicy::ExpectedSize:
+                    rankedGuess.cost = squareSum;
+                    guessScore.score = guessScore.expectedSize;
+                    break;
+                case ScoringPolicy::WinChance:
+                    rankedGuess.cost = squareSum + (isPossibleAnswer ? 0.0 : missPenalty);
+                    guessScore.score = guessScore.winChance;
+                    break;
+            }
+
+            keptCostsQueue.push(rankedGuess.cost);
+            if (keptCostsQueue.size() > topCount) keptCostsQueue.pop();
+            rankedGuessesList.push_back(rankedGuess);
+        }
+    }
+
+    /**
+     * @brief Scores every guess on worker threads and returns the `topCount` best.
+     *
+     * <summary>
+     * Ties: fewer survivors left on average, then possible answers first, then handle order.
+     * </summary>
+     *
+     * @param scoringPolicy How guesses are ranked.
+     * @return std::vector<GuessScore> Best guesses, best first.
+     */
+    std::vector<GuessScore> rank(ScoringPolicy scoringPolicy) const {
+        const size_t workerCount = ParallelUtils::getWorkerCount(guessHandlesList.size(), MIN_GUESSES_PER_WORKER);
+        std::vector<std::vector<RankedGuess>> workerGuessesList(workerCount);
+        std::vector<FeedbackHistogram> histogramsList;
+        std::vector<std::priority_queue<double>> keptCostsList(workerCount);
+        for (size_t i = 0; i < workerCount; ++i)
+            histogramsList.emplace_back(FeedbackCode::getCodeCount(exprLength), answerCount);
+
+        ParallelUtils::runBlocks(guessHandlesList.size(), GUESS_BLOCK_SIZE, workerCount,
+            [&](size_t workerIndex, const ParallelUtils::ChunkRange& block) {
+                if (block.begin > 0 && std::chrono::steady_clock::now() >= deadline) {  // The first block always runs
+                    isExpired.store(true, std::memory_order_relaxed);
+                    return;
+                }
+                FeedbackHistogram& histogram = histogramsList[workerIndex];
+                std::priority_queue<double>& keptCostsQueue = keptCostsList[workerIndex];
+                std::vector<RankedGuess>& rankedGuessesList = workerGuessesList[workerIndex];
+                switch (scoringPolicy) {
+                    case ScoringPolicy::Entropy:
+                        scoreRange<ScoringPolicy::Entropy>(block, histogram, keptCostsQueue, rankedGuessesList); break;
+                    case ScoringPolicy::Minimax:
+                        scoreRange<ScoringPolicy::Minimax>(block, histogram, keptCostsQueue, rankedGuessesList); break;
+                    case ScoringPolicy::ExpectedSize:
+                        scoreRange<ScoringPolicy::ExpectedSize>(block, histogram, keptCostsQueue, rankedGuessesList); break;
+                    case ScoringPolicy::WinChance:
+                        scoreRange<ScoringPolicy::WinChance>(block, histogram, keptCostsQueue, rankedGuessesList); break;
+                }
+                scoredGuessCount.fetch_add(block.end - block.begin, std::memory_order_relaxed);
+            });
+
+        std::vector<RankedGuess> rankedGuessesList;
+        for (std::vector<RankedGuess>& workerGuesses : workerGuessesList)
+            rankedGuessesList.insert(rankedGuessesList.end(), workerGuesses.begin(), workerGuesses.end());
+
+        auto isBetter = [](const RankedGuess& lhs, const RankedGuess& rhs) {
+            if (lhs.cost != rhs.cost) return lhs.cost < rhs.cost;
+            if (lhs.guessScore.expectedSize != rhs.guessScore.expectedSize)
+                return lhs.guessScore.expectedSize < rhs.guessScore.expectedSize;
+            if (lhs.guessScore.isPossibleAnswer != rhs.guessScore.isPossibleAnswer) return lhs.guessScore.isPossibleAnswer;
+            return lhs.guessScore.handle < rhs.guessScore.handle;
+        };
+        const size_t keptCount = (std::min)(topCount, rankedGuessesList.size());
+        std::partial_sort(rankedGuessesList.begin(), rankedGuessesList.begin() + keptCount, rankedGuessesList.end(), isBetter);
+
+        std::vector<GuessScore> guessScoresList;
+        guessScoresList.reserve(keptCount);
+        for (size_t i = 0; i < keptCount; ++i)
+            guessScoresList.push_back(rankedGuessesList[i].guessScore);
+        return guessScoresList;
+    }
+
+    /**
+     * @brief Feedback of one guess against every answer of the pass, sorted.
+     */
+    std::vector<FeedbackCode::Code> collectSortedCodes(CandidateHandle guessHandle) const {
+        std::vector<FeedbackCode::Code> codesList;
+        codesList.reserve(answerCount);
+        const std::uint8_t* guessLanes = guessLanesData + static_cast<size_t>(guessHandle) * exprLength;
+        if (feedbackMatrix) {
+            for (CandidateHandle answerColumn : answerColumnsList)
+                codesList.push_back(feedbackMatrix->get(guessHandle, answerColumn));
+        }
+        else if (isPacked) {
+            const FeedbackCode::GuessKernel guessKernel(guessLanes, exprLength);
+            for (const FeedbackCode::PackedAnswer& packedAnswer : packedAnswersList)
+                codesList.push_back(guessKernel.compute(packedAnswer));
+        }
+        else {
+            for (size_t i = 0; i < answerCount; ++i)
+                codesList.push_back(FeedbackCode::compute(guessLanes, answerLanesList.data() + i * exprLength, exprLength));
+        }
+        std::sort(codesList.begin(), codesList.end());
+        return codesList;
+    }
+};
+
+/**
+ * @struct SampleEstimate
+ * @brief Policy value of a guess over every survivor, estimated from a sample of them.
+ */
+struct SampleEstimate {
+    double merit = 0.0;          ///< Estimated policy value, oriented so that higher is better
+    double standardError = 0.0;  ///< Standard error of `merit`
+};
+
+/**
+ * @brief Estimates a guess's policy value over all survivors from its buckets on a sample.
+ *
+ * <summary>
+ * Every policy is an average over answers of a value that only depends on the answer's
+ * bucket: with `n` sampled answers out of `N`, an answer in a sampled bucket of size `c`
+ * contributes
+ * - Entropy: log2(n / c). The plug-in mean underestimates the entropy of the full set,
+ *   so the Miller-Madow term (K - 1) / (2 n ln 2) is added (K non-empty buckets), scaled
+ *   by 1 - n / N since a sample of every survivor is exact.
+ * - ExpectedSize / WinChance: 1 + (c - 1) * (N - 1) / (n - 1), the unbiased estimate of
+ *   its full bucket size (every other answer of the bucket is sampled with probability
+ *   (n - 1) / (N - 1)).
+ * - Minimax: the largest bucket's share p, scaled to N (binomial variance p * (1 - p)).
+ * The standard error is sqrt(variance / n), with the finite population correction
+ * 1 - n / N for sampling without replacement.
+ * </summary>
+ *
+ * @param scoringPolicy Policy the guesses are ranked with.
+ * @param codesList Sorted feedback of the guess against the sampled answers.
+ * @param answerCount Every survivor (N).
+ * @return SampleEstimate Estimated value (negated for the policies where lower is better).
+ */
+SampleEstimate estimateFromSample(ScoringPolicy scoringPolicy, const std::vector<FeedbackCode::Code>& codesList, size_t answerCount) {
+    const double sampleCount = static_cast<double>(codesList.size());
+    const double answerTotal = static_cast<double>(answerCount);
+    if (codesList.empty()) return {};
+
+    std::vector<size_t> bucketSizesList;
+    for (size_t runBegin = 0; runBegin < codesList.size();) {
+        size_t runEnd = runBegin;
+        while (runEnd < codesList.size() && codesList[runEnd] == codesList[runBegin]) ++runEnd;
+        bucketSizesList.push_back(runEnd - runBegin);
+        runBegin = runEnd;
+    }
+    const double populationCorrection = (std::max)(0.0, 1.0 - sampleCount / answerTotal);
+
+    SampleEstimate sampleEstimate;
+    if (scoringPolicy == ScoringPolicy::Minimax) {
+        const double largestShare = static_cast<double>(*std::max_element(bucketSizesList.begin(), bucketSizesList.end())) / sampleCount;
+        sampleEstimate.merit = -largestShare * answerTotal;
+        sampleEstimate.standardError = answerTotal * std::sqrt(largestShare * (1.0 - largestShare) / sampleCount * populationCorrection);
+        return sampleEstimate;
+    }
+
+    const double sizeScale = (sampleCount > 1.0) ? (answerTotal - 1.0) / (sampleCount - 1.0) : 0.0;
+    double valueSum = 0.0;
+    double squareSum = 0.0;
+    for (size_t bucketSize : bucketSizesList) {
+        const double size = static_cast<double>(bucketSize);
+        const double value = (scoringPolicy == ScoringPolicy::Entropy)
+            ? std::log2(sampleCount / size)
+            : 1.0 + (size - 1.0) * sizeScale;
+        valueSum += size * value;
+        squareSum += size * value * value;
+    }
+    const double mean = valueSum / sampleCount;
+    const double variance = (std::max)(0.0, squareSum / sampleCount - mean * mean);
+    sampleEstimate.standardError = std::sqrt(variance / sampleCount * populationCorrection);
+    sampleEstimate.merit = (scoringPolicy == ScoringPolicy::Entropy)
+        ? mean + static_cast<double>(bucketSizesList.size() - 1) / (2.0 * sampleCount * std::log(2.0)) * populationCorrection
+        : -mean;
+    return sampleEstimate;
+}
+
+/**
+ * @brief Normal approximation of the probability that a value with the given mean advantage is positive.
+ */
+double getConfidence(double advantage, double standardError) {
+    if (standardError <= 0.0) return advantage > 0.0 ? 1.0 : (advantage < 0.0 ? 0.0 : 0.5);
+    return 0.5 * std::erfc(-advantage / (standardError * std::sqrt(2.0)));
+}
+
+/**
+ * @brief Estimates the probability that the first of two guesses ranked on a sample is really better.
+ *
+ * <summary>
+ * Both guesses are estimated on the sample (`estimateFromSample`); the difference of the
+ * estimates, divided by its standard error, gives a normal approximation of the
+ * confidence. WinChance first compares "is a possible answer", which sampling cannot change.
+ * </summary>
+ *
+ * @param scoringPolicy Policy the guesses were ranked with.
+ * @param bestScore First guess, as ranked.
+ * @param secondScore Second guess, as ranked.
+ * @param bestCodesList Sorted feedback of the first guess against the sampled answers.
+ * @param secondCodesList Sorted feedback of the second guess against the sampled answers.
+ * @param answerCount Every survivor (N).
+ * @return double Confidence in [0, 1].
+ */
+double estimateConfidence(
+    ScoringPolicy scoringPolicy,
+    const GuessScore& bestScore,
+    const GuessScore& secondScore,
+    const std::vector<FeedbackCode::Code>& bestCodesList,
+    const std::vector<FeedbackCode::Code>& secondCodesList,
+    size_t answerCount
+) {
+    if (scoringPolicy == ScoringPolicy::WinChance && bestScore.isPossibleAnswer != secondScore.isPossibleAnswer)
+        return 1.0;
+
+    const SampleEstimate bestEstimate = estimateFromSample(scoringPolicy, bestCodesList, answerCount);
+    const SampleEstimate secondEstimate = estimateFromSample(scoringPolicy, secondCodesList, answerCount);
+    return getConfidence(bestEstimate.merit - secondEstimate.merit,
+        std::hypot(bestEstimate.standardError, secondEstimate.standardError));
+}
+
+/**
+ * @brief Ranks the guesses of a prepared pass, exactly or within a time budget.
+ *
+ * <summary>
+ * Without a budget, every answer is used at once. With one, the ranking is an anytime
+ * search (successive halving):
+ * 1. The answers are shuffled once (fixed seed, so runs are repeatable).
+ * 2. A stage ranks the current guesses on the first `sampleSize` shuffled answers and
+ *    keeps the best quarter (at least `MIN_KEPT_GUESSES`) for the next stage.
+ * 3. The next stage uses `SAMPLE_GROWTH` times more answers, so every stage costs about
+ *    the same; the last one uses every answer and is exact for the guesses it kept.
+ * Every stage stops at the deadline. A cut first stage still returns the best of the guesses
+ * it scored (they are taken in a shuffled order, so these are a random subset); a later cut
+ * stage is discarded and the previous stage is returned. Sampled scores are scaled to the full set
+ * (`expectedSize`, `largestBucket`), and the report carries a confidence that the first
+ * guess beats the second (`estimateConfidence`).
+ * </summary>
+ *
+ * @param scoringPass Pass with the guesses set, answers not prepared yet.
+ * @param answerLanesData Lane form of the pool the answers come from.
+ * @param answerHandlesList Survivors, in handle order.
+ * @param scoringPolicy How guesses are ranked.
+ * @param startTime When the caller started, so its own preparation counts against the budget.
+ * @param budgetMs Time budget in milliseconds (0 = exact, no budget).
+ * @param[out] suggestionReport How the ranking was obtained (may be nullptr).
+ * @return std::vector<GuessScore> Best `scoringPass.topCount` guesses, best first.
+ */
+std::vector<GuessScore> rankWithinBudget(
+    ScoringPass& scoringPass,
+    const std::uint8_t* answerLanesData,
+    const std::vector<CandidateHandle>& answerHandlesList,
+    ScoringPolicy scoringPolicy,
+    std::chrono::steady_clock::time_point startTime,
+    size_t budgetMs,
+    SuggestionReport* suggestionReport
+) {
+    const size_t answerCount = answerHandlesList.size();
+    SuggestionReport report;
+    report.answerCount = answerCount;
+
+    if (budgetMs == 0) {
+        scoringPass.prepareAnswers(answerLanesData, answerHandlesList);
+        std::vector<GuessScore> guessScoresList = scoringPass.rank(scoringPolicy);
+        report.sampledCount = answerCount;
+        report.scoredGuessCount = scoringPass.guessHandlesList.size();
+        report.stageCount = 1;
+        report.isExact = true;
+        report.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+        if (suggestionReport) *suggestionReport = report;
+        return guessScoresList;
+    }
+
+    // Answer order of the stages: a fixed shuffle
+    std::vector<size_t> answerOrderList(answerCount);
+    std::iota(answerOrderList.begin(), answerOrderList.end(), size_t{0});
+    std::shuffle(answerOrderList.begin(), answerOrderList.end(), std::mt19937(0x5EED));
+    const std::vector<CandidateHandle> allColumnsList = std::move(scoringPass.answerColumnsList);
+    const auto deadline = startTime + std::chrono::milliseconds(budgetMs);
+
+    const size_t topCount = scoringPass.topCount;
+    std::vector<CandidateHandle> guessHandlesList = std::move(scoringPass.guessHandlesList);
+    std::vector<std::uint8_t> possibleAnswerFlags = std::move(scoringPass.possibleAnswerFlags);
+    {
+        // First stage guess order: a fixed shuffle too, so a cut stage has scored a fair subset
+        std::vector<size_t> guessOrderList(guessHandlesList.size());
+        std::iota(guessOrderList.begin(), guessOrderList.end(), size_t{0});
+        std::shuffle(guessOrderList.begin(), guessOrderList.end(), std::mt19937(0x6E55));
+        std::vector<CandidateHandle> shuffledHandlesList;
+        std::vector<std::uint8_t> shuffledFlagsList;
+        shuffledHandlesList.reserve(guessOrderList.size());
+        shuffledFlagsList.reserve(guessOrderList.size());
+        for (size_t guessIndex : guessOrderList) {
+            shuffledHandlesList.push_back(guessHandlesList[guessIndex]);
+            shuffledFlagsList.push_back(possibleAnswerFlags[guessIndex]);
+        }
+        guessHandlesList = std::move(shuffledHandlesList);
+        possibleAnswerFlags = std::move(shuffledFlagsList);
+    }
+    std::vector<GuessScore> stageScoresList;
+    std::vector<FeedbackCode::Code> bestCodesList;
+    std::vector<FeedbackCode::Code> secondCodesList;
+    for (size_t sampleSize = (std::min)(answerCount, INITIAL_SAMPLE_SIZE);; sampleSize = (std::min)(answerCount, sampleSize * SAMPLE_GROWTH)) {
+        // Sampled answers, back in handle order for memory locality
+        std::vector<size_t> sampleIndicesList(answerOrderList.begin(), answerOrderList.begin() + sampleSize);
+        std::sort(sampleIndicesList.begin(), sampleIndicesList.end());
+        std::vector<CandidateHandle> sampleHandlesList;
+        std::vector<CandidateHandle> sampleColumnsList;
+        sampleHandlesList.reserve(sampleSize);
+        for (size_t answerIndex : sampleIndicesList) {
+            sampleHandlesList.push_back(answerHandlesList[answerIndex]);
+            if (!allColumnsList.empty()) sampleColumnsList.push_back(allColumnsList[answerIndex]);
+        }
+
+        const bool isLastStage = (sampleSize == answerCount);
+        ScoringPass stagePass;
+        stagePass.exprLength = scoringPass.exprLength;
+        stagePass.guessLanesData = scoringPass.guessLanesData;
+        stagePass.feedbackMatrix = scoringPass.feedbackMatrix;
+        stagePass.answerColumnsList = std::move(sampleColumnsList);
+        stagePass.prepareAnswers(answerLanesData, sampleHandlesList);
+        stagePass.guessHandlesList = guessHandlesList;
+        stagePass.possibleAnswerFlags = possibleAnswerFlags;
+        stagePass.topCount = isLastStage ? topCount
+            : (std::max)({ topCount, MIN_KEPT_GUESSES, guessHandlesList.size() / SAMPLE_GROWTH });
+        stagePass.deadline = deadline;
+
+        std::vector<GuessScore> rankedScoresList = stagePass.rank(scoringPolicy);
+        const bool isExpired = stagePass.isExpired.load(std::memory_order_relaxed);
+        if (isExpired && report.stageCount > 0) break;
+
+        stageScoresList = std::move(rankedScoresList);
+        ++report.stageCount;
+        report.sampledCount = sampleSize;
+        report.scoredGuessCount = stagePass.scoredGuessCount.load(std::memory_order_relaxed);
+        report.isExact = isLastStage && !isExpired;
+        if (!report.isExact && stageScoresList.size() >= 2) {
+            bestCodesList = stagePass.collectSortedCodes(stageScoresList[0].handle);
+            secondCodesList = stagePass.collectSortedCodes(stageScoresList[1].handle);
+        }
+        if (isLastStage || isExpired || std::chrono::steady_clock::now() >= deadline) break;
+
+        // Survivors of this stage, in their original (handle) order
+        std::vector<std::pair<CandidateHandle, std::uint8_t>> keptGuessesList;
+        for (const GuessScore& guessScore : stageScoresList)
+            keptGuessesList.emplace_back(guessScore.handle, static_cast<std::uint8_t>(guessScore.isPossibleAnswer));
+        std::sort(keptGuessesList.begin(), keptGuessesList.end());
+        guessHandlesList.clear();
+        possibleAnswerFlags.clear();
+        for (const auto& [guessHandle, isPossibleAnswer] : keptGuessesList) {
+            guessHandlesList.push_back(guessHandle);
+            possibleAnswerFlags.push_back(isPossibleAnswer);
+        }
+    }
+
+    if (stageScoresList.size() > topCount) stageScoresList.resize(topCount);
+    if (!report.isExact) {
+        // Sample statistics, scaled to every survivor
+        const double scale = static_cast<double>(answerCount) / static_cast<double>(report.sampledCount);
+        for (GuessScore& guessScore : stageScoresList) {
+            guessScore.expectedSize *= scale;
+            guessScore.largestBucket = static_cast<size_t>(std::lround(static_cast<double>(guessScore.largestBucket) * scale));
+            guessScore.winChance = guessScore.isPossibleAnswer ? 1.0 / static_cast<double>(answerCount) : 0.0;
+            switch (scoringPolicy) {
+                case ScoringPolicy::Entropy:      break;
+                case ScoringPolicy::Minimax:      guessScore.score = static_cast<double>(guessScore.largestBucket); break;
+                case ScoringPolicy::ExpectedSize: guessScore.score = guessScore.expectedSize; break;
+                case ScoringPolicy::WinChance:    guessScore.score = guessScore.winChance; break;
+            }
+        }
+        report.confidence = (stageScoresList.size() >= 2)
+            ? estimateConfidence(scoringPolicy, stageScoresList[0], stageScoresList[1], bestCodesList, secondCodesList, answerCount)
+            : 1.0;
+    }
+    report.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+    if (suggestionReport) *suggestionReport = report;
+    return stageScoresList;
+}
+
+/**
+ * @brief Ranks the guesses of a prepared pass on a sample, then rescores the contenders exactly.
+ *
+ * <summary>
+ * Meant for survivor sets too large to score every guess against every survivor:
+ * 1. Every guess is ranked on `SAMPLED_ANSWER_COUNT` random survivors (fixed seed); the
+ *    best `SAMPLED_KEPT_GUESSES` get an estimate and a 99% confidence interval
+ *    (`estimateFromSample`).
+ * 2. A guess stays in contention if its interval reaches the highest lower bound of
+ *    all intervals (at most `MAX_CONTENDER_COUNT`, at least `topCount`, best estimates first).
+ * 3. The contenders are rescored on every survivor, so the returned scores are exact.
+ * The report's confidence is the lowest probability, over the guesses left out, that
+ * the exact first guess beats it.
+ * </summary>
+ *
+ * @param scoringPass Pass with the guesses set, answers not prepared yet.
+ * @param answerLanesData Lane form of the pool the answers come from.
+ * @param answerHandlesList Survivors, in handle order.
+ * @param scoringPolicy How guesses are ranked.
+ * @param[out] suggestionReport How the ranking was obtained (may be nullptr).
+ * @return std::vector<GuessScore> Best `scoringPass.topCount` guesses, best first.
+ */
+std::vector<GuessScore> rankBySampling(
+    ScoringPass& scoringPass,
+    const std::uint8_t* answerLanesData,
+    const std::vector<CandidateHandle>& answerHandlesList,
+    ScoringPolicy scoringPolicy,
+    SuggestionReport* suggestionReport
+) {
+    const auto startTime = std::chrono::steady_clock::now();
+    const size_t answerCount = answerHandlesList.size();
+    const size_t sampleSize = (std::min)(answerCount, SAMPLED_ANSWER_COUNT);
+    SuggestionReport report;
+    report.answerCount = answerCount;
+    report.sampledCount = sampleSize;
+    report.scoredGuessCount = scoringPass.guessHandlesList.size();
+    report.stageCount = 2;
+
+    // Sampled answers, in handle order
+    std::vector<size_t> answerOrderList(answerCount);
+    std::iota(answerOrderList.begin(), answerOrderList.end(), size_t{0});
+    std::shuffle(answerOrderList.begin(), answerOrderList.end(), std::mt19937(0x5EED));
+    answerOrderList.resize(sampleSize);
+    std::sort(answerOrderList.begin(), answerOrderList.end());
+    std::vector<CandidateHandle> sampleHandlesList;
+    std::vector<CandidateHandle> sampleColumnsList;
+    sampleHandlesList.reserve(sampleSize);
+    for (size_t answerIndex : answerOrderList) {
+        sampleHandlesList.push_back(answerHandlesList[answerIndex]);
+        if (!scoringPass.answerColumnsList.empty()) sampleColumnsList.push_back(scoringPass.answerColumnsList[answerIndex]);
+    }
+
+    ScoringPass samplePass;
+    samplePass.exprLength = scoringPass.exprLength;
+    samplePass.guessLanesData = scoringPass.guessLanesData;
+    samplePass.feedbackMatrix = scoringPass.feedbackMatrix;
+    samplePass.answerColumnsList = std::move(sampleColumnsList);
+    samplePass.prepareAnswers(answerLanesData, sampleHandlesList);
+    samplePass.guessHandlesList = scoringPass.guessHandlesList;
+    samplePass.possibleAnswerFlags = scoringPass.possibleAnswerFlags;
+    samplePass.topCount = (std::max)(scoringPass.topCount, SAMPLED_KEPT_GUESSES);
+    const std::vector<GuessScore> sampledScoresList = samplePass.rank(scoringPolicy);
+
+    // Confidence interval of every kept guess; WinChance ranks possible answers first whatever the sample
+    struct Contender {
+        CandidateHandle handle = 0;
+        bool isPossibleAnswer = false;
+        SampleEstimate sampleEstimate;
+    };
+    std::vector<Contender> contendersList;
+    for (const GuessScore& guessScore : sampledScoresList) {
+        if (scoringPolicy == ScoringPolicy::WinChance && guessScore.isPossibleAnswer != sampledScoresList.front().isPossibleAnswer)
+            continue;
+        contendersList.push_back({ guessScore.handle, guessScore.isPossibleAnswer,
+            estimateFromSample(scoringPolicy, samplePass.collectSortedCodes(guessScore.handle), answerCount) });
+    }
+    std::stable_sort(contendersList.begin(), contendersList.end(), [](const Contender& lhs, const Contender& rhs) {
+        return lhs.sampleEstimate.merit > rhs.sampleEstimate.merit;
+    });
+    double bestLowerBound = -std::numeric_limits<double>::infinity();
+    for (const Contender& contender : contendersList)
+        bestLowerBound = (std::max)(bestLowerBound, contender.sampleEstimate.merit - CONTENTION_Z * contender.sampleEstimate.standardError);
+
+    size_t contenderCount = 0;
+    while (contenderCount < contendersList.size() && contenderCount < MAX_CONTENDER_COUNT) {
+        const SampleEstimate& sampleEstimate = contendersList[contenderCount].sampleEstimate;
+        if (contenderCount >= scoringPass.topCount
+            && sampleEstimate.merit + CONTENTION_Z * sampleEstimate.standardError < bestLowerBound)
+            break;
+        ++contenderCount;
+    }
+
+    // Exact rescoring of the contenders, in handle order
+    std::vector<std::pair<CandidateHandle, std::uint8_t>> keptGuessesList;
+    for (size_t i = 0; i < contenderCount; ++i)
+        keptGuessesList.emplace_back(contendersList[i].handle, static_cast<std::uint8_t>(contendersList[i].isPossibleAnswer));
+    std::sort(keptGuessesList.begin(), keptGuessesList.end());
+    scoringPass.guessHandlesList.clear();
+    scoringPass.possibleAnswerFlags.clear();
+    for (const auto& [guessHandle, isPossibleAnswer] : keptGuessesList) {
+        scoringPass.guessHandlesList.push_back(guessHandle);
+        scoringPass.possibleAnswerFlags.push_back(isPossibleAnswer);
+    }
+    scoringPass.prepareAnswers(answerLanesData, answerHandlesList);
+    std::vector<GuessScore> guessScoresList = scoringPass.rank(scoringPolicy);
+
+    // Chance that no guess left out beats the exact winner
+    report.contenderCount = contenderCount;
+    if (!guessScoresList.empty()) {
+        const double winnerMerit = (scoringPolicy == ScoringPolicy::Entropy) ? guessScoresList.front().entropyBits
+            : (scoringPolicy == ScoringPolicy::Minimax) ? -static_cast<double>(guessScoresList.front().largestBucket)
+            : -guessScoresList.front().expectedSize;
+        for (size_t i = contenderCount; i < contendersList.size(); ++i) {
+            const SampleEstimate& sampleEstimate = contendersList[i].sampleEstimate;
+            report.confidence = (std::min)(report.confidence,
+                getConfidence(winnerMerit - sampleEstimate.merit, sampleEstimate.standardError));
+        }
+    }
+    report.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+    if (suggestionReport) *suggestionReport = report;
+    return guessScoresList;
+}
+
+/**
+ * @brief Picks every handle of `handlesList`, or an evenly spaced subset of `maxCount` (0 = no limit).
+ */
+std::vector<CandidateHandle> pickEvenly(const std::vector<CandidateHandle>& handlesList, size_t maxCount) {
+    if (maxCount == 0 || handlesList.size() <= maxCount) return handlesList;
+    std::vector<CandidateHandle> pickedHandlesList;
+    pickedHandlesList.reserve(maxCount);
+    for (size_t i = 0; i < maxCount; ++i)
+        pickedHandlesList.push_back(handlesList[i * handlesList.size() / maxCount]);
+    return pickedHandlesList;
+}
+
+/**
+ * @brief Keeps one guess per class of guesses that split the answers identically.
+ *
+ * <summary>
+ * A symbol that no answer contains is red wherever it is guessed, so every such symbol
+ * plays the same role: two guesses that only differ in which absent symbols they use
+ * produce the same code against every answer, hence the same partition and scores.
+ * Each guess is reduced to a signature (its lanes, absent lanes replaced by one shared
+ * placeholder) and only the first guess of every signature is kept.
+ * </summary>
+ *
+ * @param guessHandlesList Guesses, in handle order.
+ * @param guessLanesData Lane form of the pool the guesses come from.
+ * @param exprLength Length of every expression.
+ * @param answerLanesData Lane form of the pool the answers come from.
+ * @param answerHandlesList Survivors.
+ * @return std::vector<CandidateHandle> First guess of every class, in the original order.
+ */
+std::vector<CandidateHandle> pickRepresentatives(
+    const std::vector<CandidateHandle>& guessHandlesList,
+    const std::uint8_t* guessLanesData,
+    int exprLength,
+    const std::uint8_t* answerLanesData,
+    const std::vector<CandidateHandle>& answerHandlesList
+) {
+    constexpr std::uint8_t ABSENT_LANE = SymbolHistogram::LANE_COUNT;  // Shared placeholder of every absent symbol
+
+    std::array<bool, SymbolHistogram::LANE_COUNT> isPresentList{};
+    for (CandidateHandle answerHandle : answerHandlesList) {
+        const std::uint8_t* answerLanes = answerLanesData + static_cast<size_t>(answerHandle) * exprLength;
+        for (int position = 0; position < exprLength; ++position)
+            isPresentList[answerLanes[position]] = true;
+    }
+    if (std::all_of(isPresentList.begin(), isPresentList.end(), [](bool isPresent) { return isPresent; }))
+        return guessHandlesList;
+
+    std::vector<CandidateHandle> representativesList;
+    std::unordered_set<std::string> signaturesSet;
+    std::string signature(static_cast<size_t>(exprLength), '\0');
+    for (CandidateHandle guessHandle : guessHandlesList) {
+        const std::uint8_t* guessLanes = guessLanesData + static_cast<size_t>(guessHandle) * exprLength;
+        for (int position = 0; position < exprLength; ++position)
+            signature[position] = static_cast<char>(isPresentList[guessLanes[position]] ? guessLanes[position] : ABSENT_LANE);
+        if (signaturesSet.insert(signature).second)
+            representativesList.push_back(guessHandle);
+    }
+    return representativesList;
+}
+
+}  // namespace (end of anonymous)
+
+/**
+ * @brief Caches the lane form of every candidate of a pool.
+ *
+ * @param candidatePool Pool the suggested handles will refer to.
+ */
+void GuessSuggester::reset(const CandidatePool& candidatePool) {
+    clear();
+    if (candidatePool.getExprLength() > FeedbackCode::MAX_LENGTH) return;  // Codes would not fit, suggestions stay off
+
+    exprLength = candidatePool.getExprLength();
+    candidateCount = candidatePool.size();
+    lanesList.resize(candidateCount * static_cast<size_t>(exprLength));
+    for (size_t handle = 0; handle < candidateCount; ++handle)
+        FeedbackCode::toLanes(candidatePool.view(static_cast<CandidateHandle>(handle)), lanesList.data() + handle * exprLength);
+}
+
+/**
+ * @brief Releases the cached candidates.
+ */
+void GuessSuggester::clear() {
+    std::vector<std::uint8_t>().swap(lanesList);
+    exprLength = 0;
+    candidateCount = 0;
+}
+
+/**
+ * @brief Scores possible guesses and returns the best ones.
+ *
+ * <summary>
+ * 1. Packs the survivors once (the answers): `PackedAnswer` for short expressions,
+ *    plain lanes for the reference kernel otherwise.
+ * 2. Picks the guesses: every survivor, or an evenly spaced subset of `maxGuessCount`.
+ * 3. Scores the guesses on worker threads, dropping guesses that cannot reach the
+ *    worker's `topCount` best, and keeps the `topCount` best (see `ScoringPass`).
+ * With a time budget, steps 1 and 3 run on growing samples of the survivors instead
+ * (`rankWithinBudget`); the budget starts when this call does.
+ * Without one, above `exactAnswerLimit` survivors, step 3 first runs on a sample and
+ * only the guesses still in contention are scored on every survivor (`rankBySampling`).
+ * </summary>
+ *
+ * @param survivorSet Current survivors (the possible answers).
+ * @param topCount Number of guesses to return.
+ * @param maxGuessCount Maximum number of guesses scored (0 = every survivor).
+ * @param scoringPolicy How guesses are ranked.
+ * @param budgetMs Time budget in milliseconds (0 = exact); see `rankWithinBudget`.
+ * @param[out] suggestionReport How the ranking was obtained (may be nullptr).
+ * @return std::vector<GuessScore> Best guesses, best first.
+ */
+std::vector<GuessScore> GuessSuggester::suggest(
+    const SurvivorSet& survivorSet,
+    size_t topCount,
+    size_t maxGuessCount,
+    ScoringPolicy scoringPolicy,
+    size_t budgetMs,
+    SuggestionReport* suggestionReport
+) const {
+    const auto startTime = std::chrono::steady_clock::now();
+    if (empty() || survivorSet.empty() || topCount == 0) return {};
+
+    const std::vector<CandidateHandle> answerHandlesList = survivorSet.toSortedHandles();
+    ScoringPass scoringPass;
+    scoringPass.exprLength = exprLength;
+
+    scoringPass.guessLanesData = lanesList.data();
+    scoringPass.guessHandlesList = pickEvenly(answerHandlesList, maxGuessCount);
+    scoringPass.possibleAnswerFlags.assign(scoringPass.guessHandlesList.size(), 1);  // Guesses are drawn from the survivors
+    scoringPass.topCount = topCount;
+    if (budgetMs == 0 && exactAnswerLimit > 0 && answerHandlesList.size() > exactAnswerLimit)
+        return rankBySampling(scoringPass, lanesList.data(), answerHandlesList, scoringPolicy, suggestionReport);
+    return rankWithinBudget(scoringPass, lanesList.data(), answerHandlesList, scoringPolicy, startTime, budgetMs, suggestionReport);
+}
+
+/**
+ * @brief Scores guesses drawn from every valid expression and returns the best ones.
+ *
+ * <summary>
+ * Same pass as `suggest`, but the guesses come from the cached universe. A guess counts as
+ * a possible answer when its text is one of the survivors (`GuessUniverse::find`). When the
+ * universe has a feedback matrix, codes are read from its rows instead of being computed.
+ * Guesses that only differ in symbols no survivor contains split the survivors identically,
+ * so only the first of them is scored (`pickRepresentatives`). The time budget covers
+ * locating the survivors and picking the representatives too.
+ * </summary>
+ *
+ * @param survivorSet Current survivors (the possible answers, handles into the cached pool).
+ * @param candidatePool Pool `survivorSet` refers to (the pool given to `reset`).
+ * @param guessUniverse Universe the guesses are drawn from; must match the pool's length.
+ * @param topCount Number of guesses to return.
+ * @param maxGuessCount Maximum number of guesses scored (0 = the whole universe).
+ * @param scoringPolicy How guesses are ranked.
+ * @param budgetMs Time budget in milliseconds (0 = exact); see `rankWithinBudget`.
+ * @param[out] suggestionReport How the ranking was obtained (may be nullptr).
+ * @return std::vector<GuessScore> Best guesses, best first; handles refer to `guessUniverse.getPool()`.
+ */
+std::vector<GuessScore> GuessSuggester::suggestFromUniverse(
+    const SurvivorSet& survivorSet,
+    const CandidatePool& candidatePool,
+    const GuessUniverse& guessUniverse,
+    size_t topCount,
+    size_t maxGuessCount,
+    ScoringPolicy scoringPolicy,
+    size_t budgetMs,
+    SuggestionReport* suggestionReport
+) const {
+    const auto startTime = std::chrono::steady_clock::now();
+    if (empty() || survivorSet.empty() || topCount == 0) return {};
+    if (guessUniverse.empty() || guessUniverse.getPool().getExprLength() != exprLength) return {};
+
+    const std::vector<CandidateHandle> answerHandlesList = survivorSet.toSortedHandles();
+    ScoringPass scoringPass;
+    scoringPass.exprLength = exprLength;
+
+    // Survivors, located in the universe
+    std::vector<std::uint8_t> survivorFlagsList(guessUniverse.size(), 0);
+    std::vector<CandidateHandle> answerColumnsList;
+    answerColumnsList.reserve(answerHandlesList.size());
+    for (CandidateHandle answerHandle : answerHandlesList) {
+        CandidateHandle universeHandle;
+        if (guessUniverse.find(candidatePool.view(answerHandle), universeHandle)) {
+            survivorFlagsList[universeHandle] = 1;
+            answerColumnsList.push_back(universeHandle);
+        }
+    }
+
+    // Codes are read from the feedback matrix when it covers every answer
+    if (guessUniverse.getFeedbackMatrix().isOpen() && answerColumnsList.size() == answerHandlesList.size()) {
+        scoringPass.feedbackMatrix = &guessUniverse.getFeedbackMatrix();
+        scoringPass.answerColumnsList = std::move(answerColumnsList);
+    }
+
+    // One guess per class of equivalent guesses, then the cap
+    std::vector<CandidateHandle> universeHandlesList(guessUniverse.size());
+    std::iota(universeHandlesList.begin(), universeHandlesList.end(), CandidateHandle{0});
+    scoringPass.guessLanesData = guessUniverse.getLanesData();
+    scoringPass.guessHandlesList = pickEvenly(
+        pickRepresentatives(universeHandlesList, scoringPass.guessLanesData, exprLength, lanesList.data(), answerHandlesList),
+        maxGuessCount);
+    scoringPass.possibleAnswerFlags.reserve(scoringPass.guessHandlesList.size());
+    for (CandidateHandle guessHandle : scoringPass.guessHandlesList)
+        scoringPass.possibleAnswerFlags.push_back(survivorFlagsList[guessHandle]);
+    scoringPass.topCount = topCount;
+    if (budgetMs == 0 && exactAnswerLimit > 0 && answerHandlesList.size() > exactAnswerLimit)
+        return rankBySampling(scoringPass, lanesList.data(), answerHandlesList, scoringPolicy, suggestionReport);
+    return rankWithinBudget(scoringPass, lanesList.data(), answerHandlesList, scoringPolicy, startTime, budgetMs, suggestionReport);
+}
@@ -0,0 +1,158 @@
+/* ----- ----- ----- ----- */
+// GuessSuggester.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "CandidatePool.h"
+#include "GuessUniverse.h"
+#include "ScoringPolicy.h"
+#include "SurvivorSet.h"
+
+/**
+ * @struct GuessScore
+ * @brief Score of one possible next guess against the current survivors.
+ */
+struct GuessScore {
+    CandidateHandle handle = 0;     ///< Guess (handle into the candidate pool)
+    double score = 0.0;             ///< Value of the chosen `ScoringPolicy` (bits, survivors or probability)
+    double entropyBits = 0.0;       ///< Expected information of the feedback, in bits
+    double expectedSize = 0.0;      ///< Survivors left on average
+    double winChance = 0.0;         ///< Probability that the guess is the answer
+    size_t bucketCount = 0;         ///< Number of distinct feedbacks the guess can produce
+    size_t largestBucket = 0;       ///< Survivors left in the worst case
+    bool isPossibleAnswer = false;  ///< True if the guess is itself one of the survivors
+};
+
+/**
+ * @struct SuggestionReport
+ * @brief How a ranking was obtained: exactly, or from a sample of the survivors within a time budget.
+ */
+struct SuggestionReport {
+    size_t answerCount = 0;       ///< Survivors
+    size_t sampledCount = 0;      ///< Survivors the ranking is based on
+    size_t scoredGuessCount = 0;  ///< Guesses scored in the returned stage
+    int stageCount = 0;           ///< Completed sampling stages
+    bool isExact = false;         ///< True if every survivor was used
+    size_t contenderCount = 0;    ///< Guesses rescored on every survivor after a sampled pre-ranking (0 = none)
+    double confidence = 1.0;      ///< Estimated probability that the first guess beats the second (1 when exact)
+    long long elapsedMs = 0;      ///< Wall time of the ranking
+};
+
+/**
+ * @class GuessSuggester
+ * @brief Ranks possible next guesses by the feedback partition they induce over the survivors.
+ *
+ * <summary>
+ * For a guess `g`, every surviving answer `a` would produce one feedback code
+ * (`FeedbackCode::compute(g, a)`). Grouping the survivors by code partitions them;
+ * a good guess splits them into many small groups. With `n_k` survivors in group `k`
+ * out of `N`, the expected information is
+ *     H(g) = log2(N) - (1 / N) * sum_k n_k * log2(n_k)   [bits].
+ *
+ * Other rankings (`ScoringPolicy`) use the same groups: the largest group (minimax),
+ * the expected group size sum_k n_k^2 / N, or the chance that the guess is the answer.
+ *
+ * Every candidate of the pool is converted once into lane indices (`reset`), so scoring
+ * a guess is one tight pass over the packed survivors (`FeedbackCode::GuessKernel`)
+ * plus a histogram over codes. Each policy's cost only grows while survivors are added
+ * to the histogram, so a guess is dropped mid-pass as soon as it can no longer reach
+ * the best `topCount` guesses of its worker.
+ * Guesses are scored on several threads; when there are more survivors than
+ * `maxGuessCount`, an evenly spaced subset of them is scored as guesses
+ * (every survivor is still used as a possible answer). `suggestFromUniverse` draws the
+ * guesses from every valid expression instead (`GuessUniverse`).
+ *
+ * With a time budget, the ranking is an anytime search: guesses are first ranked on a
+ * small sample of the survivors, the best ones are re-ranked on larger samples, and the
+ * last stage completed within the budget is returned (`SuggestionReport` tells how much
+ * of the survivors it used and how confident it is).
+ *
+ * Above `setExactAnswerLimit` survivors (and without a budget), the guesses are first
+ * estimated on a random sample of the survivors, with a confidence interval each; only
+ * the guesses whose interval reaches the best one are rescored on every survivor.
+ * </summary>
+ */
+class GuessSuggester {
+public:
+    GuessSuggester() = default;
+
+    /**
+     * @brief Caches the lane form of every candidate of a pool.
+     * @param candidatePool Pool the suggested handles will refer to.
+     */
+    void reset(const CandidatePool& candidatePool);
+
+    /**
+     * @brief Releases the cached candidates.
+     */
+    void clear();
+
+    /**
+     * @brief True if no pool has been cached yet.
+     */
+    bool empty() const { return candidateCount == 0; }
+
+    /**
+     * @brief Sets the survivor count above which guesses are pre-ranked on a sample.
+     * @param answerLimit Most survivors scored exactly against every guess (0 = always exact).
+     */
+    void setExactAnswerLimit(size_t answerLimit) { exactAnswerLimit = answerLimit; }
+
+    /**
+     * @brief Scores possible guesses and returns the best ones.
+     *
+     * @param survivorSet Current survivors (the possible answers).
+     * @param topCount Number of guesses to return.
+     * @param maxGuessCount Maximum number of guesses scored (0 = every survivor).
+     * @param scoringPolicy How guesses are ranked.
+     * @param budgetMs Time budget in milliseconds (0 = exact, however long it takes).
+     * @param[out] suggestionReport How the ranking was obtained (may be nullptr).
+     * @return std::vector<GuessScore> Best guesses, best first.
+     */
+    std::vector<GuessScore> suggest(
+        const SurvivorSet& survivorSet,
+        size_t topCount,
+        size_t maxGuessCount,
+        ScoringPolicy scoringPolicy = ScoringPolicy::Entropy,
+        size_t budgetMs = 0,
+        SuggestionReport* suggestionReport = nullptr
+    ) const;
+
+    /**
+     * @brief Scores guesses drawn from every valid expression, not just the survivors.
+     *
+     * @param survivorSet Current survivors (the possible answers).
+     * @param candidatePool Pool `survivorSet` refers to (the pool given to `reset`).
+     * @param guessUniverse Universe the guesses are drawn from.
+     * @param topCount Number of guesses to return.
+     * @param maxGuessCount Maximum number of guesses scored (0 = the whole universe).
+     * @param scoringPolicy How guesses are ranked.
+     * @param budgetMs Time budget in milliseconds (0 = exact, however long it takes).
+     * @param[out] suggestionReport How the ranking was obtained (may be nullptr).
+     * @return std::vector<GuessScore> Best guesses, best first; handles refer to `guessUniverse.getPool()`.
+     */
+    std::vector<GuessScore> suggestFromUniverse(
+        const SurvivorSet& survivorSet,
+        const CandidatePool& candidatePool,
+        const GuessUniverse& guessUniverse,
+        size_t topCount,
+        size_t maxGuessCount,
+        ScoringPolicy scoringPolicy = ScoringPolicy::Entropy,
+        size_t budgetMs = 0,
+        SuggestionReport* suggestionReport = nullptr
+    ) const;
+
+private:
+    int exprLength = 0;                 ///< Length of every candidate
+    size_t candidateCount = 0;          ///< Number of cached candidates
+    size_t exactAnswerLimit = 0;        ///< Survivors above which guesses are pre-ranked on a sample (0 = never)
+    std::vector<std::uint8_t> lanesList;  ///< Lane index of every symbol, `exprLength` per candidate
+};
@@ -0,0 +1,135 @@
+/* ----- ----- ----- ----- */
+// GuessUniverse.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/17
+// Version: v1.1
+/* ----- ----- ----- ----- */
+
+#include "GuessUniverse.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <numeric>
+#include <unordered_map>
+
+#include "CandidateGenerator.h"
+#include "Constraint.h"
+#include "FeedbackCode.h"
+#include "core/logging/AppLogger.h"
+
+/**
+ * @brief Generates (or regenerates) the universe for a configuration.
+ *
+ * <summary>
+ * Runs `CandidateGenerator::generatePool` without any previous guess, so only the
+ * expression rules apply. Expressions longer than `FeedbackCode::MAX_LENGTH` cannot be
+ * scored; the universe then stays empty. A configuration whose count of evaluations
+ * (`CandidateGenerator::countUnconstrainedEvaluations`) exceeds `maxEvaluatedCount` is
+ * refused before searching; a search still stopped by the limit would only hold a
+ * biased part of the universe, so it is dropped too. Either way the configuration is
+ * marked as over the limit.
+ * </summary>
+ *
+ * @param exprLength Length of every expression.
+ * @param operatorsSet Allowed operators.
+ * @param validator Validator already configured with `operatorsSet`.
+ * @param maxEvaluatedCount Most LHS sequences evaluated by the search (0 = no limit).
+ * @return false if the limit was reached; the universe then stays empty.
+ */
+bool GuessUniverse::build(int exprLength, const std::unordered_set<char>& operatorsSet, ExpressionValidator& validator,
+    size_t maxEvaluatedCount) {
+    clear();
+    builtExprLength = exprLength;
+    builtOperatorsSet = operatorsSet;
+    if (exprLength > FeedbackCode::MAX_LENGTH) return true;
+
+    std::unordered_map<char, Constraint> unconstrainedMap;
+    CandidateGenerator generator(validator);
+    if (maxEvaluatedCount > 0
+        && generator.countUnconstrainedEvaluations(exprLength, operatorsSet) > static_cast<double>(maxEvaluatedCount)) {
+        isOverLimit = true;
+        return false;
+    }
+    generator.setEvaluationLimit(maxEvaluatedCount);
+    universePool = generator.generatePool(exprLength, operatorsSet, {}, {}, unconstrainedMap);
+    if (generator.isEvaluationLimitReached()) {
+        universePool.clear();
+        isOverLimit = true;
+        return false;
+    }
+
+    lanesList.resize(universePool.size() * static_cast<size_t>(exprLength));
+    for (size_t handle = 0; handle < universePool.size(); ++handle)
+        FeedbackCode::toLanes(universePool.view(static_cast<CandidateHandle>(handle)), lanesList.data() + handle * exprLength);
+
+    sortedHandlesList.resize(universePool.size());
+    std::iota(sortedHandlesList.begin(), sortedHandlesList.end(), CandidateHandle{0});
+    std::sort(sortedHandlesList.begin(), sortedHandlesList.end(), [this](CandidateHandle lhs, CandidateHandle rhs) {
+        return universePool.view(lhs) < universePool.view(rhs);
+    });
+    return true;
+}
+
+/**
+ * @brief Releases the cached universe.
+ */
+void GuessUniverse::clear() {
+    feedbackMatrix.close();
+    universePool.clear();
+    builtOperatorsSet.clear();
+    builtExprLength = 0;
+    isOverLimit = false;
+    std::vector<std::uint8_t>().swap(lanesList);
+    std::vector<CandidateHandle>().swap(sortedHandlesList);
+}
+
+/**
+ * @brief Looks up an expression of the universe (binary search over the sorted handles).
+ *
+ * @param exprLine Expression to find.
+ * @param[out] handle Handle of the expression in `getPool()`, if found.
+ * @return true if the expression is part of the universe.
+ */
+bool GuessUniverse::find(std::string_view exprLine, CandidateHandle& handle) const {
+    auto handleIt = std::lower_bound(sortedHandlesList.begin(), sortedHandlesList.end(), exprLine,
+        [this](CandidateHandle lhs, std::string_view value) { return universePool.view(lhs) < value; });
+    if (handleIt == sortedHandlesList.end() || universePool.view(*handleIt) != exprLine) return false;
+    handle = *handleIt;
+    return true;
+}
+
+/**
+ * @brief Maps the feedback matrix of the universe, building its file first if needed.
+ *
+ * <summary>
+ * The file is named after the configuration (`FeedbackMatrix::getFileName`) and reused by
+ * later runs. Universes whose matrix would exceed `maxBytes` are skipped.
+ * </summary>
+ *
+ * @param directoryPath Directory holding matrix files.
+ * @param maxBytes Largest matrix file used; bigger universes keep computing codes on the fly.
+ * @return true if a matrix is mapped.
+ */
+bool GuessUniverse::loadFeedbackMatrix(const std::string& directoryPath, std::uint64_t maxBytes) {
+    feedbackMatrix.close();
+    if (empty()) return false;
+
+    const std::uint64_t matrixBytes = FeedbackMatrix::getFileBytes(size(), universePool.getExprLength());
+    if (matrixBytes > maxBytes) {
+        AppLogger::Debug(std::format("Feedback matrix skipped: {} bytes over the {} byte limit.", matrixBytes, maxBytes));
+        return false;
+    }
+
+    const std::string filePath =
+        (std::filesystem::path(directoryPath) / FeedbackMatrix::getFileName(universePool.getExprLength(), builtOperatorsSet)).string();
+    if (feedbackMatrix.open(filePath, universePool, builtOperatorsSet)) return true;
+
+    auto buildStartTime = std::chrono::steady_clock::now();
+    if (!FeedbackMatrix::build(filePath, universePool, builtOperatorsSet)) return false;
+    auto buildElapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - buildStartTime).count();
+    AppLogger::Debug(std::format("Built feedback matrix {}: {} bytes in {} ms.", filePath, matrixBytes, buildElapsedMs));
+    return feedbackMatrix.open(filePath, universePool, builtOperatorsSet);
+}
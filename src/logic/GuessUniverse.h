@@ -0,0 +1,128 @@
+/* ----- ----- ----- ----- */
+// GuessUniverse.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/17
+// Version: v1.1
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "CandidatePool.h"
+#include "ExpressionValidator.h"
+#include "FeedbackMatrix.h"
+
+/**
+ * @class GuessUniverse
+ * @brief Every valid expression of one game configuration, cached as possible probing guesses.
+ *
+ * <summary>
+ * The best next guess is often an expression the feedback already ruled out: it can
+ * split the survivors better than any survivor does. The universe is the unconstrained
+ * output of `CandidateGenerator` for an (expression length, operator set) pair.
+ *
+ * Generating it takes a full DFS, so it is built once and kept across rounds and games
+ * until the configuration changes (`isBuiltFor`). The search hardly prunes without
+ * feedback and grows about fifteenfold per character, so `build` takes a limit on the
+ * LHS sequences it evaluates: a configuration over it is refused, remembered as such
+ * (`isOverLimitFor`), and callers go without the universe. Next to the pool it caches:
+ * - the lane form of every expression (`FeedbackCode::toLanes`), ready for scoring;
+ * - the handles sorted by text, so a survivor of a round pool is found in the universe
+ *   with a binary search (`find`);
+ * - optionally, the feedback of every expression against every other one, mapped from a
+ *   file shared across runs (`loadFeedbackMatrix`).
+ * </summary>
+ */
+class GuessUniverse {
+public:
+    GuessUniverse() = default;
+
+    /**
+     * @brief True if the cached universe matches the given configuration.
+     */
+    bool isBuiltFor(int exprLength, const std::unordered_set<char>& operatorsSet) const {
+        return !universePool.empty() && universePool.getExprLength() == exprLength && builtOperatorsSet == operatorsSet;
+    }
+
+    /**
+     * @brief True if the last `build` for this configuration was refused by its evaluation limit.
+     */
+    bool isOverLimitFor(int exprLength, const std::unordered_set<char>& operatorsSet) const {
+        return isOverLimit && builtExprLength == exprLength && builtOperatorsSet == operatorsSet;
+    }
+
+    /**
+     * @brief Generates (or regenerates) the universe for a configuration.
+     *
+     * @param exprLength Length of every expression.
+     * @param operatorsSet Allowed operators.
+     * @param validator Validator already configured with `operatorsSet`.
+     * @param maxEvaluatedCount Most LHS sequences evaluated by the search (0 = no limit).
+     * @return false if the limit was reached; the universe then stays empty.
+     */
+    bool build(int exprLength, const std::unordered_set<char>& operatorsSet, ExpressionValidator& validator,
+        size_t maxEvaluatedCount);
+
+    /**
+     * @brief Releases the cached universe.
+     */
+    void clear();
+
+    /**
+     * @brief Looks up an expression of the universe.
+     *
+     * @param exprLine Expression to find.
+     * @param[out] handle Handle of the expression in `getPool()`, if found.
+     * @return true if the expression is part of the universe.
+     */
+    bool find(std::string_view exprLine, CandidateHandle& handle) const;
+
+    /**
+     * @brief Maps the feedback matrix of the universe, building its file first if needed.
+     *
+     * @param directoryPath Directory holding matrix files.
+     * @param maxBytes Largest matrix file used; bigger universes keep computing codes on the fly.
+     * @return true if a matrix is mapped.
+     */
+    bool loadFeedbackMatrix(const std::string& directoryPath, std::uint64_t maxBytes);
+
+    /**
+     * @brief Feedback matrix of the universe (closed unless `loadFeedbackMatrix` succeeded).
+     */
+    const FeedbackMatrix& getFeedbackMatrix() const { return feedbackMatrix; }
+
+    /**
+     * @brief Expressions of the universe, in generation order.
+     */
+    const CandidatePool& getPool() const { return universePool; }
+
+    /**
+     * @brief Lane indices of every expression, `getPool().getExprLength()` per handle.
+     */
+    const std::uint8_t* getLanesData() const { return lanesList.data(); }
+
+    /**
+     * @brief Number of expressions in the universe.
+     */
+    size_t size() const { return universePool.size(); }
+
+    /**
+     * @brief True if no universe has been built.
+     */
+    bool empty() const { return universePool.empty(); }
+
+private:
+    CandidatePool universePool;                      ///< Every valid expression
+    std::unordered_set<char> builtOperatorsSet;      ///< Operators the universe was built (or refused) for
+    int builtExprLength = 0;                         ///< Length the universe was built (or refused) for
+    bool isOverLimit = false;                        ///< The last build reached its evaluation limit
+    std::vector<std::uint8_t> lanesList;             ///< Lane form of every expression
+    std::vector<CandidateHandle> sortedHandlesList;  ///< Handles in lexicographic order of their text
+    FeedbackMatrix feedbackMatrix;                   ///< Mapped guess x answer codes, if loaded
+};
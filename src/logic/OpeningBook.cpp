@@ -0,0 +1,229 @@
+/* ----- ----- ----- ----- */
+// OpeningBook.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/17
+// Version: v1.1
+/* ----- ----- ----- ----- */
+
+#include "OpeningBook.h"
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <string_view>
+
+#include "core/logging/AppLogger.h"
+
+namespace {
+
+constexpr std::string_view BOOK_MAGIC = "MEOB";           ///< File signature
+constexpr std::uint32_t BOOK_VERSION = 1;                 ///< Bumped on layout changes
+constexpr std::string_view BOOK_OPERATORS = "+-*/^";      ///< Bit i of an operator mask = BOOK_OPERATORS[i]
+constexpr int MAX_POLICY_VALUE = static_cast<int>(ScoringPolicy::WinChance);  ///< Highest stored policy value
+
+/**
+ * @brief Appends a 32-bit value in little-endian order.
+ */
+void writeU32(std::ofstream& ofs, std::uint32_t value) {
+    char bytes[4];
+    for (int i = 0; i < 4; ++i) bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    ofs.write(bytes, sizeof(bytes));
+}
+
+/**
+ * @brief Reads a 32-bit little-endian value.
+ * @return true if four bytes were read.
+ */
+bool readU32(std::ifstream& ifs, std::uint32_t& value) {
+    unsigned char bytes[4];
+    if (!ifs.read(reinterpret_cast<char*>(bytes), sizeof(bytes))) return false;
+    value = 0;
+    for (int i = 0; i < 4; ++i) value |= static_cast<std::uint32_t>(bytes[i]) << (8 * i);
+    return true;
+}
+
+/**
+ * @brief Reads one byte.
+ */
+bool readU8(std::ifstream& ifs, std::uint8_t& value) {
+    char byte;
+    if (!ifs.get(byte)) return false;
+    value = static_cast<std::uint8_t>(byte);
+    return true;
+}
+
+/**
+ * @brief Reads a fixed-length expression.
+ */
+bool readLine(std::ifstream& ifs, int exprLength, std::string& exprLine) {
+    exprLine.assign(static_cast<size_t>(exprLength), '\0');
+    return static_cast<bool>(ifs.read(exprLine.data(), exprLength));
+}
+
+}  // namespace (end of anonymous)
+
+/**
+ * @brief Returns the second guess after `code`, or nullptr if the feedback is not in the book.
+ *
+ * @param code Feedback of the opening guess.
+ * @return const std::string* Second guess.
+ */
+const std::string* OpeningBook::Entry::findReply(FeedbackCode::Code code) const {
+    auto replyIt = std::lower_bound(repliesList.begin(), repliesList.end(), code,
+        [](const std::pair<FeedbackCode::Code, std::string>& reply, FeedbackCode::Code value) { return reply.first < value; });
+    if (replyIt == repliesList.end() || replyIt->first != code) return nullptr;
+    return &replyIt->second;
+}
+
+/**
+ * @brief Packs an operator set into one bit per operator.
+ *
+ * @param operatorsSet Allowed operators.
+ * @return std::uint8_t Bit i set if `"+-*\/^"[i]` is allowed.
+ */
+std::uint8_t OpeningBook::getOperatorMask(const std::unordered_set<char>& operatorsSet) {
+    std::uint8_t operatorMask = 0;
+    for (size_t i = 0; i < BOOK_OPERATORS.size(); ++i) {
+        if (operatorsSet.count(BOOK_OPERATORS[i])) operatorMask |= static_cast<std::uint8_t>(1u << i);
+    }
+    return operatorMask;
+}
+
+/**
+ * @brief Loads a book file, replacing the current entries.
+ *
+ * <summary>
+ * A missing file is not an error (the book is optional); a malformed file is reported
+ * and ignored as a whole. A reply count is checked against the number of feedback codes
+ * and the bytes left in the file before anything is allocated for it.
+ * </summary>
+ *
+ * @param filePath Book file.
+ * @return true if the file was read; false if it is missing or malformed (the book is then empty).
+ */
+bool OpeningBook::load(const std::string& filePath) {
+    entriesList.clear();
+
+    std::ifstream ifs(filePath, std::ios::binary | std::ios::ate);
+    if (!ifs.is_open()) {
+        AppLogger::Debug(std::format("Opening book not found: {}", filePath));
+        return false;
+    }
+    const std::streamoff fileSize = ifs.tellg();
+    ifs.seekg(0);
+
+    auto failLoad = [&](std::string_view reason) {
+        AppLogger::Error(std::format("Opening book {} ignored: {}.", filePath, reason));
+        entriesList.clear();
+        return false;
+    };
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t entryCount = 0;
+    if (!ifs.read(magic, sizeof(magic)) || std::string_view(magic, sizeof(magic)) != BOOK_MAGIC)
+        return failLoad("not an opening book");
+    if (!readU32(ifs, version) || version != BOOK_VERSION)
+        return failLoad(std::format("unsupported version {}", version));
+    if (!readU32(ifs, entryCount))
+        return failLoad("truncated header");
+
+    for (std::uint32_t entryIndex = 0; entryIndex < entryCount; ++entryIndex) {
+        Entry entry;
+        std::uint8_t exprLength = 0;
+        std::uint8_t policyValue = 0;
+        std::uint32_t replyCount = 0;
+        if (!readU8(ifs, exprLength) || !readU8(ifs, entry.operatorMask) || !readU8(ifs, policyValue))
+            return failLoad("truncated entry");
+        if (exprLength == 0 || exprLength > FeedbackCode::MAX_LENGTH || policyValue > MAX_POLICY_VALUE)
+            return failLoad("invalid entry key");
+        entry.exprLength = exprLength;
+        entry.scoringPolicy = static_cast<ScoringPolicy>(policyValue);
+        if (!readLine(ifs, entry.exprLength, entry.openingLine) || !readU32(ifs, replyCount))
+            return failLoad("truncated entry");
+        if (replyCount > FeedbackCode::getCodeCount(entry.exprLength))
+            return failLoad(std::format("{} replies for {} feedback codes", replyCount, FeedbackCode::getCodeCount(entry.exprLength)));
+        const std::uint64_t replySize = sizeof(std::uint32_t) + exprLength;
+        if (replyCount * replySize > static_cast<std::uint64_t>(fileSize - ifs.tellg()))
+            return failLoad("truncated replies");
+
+        entry.repliesList.resize(replyCount);
+        for (auto& [code, replyLine] : entry.repliesList) {
+            if (!readU32(ifs, code) || !readLine(ifs, entry.exprLength, replyLine))
+                return failLoad("truncated replies");
+        }
+        entriesList.push_back(std::move(entry));
+    }
+
+    AppLogger::Debug(std::format("Loaded opening book {} ({} entries).", filePath, entriesList.size()));
+    return true;
+}
+
+/**
+ * @brief Writes every entry to a book file.
+ *
+ * @param filePath Book file, overwritten.
+ * @return true on success.
+ */
+bool OpeningBook::save(const std::string& filePath) const {
+    std::ofstream ofs(filePath, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+        AppLogger::Error(std::format("Failed to write opening book: {}", filePath));
+        return false;
+    }
+
+    ofs.write(BOOK_MAGIC.data(), static_cast<std::streamsize>(BOOK_MAGIC.size()));
+    writeU32(ofs, BOOK_VERSION);
+    writeU32(ofs, static_cast<std::uint32_t>(entriesList.size()));
+    for (const Entry& entry : entriesList) {
+        ofs.put(static_cast<char>(entry.exprLength));
+        ofs.put(static_cast<char>(entry.operatorMask));
+        ofs.put(static_cast<char>(entry.scoringPolicy));
+        ofs.write(entry.openingLine.data(), entry.exprLength);
+        writeU32(ofs, static_cast<std::uint32_t>(entry.repliesList.size()));
+        for (const auto& [code, replyLine] : entry.repliesList) {
+            writeU32(ofs, code);
+            ofs.write(replyLine.data(), entry.exprLength);
+        }
+    }
+    return static_cast<bool>(ofs);
+}
+
+/**
+ * @brief Looks up the entry of a configuration.
+ *
+ * @param exprLength Expression length.
+ * @param operatorsSet Allowed operators.
+ * @param scoringPolicy Policy the suggestions are ranked with.
+ * @return const Entry* Entry, or nullptr if the book does not cover the key.
+ */
+const OpeningBook::Entry* OpeningBook::find(
+    int exprLength,
+    const std::unordered_set<char>& operatorsSet,
+    ScoringPolicy scoringPolicy
+) const {
+    const std::uint8_t operatorMask = getOperatorMask(operatorsSet);
+    for (const Entry& entry : entriesList) {
+        if (entry.exprLength == exprLength && entry.operatorMask == operatorMask && entry.scoringPolicy == scoringPolicy)
+            return &entry;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Adds an entry, replacing the entry with the same key if any.
+ *
+ * @param entry Entry to store; its replies are sorted by code.
+ */
+void OpeningBook::add(Entry entry) {
+    std::sort(entry.repliesList.begin(), entry.repliesList.end());
+    for (Entry& existingEntry : entriesList) {
+        if (existingEntry.exprLength == entry.exprLength && existingEntry.operatorMask == entry.operatorMask
+            && existingEntry.scoringPolicy == entry.scoringPolicy) {
+            existingEntry = std::move(entry);
+            return;
+        }
+    }
+    entriesList.push_back(std::move(entry));
+}
@@ -0,0 +1,97 @@
+/* ----- ----- ----- ----- */
+// OpeningBook.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "FeedbackCode.h"
+#include "ScoringPolicy.h"
+
+/**
+ * @class OpeningBook
+ * @brief Precomputed first guess, and best second guess per first feedback, for each game configuration.
+ *
+ * <summary>
+ * Round one is always played without information, so its best guess only depends on the
+ * configuration (expression length, operator set) and the scoring policy. The book stores,
+ * for each such key:
+ * - the opening guess, scored against every valid expression;
+ * - for every feedback the opening can produce, the best second guess against the
+ *   expressions left by that feedback.
+ * Entries are computed offline (`--build-book`) and looked up by `RoundManager` at game start.
+ *
+ * File layout (little endian):
+ *     "MEOB" | version u32 | entry count u32 | entries...
+ *     entry: length u8 | operator mask u8 | policy u8 | opening (length bytes)
+ *            | reply count u32 | replies sorted by code: code u32 | guess (length bytes)
+ * </summary>
+ */
+class OpeningBook {
+public:
+    /**
+     * @struct Entry
+     * @brief Opening and replies of one (length, operator set, policy) key.
+     */
+    struct Entry {
+        int exprLength = 0;                ///< Expression length
+        std::uint8_t operatorMask = 0;     ///< Operators, see `getOperatorMask`
+        ScoringPolicy scoringPolicy = ScoringPolicy::Entropy;  ///< Policy the entry was computed with
+        std::string openingLine;           ///< Best first guess
+        std::vector<std::pair<FeedbackCode::Code, std::string>> repliesList;  ///< Best second guess per feedback, sorted by code
+
+        /**
+         * @brief Returns the second guess after `code`, or nullptr if the feedback is not in the book.
+         */
+        const std::string* findReply(FeedbackCode::Code code) const;
+    };
+
+    /**
+     * @brief Packs an operator set into one bit per operator ('+', '-', '*', '/', '^').
+     */
+    static std::uint8_t getOperatorMask(const std::unordered_set<char>& operatorsSet);
+
+    /**
+     * @brief Loads a book file, replacing the current entries.
+     *
+     * @param filePath Book file.
+     * @return true if the file was read; false if it is missing or malformed (the book is then empty).
+     */
+    bool load(const std::string& filePath);
+
+    /**
+     * @brief Writes every entry to a book file.
+     *
+     * @param filePath Book file, overwritten.
+     * @return true on success.
+     */
+    bool save(const std::string& filePath) const;
+
+    /**
+     * @brief Looks up the entry of a configuration.
+     * @return const Entry* Entry, or nullptr if the book does not cover the key.
+     */
+    const Entry* find(int exprLength, const std::unordered_set<char>& operatorsSet, ScoringPolicy scoringPolicy) const;
+
+    /**
+     * @brief Adds an entry, replacing the entry with the same key if any.
+     */
+    void add(Entry entry);
+
+    /**
+     * @brief Number of entries.
+     */
+    size_t size() const { return entriesList.size(); }
+
+private:
+    std::vector<Entry> entriesList;  ///< Every entry (a few hundred at most, searched linearly)
+};
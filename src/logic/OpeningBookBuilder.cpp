@@ -0,0 +1,153 @@
+/* ----- ----- ----- ----- */
+// OpeningBookBuilder.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/17
+// Version: v1.2
+/* ----- ----- ----- ----- */
+
+#include "OpeningBookBuilder.h"
+#include <chrono>
+#include <format>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ExpressionValidator.h"
+#include "GuessSuggester.h"
+#include "GuessUniverse.h"
+#include "SurvivorSet.h"
+#include "core/logging/AppLogger.h"
+
+namespace OpeningBookBuilder {
+
+namespace {
+
+constexpr char OPTIONAL_OPERATORS[] = { '-', '*', '/', '^' };  ///< '+' is always part of the game
+constexpr size_t OPTIONAL_OPERATOR_COUNT = sizeof(OPTIONAL_OPERATORS);
+
+}  // namespace (end of anonymous)
+
+/**
+ * @brief Computes the book entry of one configuration.
+ *
+ * <summary>
+ * Groups of one or two expressions are answered with their first expression: guessing
+ * a possible answer is never worse there. Larger groups are scored with
+ * `GuessSuggester::suggestFromUniverse`.
+ * </summary>
+ *
+ * @param exprLength Expression length.
+ * @param operatorsSet Allowed operators.
+ * @param scoringPolicy How guesses are ranked.
+ * @param maxGuessCount Most guesses scored per pass (0 = the whole universe).
+ * @param maxEvaluatedCount Most LHS evaluated to build the universe (0 = no limit).
+ * @param[out] isOverLimit Set to true if the universe needs more than `maxEvaluatedCount` evaluations (optional).
+ * @return std::optional<OpeningBook::Entry> Entry, or nothing if the configuration has no valid expression or is over the limit.
+ */
+std::optional<OpeningBook::Entry> computeEntry(
+    int exprLength,
+    const std::unordered_set<char>& operatorsSet,
+    ScoringPolicy scoringPolicy,
+    size_t maxGuessCount,
+    size_t maxEvaluatedCount,
+    bool* isOverLimit
+) {
+    ExpressionValidator validator;
+    validator.setValidOps(operatorsSet);
+    GuessUniverse guessUniverse;
+    const bool isBuilt = guessUniverse.build(exprLength, operatorsSet, validator, maxEvaluatedCount);
+    if (isOverLimit) *isOverLimit = !isBuilt;
+    if (guessUniverse.empty()) return std::nullopt;
+
+    const CandidatePool& universePool = guessUniverse.getPool();
+    GuessSuggester guessSuggester;
+    guessSuggester.reset(universePool);
+
+    // Step 1: Opening, every expression being a possible answer
+    const SurvivorSet universeSet = SurvivorSet::fromRange(universePool.size());
+    std::vector<GuessScore> openingScoresList = guessSuggester.suggest(universeSet, 1, maxGuessCount, scoringPolicy);
+    if (openingScoresList.empty()) return std::nullopt;
+
+    OpeningBook::Entry entry;
+    entry.exprLength = exprLength;
+    entry.operatorMask = OpeningBook::getOperatorMask(operatorsSet);
+    entry.scoringPolicy = scoringPolicy;
+    entry.openingLine = std::string(universePool.view(openingScoresList.front().handle));
+
+    // Step 2: Universe split by the opening's feedback (handles stay sorted)
+    std::map<FeedbackCode::Code, std::vector<CandidateHandle>> groupsMap;
+    for (CandidateHandle answerHandle = 0; answerHandle < universePool.size(); ++answerHandle)
+        groupsMap[FeedbackCode::compute(entry.openingLine, universePool.view(answerHandle))].push_back(answerHandle);
+
+    // Step 3: Best second guess per group
+    const FeedbackCode::Code allGreenCode = FeedbackCode::getAllGreenCode(exprLength);
+    for (const auto& [code, groupHandlesList] : groupsMap) {
+        if (code == allGreenCode) continue;  // Solved by the opening
+        if (groupHandlesList.size() <= 2) {
+            entry.repliesList.emplace_back(code, std::string(universePool.view(groupHandlesList.front())));
+            continue;
+        }
+        std::vector<GuessScore> replyScoresList = guessSuggester.suggestFromUniverse(
+            SurvivorSet::fromSortedHandles(groupHandlesList), universePool, guessUniverse, 1, maxGuessCount, scoringPolicy);
+        if (!replyScoresList.empty())
+            entry.repliesList.emplace_back(code, std::string(universePool.view(replyScoresList.front().handle)));
+    }
+    return entry;
+}
+
+/**
+ * @brief Fills the book for every configuration of the requested length range.
+ *
+ * @param solverOptions Book path, length range, policy, guess limit and universe limit.
+ * @return true if the book was written.
+ */
+bool build(const SolverOptions& solverOptions) {
+    if (solverOptions.openingBookPath.empty()) {
+        AppLogger::Error("Opening book: no output file, pass --book=<path>.");
+        return false;
+    }
+
+    OpeningBook openingBook;
+    openingBook.load(solverOptions.openingBookPath);  // Resume: keep entries already computed
+
+    for (int exprLength = solverOptions.bookMinLength; exprLength <= solverOptions.bookMaxLength; ++exprLength) {
+        for (size_t subsetMask = 0; subsetMask < (1u << OPTIONAL_OPERATOR_COUNT); ++subsetMask) {
+            std::unordered_set<char> operatorsSet = { '+' };
+            std::string operatorsText = "+";
+            for (size_t i = 0; i < OPTIONAL_OPERATOR_COUNT; ++i) {
+                if (subsetMask & (1u << i)) {
+                    operatorsSet.insert(OPTIONAL_OPERATORS[i]);
+                    operatorsText += OPTIONAL_OPERATORS[i];
+                }
+            }
+            if (openingBook.find(exprLength, operatorsSet, solverOptions.scoringPolicy)) continue;
+
+            auto startTime = std::chrono::steady_clock::now();
+            bool isOverLimit = false;
+            std::optional<OpeningBook::Entry> entry = computeEntry(exprLength, operatorsSet, solverOptions.scoringPolicy,
+                solverOptions.suggestionMaxGuesses, solverOptions.universeMaxEvaluations, &isOverLimit);
+            auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+            if (isOverLimit) {
+                AppLogger::Warn(std::format("Opening book: {}{} needs more than {} evaluations (--universe-limit), skipped.",
+                    exprLength, operatorsText, solverOptions.universeMaxEvaluations));
+                continue;
+            }
+            if (!entry) {
+                AppLogger::Info(std::format("Opening book: {}{} has no valid expression, skipped.", exprLength, operatorsText));
+                continue;
+            }
+
+            AppLogger::Info(std::format("Opening book: {}{} -> {} ({} replies, {} ms).",
+                exprLength, operatorsText, entry->openingLine, entry->repliesList.size(), elapsedMs));
+            openingBook.add(std::move(*entry));
+            if (!openingBook.save(solverOptions.openingBookPath)) return false;
+        }
+    }
+
+    AppLogger::Info(std::format("Opening book {} holds {} entries.", solverOptions.openingBookPath, openingBook.size()));
+    return true;
+}
+
+}  // namespace OpeningBookBuilder
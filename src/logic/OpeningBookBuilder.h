@@ -0,0 +1,68 @@
+/* ----- ----- ----- ----- */
+// OpeningBookBuilder.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/17
+// Version: v1.2
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <optional>
+#include <unordered_set>
+
+#include "OpeningBook.h"
+#include "SolverOptions.h"
+
+/**
+ * @namespace OpeningBookBuilder
+ * @brief Offline computation of `OpeningBook` entries (`--build-book`).
+ *
+ * <summary>
+ * Every configuration is solved against its whole universe of valid expressions
+ * (`GuessUniverse`), with every expression an equally likely answer:
+ * 1. The opening is the best guess over the whole universe.
+ * 2. The universe is split by the opening's feedback; for each group, the best second
+ *    guess is drawn from the universe and scored against that group.
+ * Both passes score at most `SolverOptions::suggestionMaxGuesses` guesses, so the cost
+ * stays near `guesses x universe size` per configuration. Configurations whose universe
+ * needs more than `SolverOptions::universeMaxEvaluations` evaluations are skipped.
+ * </summary>
+ */
+namespace OpeningBookBuilder {
+
+    /**
+     * @brief Computes the book entry of one configuration.
+     *
+     * @param exprLength Expression length.
+     * @param operatorsSet Allowed operators.
+     * @param scoringPolicy How guesses are ranked.
+     * @param maxGuessCount Most guesses scored per pass (0 = the whole universe).
+     * @param maxEvaluatedCount Most LHS evaluated to build the universe (0 = no limit).
+     * @param[out] isOverLimit Set to true if the universe needs more than `maxEvaluatedCount` evaluations (optional).
+     * @return std::optional<OpeningBook::Entry> Entry, or nothing if the configuration has no valid expression or is over the limit.
+     */
+    std::optional<OpeningBook::Entry> computeEntry(
+        int exprLength,
+        const std::unordered_set<char>& operatorsSet,
+        ScoringPolicy scoringPolicy,
+        size_t maxGuessCount,
+        size_t maxEvaluatedCount,
+        bool* isOverLimit = nullptr
+    );
+
+    /**
+     * @brief Fills the book at `SolverOptions::openingBookPath` for every length in
+     *        `[bookMinLength, bookMaxLength]` and every operator set containing '+'.
+     *
+     * <summary>
+     * Entries already in the file are kept and skipped, and the file is saved after each new
+     * entry, so an interrupted build resumes where it stopped.
+     * </summary>
+     *
+     * @param solverOptions Book path, length range, policy, guess limit and universe limit.
+     * @return true if the book was written (false without a book path).
+     */
+    bool build(const SolverOptions& solverOptions);
+
+}  // namespace OpeningBookBuilder
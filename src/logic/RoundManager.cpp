@@ -3,12 +3,16 @@
 // Do not distribute or modify
 // Author: DragonTaki (https://github.com/DragonTaki)
 // Create Date: 2025/10/17
-// Update Date: 2025/10/17
-// Version: v1.0
+// Update Date: 2026/10/17
+// Version: v1.6
 /* ----- ----- ----- ----- */
 
 #include "RoundManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -16,13 +20,47 @@
 
 #include "CandidateGenerator.h"
 #include "Constraint.h"
+#include "EndgameSolver.h"
 #include "ExpressionValidator.h"
+#include "FeedbackCode.h"
 #include "GameRoundState.h"
+#include "GuessSuggester.h"
+#include "SpeculativePartition.h"
 #include "core/input/InputExpressionLine.h"
 #include "core/input/InputExpressionSpec.h"
 #include "core/input/InputUtils.h"
 #include "core/logging/AppLogger.h"
+#include "util/AllocationTracker.h"
 #include "util/ConsoleUtils.h"
+#include "util/SolverMetrics.h"
+#include "util/TraceRecorder.h"
+
+namespace {
+
+/**
+ * @brief Milliseconds left before a suggestion deadline.
+ *
+ * @param deadline End of the budget (`time_point::max()` without one).
+ * @return size_t 0 without a budget; otherwise at least 1, so a late pass still stays budgeted.
+ */
+size_t getRemainingMs(std::chrono::steady_clock::time_point deadline) {
+    if (deadline == std::chrono::steady_clock::time_point::max()) return 0;
+    const long long remainingMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+    return static_cast<size_t>((std::max)(1LL, remainingMs));
+}
+
+}  // namespace (end of anonymous)
+
+/**
+ * @brief Creates a round manager with the given optional solver features.
+ *
+ * @param solverOptions Options applied to every round of the session.
+ */
+RoundManager::RoundManager(const SolverOptions& solverOptions) : solverOptions(solverOptions) {
+    if (!solverOptions.openingBookPath.empty())
+        openingBook.load(solverOptions.openingBookPath);
+}
 
 /**
  * @brief Initializes a new round while keeping existing game configuration.
@@ -42,8 +80,10 @@ void RoundManager::initializeRound(
     gameRoundState.exprLength = exprLength;
     gameRoundState.operatorsSet = operatorsSet;
 
+    speculativePartition.cancel();
     constraintsMap.clear();
-    currentCandidatesList.clear();
+    currentSurvivors.clear();
+    guessSuggester.clear();
 
     AppLogger::Debug("Initialized new round.");
 }
@@ -56,8 +96,10 @@ void RoundManager::initializeRound(
  */
 void RoundManager::resetRound() {
     gameRoundState.resetRoundData();
+    speculativePartition.cancel();
     constraintsMap.clear();
-    currentCandidatesList.clear();
+    currentSurvivors.clear();
+    guessSuggester.clear();
 
     AppLogger::Info("Round has been reset.");
 }
@@ -69,9 +111,15 @@ void RoundManager::resetRound() {
  * operators, constraints, and candidate list.
  */
 void RoundManager::resetGame() {
+    if (!gameRoundState.roundHistory.empty()) {  // Report once per played game, cumulative over the session
+        sessionReport.log();
+        ++sessionGameIndex;
+    }
     gameRoundState.resetGameData();
+    speculativePartition.cancel();
     constraintsMap.clear();
-    currentCandidatesList.clear();
+    currentSurvivors.clear();
+    guessSuggester.clear();
 
     AppLogger::Info("Game has been fully reset.");
 }
@@ -147,8 +195,14 @@ bool RoundManager::readPlayerInput(std::string& exprLine, std::string& exprColor
     if (!exprReader.readExpression(exprLine, gameRoundState.exprLength, validator, handleExprSpecial, exprPrompt))
         return false;
 
-    if (!exprReader.readColorFeedback(exprColorLine, gameRoundState.exprLength, handleColorSpecial, colorPrompt))
+    // Split the survivors by every possible feedback while the player types the colors
+    if (roundIndex > 0 && solverOptions.speculateFeedback)
+        speculativePartition.start(gameRoundState.candidatePool, currentSurvivors, exprLine);
+
+    if (!exprReader.readColorFeedback(exprColorLine, gameRoundState.exprLength, handleColorSpecial, colorPrompt)) {
+        speculativePartition.cancel();
         return false;
+    }
 
     return true;
 }
@@ -178,6 +232,9 @@ bool RoundManager::processRoundInput() {
 
             initializeRound(exprLength, operatorsSet);
             validator.setValidOps(gameRoundState.operatorsSet);
+            SolverMetrics::add(SolverMetrics::Counter::SessionsStarted);
+            printBookOpening();
+            prepareGuessUniverse();
         }
 
         // Read expression and feedback input
@@ -186,31 +243,95 @@ bool RoundManager::processRoundInput() {
 
         // Save this round's data to history
         gameRoundState.roundHistory.push_back(currentRound);
+        const auto roundStartTime = std::chrono::steady_clock::now();
+        auto phaseStartTime = roundStartTime;
+        auto takePhaseUs = [&phaseStartTime]() {
+            const auto phaseEndTime = std::chrono::steady_clock::now();
+            const auto phaseUs = std::chrono::duration_cast<std::chrono::microseconds>(phaseEndTime - phaseStartTime).count();
+            phaseStartTime = phaseEndTime;
+            return static_cast<std::uint64_t>(phaseUs);
+        };
+        SessionReport::RoundTiming roundTiming;
+        roundTiming.gameIndex = sessionGameIndex;
+        roundTiming.roundIndex = gameRoundState.roundHistory.size();
+        roundTiming.exprLine = currentRound.exprLine;
 
         // Update constraint map using current feedback
+        AllocationTracker::Meter constraintsMeter;
         updateConstraint(constraintsMap, currentRound.exprLine, currentRound.exprColorLine);
+        const AllocationTracker::Counts constraintsAllocations = constraintsMeter.elapsed();
+        roundTiming.constraintsUs = takePhaseUs();
 
         // Generate or filter candidate list
+        AllocationTracker::Meter candidatesMeter;
         bool firstRoundInput = (gameRoundState.roundHistory.size() == 1);
         if (firstRoundInput) {
             CandidateGenerator generator(validator);
-            gameRoundState.initialCandidatesList = generator.generate(
+            generator.setStatsEnabled(solverOptions.logGenerationStats);
+            gameRoundState.candidatePool = generator.generatePool(
                 gameRoundState.exprLength,
                 gameRoundState.operatorsSet,
                 {currentRound.exprLine},
                 {currentRound.exprColorLine},
                 constraintsMap
             );
-            currentCandidatesList = gameRoundState.initialCandidatesList;
+            currentSurvivors = SurvivorSet::fromRange(gameRoundState.candidatePool.size());
+            SolverMetrics::add(SolverMetrics::Counter::CandidatesGenerated, gameRoundState.candidatePool.size());
+
+            if (solverOptions.useCandidateTrie) {
+                gameRoundState.candidateTrie = CandidateTrie::build(gameRoundState.candidatePool);
+                AppLogger::Debug(std::format("Candidate trie: {} nodes, {} leaves, {} bytes (pool {} bytes).",
+                    gameRoundState.candidateTrie.getNodeCount(), gameRoundState.candidateTrie.size(),
+                    gameRoundState.candidateTrie.getMemoryBytes(), gameRoundState.candidatePool.getMemoryBytes()));
+            }
+            if (solverOptions.suggestionCount > 0) {
+                guessSuggester.reset(gameRoundState.candidatePool);
+                guessSuggester.setExactAnswerLimit(solverOptions.exactScoringMaxSurvivors);
+            }
+        } else if (speculativePartition.take(currentRound.exprLine,
+                FeedbackCode::fromColorLine(currentRound.exprColorLine), currentSurvivors)) {
+            SolverMetrics::add(SolverMetrics::Counter::SpeculationHits);
         } else {
-            currentCandidatesList = validator.filterExpressions(currentCandidatesList, constraintsMap);
+            if (solverOptions.speculateFeedback) SolverMetrics::add(SolverMetrics::Counter::SpeculationMisses);
+            filterCurrentCandidates();
         }
+        gameRoundState.survivorsHistory.push_back(currentSurvivors);
+        const AllocationTracker::Counts candidatesAllocations = candidatesMeter.elapsed();
+        roundTiming.isGenerated = firstRoundInput;
+        roundTiming.candidatesUs = takePhaseUs();
+        SolverMetrics::observe(firstRoundInput ? SolverMetrics::Histogram::GenerateSeconds : SolverMetrics::Histogram::FilterSeconds,
+            roundTiming.candidatesUs);
+        SolverMetrics::observe(SolverMetrics::Histogram::RoundSurvivors, currentSurvivors.size());
 
         // Print result candidates
-        if (currentCandidatesList.empty())
+        AllocationTracker::Counts printAllocations;
+        AllocationTracker::Counts suggestionsAllocations;
+        if (currentSurvivors.empty())
             AppLogger::Prompt("No solution.", LogColor::Red);
         else {
-            ConsoleUtils::printCandidatesInline(currentCandidatesList);
+            AllocationTracker::Meter printMeter;
+            ConsoleUtils::printCandidatesInline(gameRoundState.candidatePool.getViews(currentSurvivors.toSortedHandles()));
+            printAllocations = printMeter.elapsed();
+            roundTiming.printUs = takePhaseUs();
+            AllocationTracker::Meter suggestionsMeter;
+            printGuessSuggestions();
+            suggestionsAllocations = suggestionsMeter.elapsed();
+            roundTiming.suggestionsUs = takePhaseUs();
+        }
+        roundTiming.totalUs = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - roundStartTime).count());
+        sessionReport.recordRound(roundTiming);
+        SolverMetrics::add(SolverMetrics::Counter::RoundsProcessed);
+
+        if (solverOptions.logAllocationStats) {
+            const double candidateCount = static_cast<double>((std::max)(size_t{1}, currentSurvivors.size()));
+            AppLogger::Debug(std::format(
+                "Allocations: constraints {} ({} B), {} {} ({} B, {:.1f} per candidate), print {} ({} B), suggestions {} ({} B).",
+                constraintsAllocations.allocationCount, constraintsAllocations.allocatedBytes,
+                firstRoundInput ? "generate" : "filter", candidatesAllocations.allocationCount, candidatesAllocations.allocatedBytes,
+                static_cast<double>(candidatesAllocations.allocationCount) / candidateCount,
+                printAllocations.allocationCount, printAllocations.allocatedBytes,
+                suggestionsAllocations.allocationCount, suggestionsAllocations.allocatedBytes));
         }
 
         return true;
@@ -224,13 +345,15 @@ bool RoundManager::processRoundInput() {
  * @brief Rolls back the game state by removing the most recent round.
  *
  * This function removes the last round record from history, rebuilds the constraint
- * map from all remaining previous rounds, and recalculates the candidate list.
+ * map from all remaining previous rounds, and restores the previous survivor set from the undo stack.
  * It is primarily triggered by the `"undo"` command from user input.
  *
  * @return `true` if rollback succeeded; `false` if there was no round to rollback.
  */
 bool RoundManager::rollback()
 {
+    TraceRecorder::Span traceSpan("rollback");
+    speculativePartition.cancel();  // Its survivors are about to change
     if (gameRoundState.roundHistory.empty()) {
         AppLogger::Prompt("No previous round to rollback.", LogColor::Red);
         return false;
@@ -238,6 +361,8 @@ bool RoundManager::rollback()
 
     // Remove the most recent round record
     gameRoundState.roundHistory.pop_back();
+    if (!gameRoundState.survivorsHistory.empty())
+        gameRoundState.survivorsHistory.pop_back();
     AppLogger::Prompt("Rolled back one round.", LogColor::Magenta);
 
     // Rebuild constraints from remaining rounds
@@ -247,21 +372,203 @@ bool RoundManager::rollback()
         updateConstraint(constraintsMap, record.exprLine, record.exprColorLine);
     }
 
-    // Rebuild candidate list
-    if (gameRoundState.roundHistory.empty()) {
-        // If no previous rounds, revert to initial candidates
-        currentCandidatesList = gameRoundState.initialCandidatesList;
-    } else {
-        // Otherwise filter from the initial candidate pool
-        currentCandidatesList = validator.filterExpressions(
-            gameRoundState.initialCandidatesList,
-            constraintsMap
-        );
-    }
+    // Restore the survivors of the previous round from the undo stack (no re-filtering)
+    if (gameRoundState.survivorsHistory.empty())
+        currentSurvivors = SurvivorSet::fromRange(gameRoundState.candidatePool.size());
+    else
+        currentSurvivors = gameRoundState.survivorsHistory.back();
 
     // Display current constraint state and filtered candidates
     printConstraint(constraintsMap);
-    ConsoleUtils::printCandidatesInline(currentCandidatesList);
+    ConsoleUtils::printCandidatesInline(gameRoundState.candidatePool.getViews(currentSurvivors.toSortedHandles()));
+
+    return true;
+}
+
+/**
+ * @brief Filters the current candidate handles against the active constraint map.
+ *
+ * Walks the candidate trie when it was built for this round (see `SolverOptions`),
+ * otherwise checks every current survivor in parallel. Both give the same survivors in the same order.
+ */
+void RoundManager::filterCurrentCandidates() {
+    if (!gameRoundState.candidateTrie.empty()) {
+        currentSurvivors = validator.filterSurvivorsByTrie(
+            gameRoundState.candidatePool, gameRoundState.candidateTrie, currentSurvivors, constraintsMap);
+        return;
+    }
+    currentSurvivors = validator.filterSurvivors(gameRoundState.candidatePool, currentSurvivors, constraintsMap);
+}
+
+/**
+ * @brief Prints the best next guesses for the current survivors.
+ *
+ * Nothing is printed when suggestions are disabled or when at most one candidate is left.
+ * `--suggest-ms` bounds the whole step: the deadline is taken here, and the endgame
+ * search and the ranking each get what is left of it.
+ */
+void RoundManager::printGuessSuggestions() {
+    if (solverOptions.suggestionCount == 0 || currentSurvivors.size() <= 1 || guessSuggester.empty())
+        return;
+    TraceRecorder::Span traceSpan("suggestGuesses");
+    const std::chrono::steady_clock::time_point deadline = solverOptions.suggestionBudgetMs > 0
+        ? std::chrono::steady_clock::now() + std::chrono::milliseconds(solverOptions.suggestionBudgetMs)
+        : std::chrono::steady_clock::time_point::max();
+
+    // After the book's opening, the book already knows the best reply
+    if (gameRoundState.roundHistory.size() == 1) {
+        const RoundRecord& firstRound = gameRoundState.roundHistory.front();
+        const OpeningBook::Entry* bookEntry =
+            openingBook.find(gameRoundState.exprLength, gameRoundState.operatorsSet, solverOptions.scoringPolicy);
+        const bool isBookOpening = bookEntry && firstRound.exprLine == bookEntry->openingLine;
+        const std::string* replyLine = isBookOpening
+            ? bookEntry->findReply(FeedbackCode::fromColorLine(firstRound.exprColorLine))
+            : nullptr;
+        if (isBookOpening)
+            SolverMetrics::add(replyLine ? SolverMetrics::Counter::BookHits : SolverMetrics::Counter::BookMisses);
+        if (replyLine) {
+            AppLogger::Prompt(std::format("Opening book ({}): play {} next.",
+                getScoringPolicyName(solverOptions.scoringPolicy), *replyLine), LogColor::Cyan);
+            return;
+        }
+    }
 
+    // Guess universe: built at game start (`prepareGuessUniverse`); without it, survivors only
+    const bool useGuessUniverse = solverOptions.useGuessUniverse
+        && guessUniverse.isBuiltFor(gameRoundState.exprLength, gameRoundState.operatorsSet);
+
+    // Few survivors left: the whole rest of the game can be planned exactly
+    if (currentSurvivors.size() <= solverOptions.endgameMaxSurvivors && printEndgameStrategy(useGuessUniverse, deadline))
+        return;
+
+    SuggestionReport suggestionReport;
+    std::vector<GuessScore> guessScoresList = useGuessUniverse
+        ? guessSuggester.suggestFromUniverse(currentSurvivors, gameRoundState.candidatePool, guessUniverse,
+            solverOptions.suggestionCount, solverOptions.universeMaxGuesses, solverOptions.scoringPolicy,
+            getRemainingMs(deadline), &suggestionReport)
+        : guessSuggester.suggest(currentSurvivors,
+            solverOptions.suggestionCount, solverOptions.suggestionMaxGuesses, solverOptions.scoringPolicy,
+            getRemainingMs(deadline), &suggestionReport);
+    const CandidatePool& guessPool = useGuessUniverse ? guessUniverse.getPool() : gameRoundState.candidatePool;
+
+    AppLogger::Prompt(std::format("Suggested next guesses ({}):", getScoringPolicyName(solverOptions.scoringPolicy)), LogColor::Cyan);
+    for (size_t rank = 0; rank < guessScoresList.size(); ++rank) {
+        const GuessScore& guessScore = guessScoresList[rank];
+        AppLogger::Prompt(std::format("  {}. {}  {:.3f} bits, {:.1f} left on average, worst {}, {} groups, {:.1f}% answer",
+            rank + 1, guessPool.view(guessScore.handle),
+            guessScore.entropyBits, guessScore.expectedSize, guessScore.largestBucket, guessScore.bucketCount,
+            guessScore.winChance * 100.0), LogColor::Cyan);
+    }
+    if (suggestionReport.contenderCount > 0) {
+        AppLogger::Prompt(std::format("  (sampled: {} guesses estimated on {} of {} survivors, {} rescored exactly, {:.0f}% confident in the first guess)",
+            suggestionReport.scoredGuessCount, suggestionReport.sampledCount, suggestionReport.answerCount,
+            suggestionReport.contenderCount, suggestionReport.confidence * 100.0), LogColor::Gray);
+    }
+    else if (!suggestionReport.isExact) {
+        AppLogger::Prompt(std::format("  (time budget: {} guesses ranked on {} of {} survivors, {:.0f}% confident in the first guess)",
+            suggestionReport.scoredGuessCount, suggestionReport.sampledCount, suggestionReport.answerCount,
+            suggestionReport.confidence * 100.0), LogColor::Gray);
+    }
+    AppLogger::Debug(std::format("Scored {} guesses for {} survivors in {} ms ({} stage(s)).", suggestionReport.scoredGuessCount,
+        currentSurvivors.size(), suggestionReport.elapsedMs, suggestionReport.stageCount));
+}
+
+/**
+ * @brief Prints the exact optimal strategy for the current survivors.
+ *
+ * <summary>
+ * Every survivor may be played. With the guess universe, the best universe guesses
+ * are added as probes and the strategy refers to the universe pool. The minimax policy
+ * minimises the worst case, every other policy the average number of guesses.
+ * Under a suggestion budget, the probes and the search share what is left of it, and
+ * the search never runs past `endgameTimeMs`.
+ * </summary>
+ *
+ * @param useGuessUniverse True to also consider the best universe guesses as probes.
+ * @param deadline End of the suggestion budget (`time_point::max()` without one).
+ * @return true if a strategy was found within the time budget and printed.
+ */
+bool RoundManager::printEndgameStrategy(bool useGuessUniverse, std::chrono::steady_clock::time_point deadline) {
+    const CandidatePool* solvePool = &gameRoundState.candidatePool;
+    std::vector<CandidateHandle> answerHandlesList = currentSurvivors.toSortedHandles();
+    std::vector<CandidateHandle> probeHandlesList;
+    if (useGuessUniverse) {
+        solvePool = &guessUniverse.getPool();
+        for (CandidateHandle& answerHandle : answerHandlesList) {
+            if (!guessUniverse.find(gameRoundState.candidatePool.view(answerHandle), answerHandle)) return false;
+        }
+        for (const GuessScore& guessScore : guessSuggester.suggestFromUniverse(currentSurvivors, gameRoundState.candidatePool,
+                guessUniverse, EndgameSolver::UNIVERSE_PROBE_COUNT, solverOptions.universeMaxGuesses, solverOptions.scoringPolicy,
+                getRemainingMs(deadline)))
+            probeHandlesList.push_back(guessScore.handle);
+    }
+
+    const size_t remainingMs = getRemainingMs(deadline);
+    const size_t searchTimeMs = remainingMs > 0 ? (std::min)(solverOptions.endgameTimeMs, remainingMs) : solverOptions.endgameTimeMs;
+    const bool isWorstCase = (solverOptions.scoringPolicy == ScoringPolicy::Minimax);
+    std::optional<EndgameTree> endgameTree = endgameSolver.solve(*solvePool, answerHandlesList, probeHandlesList,
+        isWorstCase ? EndgameSolver::Objective::WorstGuesses : EndgameSolver::Objective::ExpectedGuesses,
+        static_cast<long long>(searchTimeMs));
+    const EndgameSolver::SearchStats& searchStats = endgameSolver.getStats();
+    AppLogger::Debug(std::format("Endgame search: {} subsets, {} memo hits, {} memoised, {} ms{}.",
+        searchStats.nodeCount, searchStats.memoHitCount, searchStats.memoEntryCount, searchStats.elapsedMs,
+        searchStats.isTimedOut ? " (time budget reached)" : ""));
+    SolverMetrics::add(SolverMetrics::Counter::EndgameMemoHits, searchStats.memoHitCount);
+    SolverMetrics::add(SolverMetrics::Counter::EndgameMemoMisses, searchStats.nodeCount);
+    if (!endgameTree) return false;
+
+    AppLogger::Prompt(std::format("Endgame ({}): play {}; {:.3f} guesses on average, at most {}.",
+        isWorstCase ? "worst case" : "average", solvePool->view(endgameTree->nodesList.front().guessHandle),
+        endgameTree->getExpectedGuesses(), endgameTree->worstGuesses), LogColor::Cyan);
+    if (solverOptions.printEndgameTree) {
+        for (const std::string& treeLine : endgameTree->toLines(*solvePool))
+            AppLogger::Prompt("  " + treeLine, LogColor::Cyan);
+    }
+    if (!solverOptions.endgameTreePath.empty())
+        endgameTree->save(solverOptions.endgameTreePath, *solvePool);
     return true;
 }
+
+/**
+ * @brief Prints the opening book's first guess for the current configuration, if any.
+ */
+void RoundManager::printBookOpening() const {
+    if (solverOptions.suggestionCount == 0) return;
+
+    const OpeningBook::Entry* bookEntry =
+        openingBook.find(gameRoundState.exprLength, gameRoundState.operatorsSet, solverOptions.scoringPolicy);
+    if (bookEntry) {
+        AppLogger::Prompt(std::format("Opening book ({}): start with {}.",
+            getScoringPolicyName(solverOptions.scoringPolicy), bookEntry->openingLine), LogColor::Cyan);
+    }
+}
+
+/**
+ * @brief Builds the guess universe of the new configuration, before the first guess is typed.
+ *
+ * <summary>
+ * The universe only depends on the configuration, so it is built once at game start
+ * instead of inside a round, and kept for later games of the same configuration. A
+ * configuration over `SolverOptions::universeMaxEvaluations` is refused with a warning
+ * (once per configuration); its suggestions then come from the survivors alone.
+ * </summary>
+ */
+void RoundManager::prepareGuessUniverse() {
+    if (!solverOptions.useGuessUniverse || solverOptions.suggestionCount == 0) return;
+
+    const bool isUniverseBuilt = guessUniverse.isBuiltFor(gameRoundState.exprLength, gameRoundState.operatorsSet);
+    SolverMetrics::add(isUniverseBuilt ? SolverMetrics::Counter::UniverseHits : SolverMetrics::Counter::UniverseMisses);
+    if (isUniverseBuilt || guessUniverse.isOverLimitFor(gameRoundState.exprLength, gameRoundState.operatorsSet)) return;
+
+    TraceRecorder::Span traceSpan("buildGuessUniverse");
+    auto buildStartTime = std::chrono::steady_clock::now();
+    if (!guessUniverse.build(gameRoundState.exprLength, gameRoundState.operatorsSet, validator, solverOptions.universeMaxEvaluations)) {
+        AppLogger::Warn(std::format("Guess universe skipped: length {} needs more than {} evaluations (--universe-limit); "
+            "suggestions come from the survivors.", gameRoundState.exprLength, solverOptions.universeMaxEvaluations));
+        return;
+    }
+    auto buildElapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - buildStartTime).count();
+    AppLogger::Debug(std::format("Built guess universe: {} expressions in {} ms.", guessUniverse.size(), buildElapsedMs));
+    if (!solverOptions.feedbackMatrixDir.empty())
+        guessUniverse.loadFeedbackMatrix(solverOptions.feedbackMatrixDir, static_cast<std::uint64_t>(solverOptions.feedbackMatrixMaxMb) << 20);
+}
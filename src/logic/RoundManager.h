@@ -3,17 +3,27 @@
 // Do not distribute or modify
 // Author: DragonTaki (https://github.com/DragonTaki)
 // Create Date: 2025/10/17
-// Update Date: 2025/10/17
-// Version: v1.0
+// Update Date: 2026/10/17
+// Version: v1.6
 /* ----- ----- ----- ----- */
 
 #pragma once
+#include <chrono>
 #include <unordered_map>
 #include <vector>
 
+#include "CandidatePool.h"
 #include "Constraint.h"
+#include "EndgameSolver.h"
 #include "ExpressionValidator.h"
 #include "GameRoundState.h"
+#include "GuessSuggester.h"
+#include "GuessUniverse.h"
+#include "OpeningBook.h"
+#include "SessionReport.h"
+#include "SolverOptions.h"
+#include "SpeculativePartition.h"
+#include "SurvivorSet.h"
 #include "core/input/InputExpressionLine.h"
 #include "core/input/InputExpressionSpec.h"
 
@@ -27,6 +37,7 @@
  * - Maintaining the current round and game state (`GameRoundState`)
  * - Updating and applying constraints (`Constraint`) for symbol validation
  * - Generating or filtering expression candidates
+ * - Suggesting the next guess (`GuessSuggester`, `OpeningBook`, `EndgameSolver`)
  * - Supporting rollback (undo) and round/game resets
  *
  * The class integrates several components:
@@ -36,6 +47,20 @@
  */
 class RoundManager {
 public:
+    /**
+     * @brief Creates a round manager using the default (reference) solver options.
+     */
+    RoundManager() : RoundManager(SolverOptions{}) {}
+
+    /**
+     * @brief Creates a round manager with the given optional solver features.
+     *
+     * Loads the opening book named by `SolverOptions::openingBookPath`, if any.
+     *
+     * @param solverOptions Options applied to every round of the session.
+     */
+    explicit RoundManager(const SolverOptions& solverOptions);
+
     /**
      * @brief Retrieves the current set of allowed operators for this round.
      * 
@@ -103,13 +128,18 @@ public:
     /**
      * @brief Reverts the game state to the previous round.
      *
-     * Removes the latest round record from history and rebuilds the constraint map
-     * and candidate list from the remaining rounds.
+     * Removes the latest round record from history, rebuilds the constraint map
+     * from the remaining rounds and restores the previous round's survivor set.
      *
      * @return `true` if rollback succeeded, `false` if no previous round existed.
      */
     bool rollback();
 
+    /**
+     * @brief Writes the latency summary of every round of the session so far to the log.
+     */
+    void logSessionReport() const { sessionReport.log(); }
+
     /**
      * @brief Configures the internal expression validator using the current round’s operator set.
      *
@@ -133,12 +163,49 @@ public:
     }
 
 private:
+    /**
+     * @brief Filters `currentSurvivors` against `constraintsMap`, using the trie when available.
+     */
+    void filterCurrentCandidates();
+
+    /**
+     * @brief Prints the best next guesses for `currentSurvivors` (see `SolverOptions::suggestionCount`).
+     */
+    void printGuessSuggestions();
+
+    /**
+     * @brief Prints the exact optimal strategy for `currentSurvivors` (see `SolverOptions::endgameMaxSurvivors`).
+     *
+     * @param useGuessUniverse True to also consider the best universe guesses as probes.
+     * @param deadline End of the suggestion budget (`time_point::max()` without one).
+     * @return true if a strategy was found within the time budget and printed.
+     */
+    bool printEndgameStrategy(bool useGuessUniverse, std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Prints the opening book's first guess for the current configuration, if any.
+     */
+    void printBookOpening() const;
+
+    /**
+     * @brief Builds the guess universe of the current configuration, if enabled and within `SolverOptions::universeMaxEvaluations`.
+     */
+    void prepareGuessUniverse();
+
+    SolverOptions solverOptions;     ///< Optional solver features chosen at start-up
     GameRoundState gameRoundState;   ///< Stores full game and round-related state data
     ExpressionValidator validator;   ///< Validates expressions and filters candidates according to constraints
+    GuessSuggester guessSuggester;   ///< Ranks next guesses; caches the candidate pool of the current round
+    GuessUniverse guessUniverse;     ///< Every valid expression, built at game start and kept across games (see `SolverOptions::useGuessUniverse`)
+    OpeningBook openingBook;         ///< Precomputed first and second guesses, loaded once
+    EndgameSolver endgameSolver;     ///< Exact strategy search once few survivors are left
+    SpeculativePartition speculativePartition;  ///< Survivors per feedback, computed while the colors are typed
+    SessionReport sessionReport;     ///< Per-phase latency of every round of the session
+    size_t sessionGameIndex = 1;     ///< Game of the session being played (1-based)
 
     InputExpressionSpec specReader;  ///< Handles reading game configuration (expression length, operator set)
     InputExpressionLine exprReader;  ///< Handles reading player expression and color feedback
 
     std::unordered_map<char, Constraint> constraintsMap;  ///< Active constraint map representing symbol restrictions
-    std::vector<std::string> currentCandidatesList;       ///< List of currently filtered expression candidates
+    SurvivorSet currentSurvivors;                         ///< Handles (into `gameRoundState.candidatePool`) of currently filtered candidates
 };
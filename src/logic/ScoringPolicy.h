@@ -0,0 +1,59 @@
+/* ----- ----- ----- ----- */
+// ScoringPolicy.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <string_view>
+
+/**
+ * @enum ScoringPolicy
+ * @brief Defines how `GuessSuggester` ranks possible next guesses.
+ *
+ * <summary>
+ * Every policy is computed from the same feedback partition of the survivors
+ * (`n_k` survivors in group `k`, `N` in total), so switching policy never costs an
+ * extra pass over the answers.
+ * </summary>
+ */
+enum class ScoringPolicy {
+    Entropy,       ///< Most expected information: log2(N) - sum(n_k * log2(n_k)) / N.
+    Minimax,       ///< Smallest worst case: max(n_k).
+    ExpectedSize,  ///< Fewest survivors left on average: sum(n_k^2) / N.
+    WinChance      ///< Most likely to be the answer itself, then fewest survivors left on average.
+};
+
+/**
+ * @brief Returns the command-line name of a policy (e.g., `"minimax"`).
+ */
+constexpr std::string_view getScoringPolicyName(ScoringPolicy scoringPolicy) {
+    switch (scoringPolicy) {
+        case ScoringPolicy::Entropy:      return "entropy";
+        case ScoringPolicy::Minimax:      return "minimax";
+        case ScoringPolicy::ExpectedSize: return "expected";
+        case ScoringPolicy::WinChance:    return "win";
+    }
+    return "entropy";
+}
+
+/**
+ * @brief Parses a policy from its command-line name.
+ *
+ * @param policyName Name as returned by `getScoringPolicyName`.
+ * @param[out] scoringPolicy Parsed policy.
+ * @return true if the name was recognised, false otherwise.
+ */
+constexpr bool parseScoringPolicy(std::string_view policyName, ScoringPolicy& scoringPolicy) {
+    for (ScoringPolicy candidatePolicy : { ScoringPolicy::Entropy, ScoringPolicy::Minimax,
+                                           ScoringPolicy::ExpectedSize, ScoringPolicy::WinChance }) {
+        if (getScoringPolicyName(candidatePolicy) == policyName) {
+            scoringPolicy = candidatePolicy;
+            return true;
+        }
+    }
+    return false;
+}
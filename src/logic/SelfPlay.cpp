@@ -0,0 +1,370 @@
+/* ----- ----- ----- ----- */
+// SelfPlay.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/17
+// Version: v1.2
+/* ----- ----- ----- ----- */
+
+#include "SelfPlay.h"
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "CandidateGenerator.h"
+#include "Constraint.h"
+#include "EndgameSolver.h"
+#include "ExpressionValidator.h"
+#include "FeedbackCode.h"
+#include "GuessSuggester.h"
+#include "GuessUniverse.h"
+#include "OpeningBook.h"
+#include "SpeculativePartition.h"
+#include "SurvivorSet.h"
+#include "core/logging/AppLogger.h"
+#include "util/ParallelUtils.h"
+#include "util/ProcessStats.h"
+#include "util/TraceRecorder.h"
+
+namespace SelfPlay {
+
+namespace {
+
+constexpr int MAX_GAME_ROUNDS = 20;  ///< A game still unsolved after this many guesses counts as failed
+constexpr size_t MAX_DRAW_ATTEMPTS = 1000000;  ///< LHS sequences drawn per answer before the spec counts as empty
+constexpr size_t OPENING_SAMPLE_COUNT = 1000;  ///< Answers the opening is scored against without a universe
+
+/**
+ * @struct GameSetup
+ * @brief What every game of a run shares (read-only while the games run).
+ */
+struct GameSetup {
+    const SolverOptions* solverOptions = nullptr;
+    int exprLength = 0;
+    std::unordered_set<char> operatorsSet;
+    bool useGuessUniverse = false;                   ///< `--universe` is on and the universe is within the limit
+    GuessUniverse guessUniverse;                     ///< Guesses from outside the survivors (built only if used)
+    std::string openingLine;                         ///< First guess of every game
+    const OpeningBook::Entry* bookEntry = nullptr;   ///< Replies to the opening, if the book has them
+};
+
+/**
+ * @brief Returns the value at `fraction` of a sorted list (nearest rank).
+ */
+double getPercentile(const std::vector<double>& sortedValuesList, double fraction) {
+    if (sortedValuesList.empty()) return 0.0;
+    const size_t rank = static_cast<size_t>(fraction * static_cast<double>(sortedValuesList.size() - 1) + 0.5);
+    return sortedValuesList[(std::min)(rank, sortedValuesList.size() - 1)];
+}
+
+/**
+ * @struct GameWorker
+ * @brief Per-thread solver state reused across the games of one worker.
+ */
+struct GameWorker {
+    ExpressionValidator validator;               ///< Operators already set
+    GuessSuggester guessSuggester;
+    EndgameSolver endgameSolver;
+    SpeculativePartition speculativePartition;
+};
+
+/**
+ * @brief First guess of the exact endgame strategy, as `RoundManager::printEndgameStrategy` finds it.
+ *
+ * @param gameSetup Shared game data.
+ * @param candidatePool Pool of the game's candidates.
+ * @param survivorSet Current survivors (at most `EndgameSolver::MAX_ANSWER_COUNT`).
+ * @param gameWorker Solver state of the calling worker.
+ * @return std::optional<std::string> Guess, or nothing if no strategy was found within the budget.
+ */
+std::optional<std::string> solveEndgameGuess(
+    const GameSetup& gameSetup,
+    const CandidatePool& candidatePool,
+    const SurvivorSet& survivorSet,
+    GameWorker& gameWorker
+) {
+    const SolverOptions& solverOptions = *gameSetup.solverOptions;
+    const bool useGuessUniverse = gameSetup.useGuessUniverse;
+    const CandidatePool* solvePool = &candidatePool;
+    std::vector<CandidateHandle> answerHandlesList = survivorSet.toSortedHandles();
+    std::vector<CandidateHandle> probeHandlesList;
+    if (useGuessUniverse) {
+        solvePool = &gameSetup.guessUniverse.getPool();
+        for (CandidateHandle& answerHandle : answerHandlesList) {
+            if (!gameSetup.guessUniverse.find(candidatePool.view(answerHandle), answerHandle)) return std::nullopt;
+        }
+        for (const GuessScore& guessScore : gameWorker.guessSuggester.suggestFromUniverse(survivorSet, candidatePool,
+                gameSetup.guessUniverse, EndgameSolver::UNIVERSE_PROBE_COUNT, solverOptions.universeMaxGuesses,
+                solverOptions.scoringPolicy))
+            probeHandlesList.push_back(guessScore.handle);
+    }
+
+    const bool isWorstCase = (solverOptions.scoringPolicy == ScoringPolicy::Minimax);
+    std::optional<EndgameTree> endgameTree = gameWorker.endgameSolver.solve(*solvePool, answerHandlesList, probeHandlesList,
+        isWorstCase ? EndgameSolver::Objective::WorstGuesses : EndgameSolver::Objective::ExpectedGuesses,
+        static_cast<long long>(solverOptions.endgameTimeMs));
+    if (!endgameTree) return std::nullopt;
+    return std::string(solvePool->view(endgameTree->nodesList.front().guessHandle));
+}
+
+/**
+ * @brief Plays one game against a hidden answer, the way the interactive rounds would.
+ *
+ * <summary>
+ * Later rounds take their survivors from the speculative partition when it is on, as
+ * `RoundManager` does; it is started as soon as the guess is known, and since no color
+ * line is typed here, its whole run counts toward the round time.
+ * </summary>
+ *
+ * @param gameSetup Shared game data.
+ * @param answerLine Hidden answer.
+ * @param gameWorker Solver state of the calling worker.
+ * @return GameResult Outcome and round timings.
+ */
+GameResult playGame(
+    const GameSetup& gameSetup,
+    const std::string& answerLine,
+    GameWorker& gameWorker
+) {
+    ExpressionValidator& validator = gameWorker.validator;
+    GuessSuggester& guessSuggester = gameWorker.guessSuggester;
+    const SolverOptions& solverOptions = *gameSetup.solverOptions;
+    const FeedbackCode::Code allGreenCode = FeedbackCode::getAllGreenCode(gameSetup.exprLength);
+
+    GameResult gameResult;
+    gameResult.answerLine = answerLine;
+    std::unordered_map<char, Constraint> constraintsMap = initializeConstraintsMap();
+    CandidatePool candidatePool;
+    SurvivorSet survivorSet;
+    std::string guessLine = gameSetup.openingLine;
+
+    for (int roundIndex = 0; roundIndex < MAX_GAME_ROUNDS; ++roundIndex) {
+        ++gameResult.guessCount;
+        const FeedbackCode::Code code = FeedbackCode::compute(guessLine, answerLine);
+        if (code == allGreenCode) {
+            gameResult.isSolved = true;
+            break;
+        }
+
+        const auto startTime = std::chrono::steady_clock::now();
+        if (roundIndex > 0 && solverOptions.speculateFeedback)
+            gameWorker.speculativePartition.start(candidatePool, survivorSet, guessLine);
+        const std::string exprColorLine = FeedbackCode::toColorLine(code, gameSetup.exprLength);
+        updateConstraint(constraintsMap, guessLine, exprColorLine);
+        if (roundIndex == 0) {
+            CandidateGenerator generator(validator);
+            candidatePool = generator.generatePool(
+                gameSetup.exprLength, gameSetup.operatorsSet, {guessLine}, {exprColorLine}, constraintsMap);
+            survivorSet = SurvivorSet::fromRange(candidatePool.size());
+            guessSuggester.reset(candidatePool);
+            guessSuggester.setExactAnswerLimit(solverOptions.exactScoringMaxSurvivors);
+        }
+        else if (!gameWorker.speculativePartition.take(guessLine, code, survivorSet)) {
+            survivorSet = validator.filterSurvivors(candidatePool, survivorSet, constraintsMap);
+        }
+        if (survivorSet.empty()) break;  // The answer was filtered out: a solver bug
+
+        // Next guess: book reply, last survivor, exact endgame, or first suggestion
+        const std::string* replyLine = (roundIndex == 0 && gameSetup.bookEntry) ? gameSetup.bookEntry->findReply(code) : nullptr;
+        std::optional<std::string> endgameLine;
+        if (!replyLine && survivorSet.size() > 1 && survivorSet.size() <= solverOptions.endgameMaxSurvivors)
+            endgameLine = solveEndgameGuess(gameSetup, candidatePool, survivorSet, gameWorker);
+        if (replyLine) {
+            guessLine = *replyLine;
+        }
+        else if (survivorSet.size() == 1) {
+            guessLine = std::string(candidatePool.view(survivorSet.toSortedHandles().front()));
+        }
+        else if (endgameLine) {
+            guessLine = std::move(*endgameLine);
+        }
+        else {
+            const bool useGuessUniverse = gameSetup.useGuessUniverse;
+            const std::vector<GuessScore> guessScoresList = useGuessUniverse
+                ? guessSuggester.suggestFromUniverse(survivorSet, candidatePool, gameSetup.guessUniverse, 1,
+                    solverOptions.universeMaxGuesses, solverOptions.scoringPolicy, solverOptions.suggestionBudgetMs)
+                : guessSuggester.suggest(survivorSet, 1,
+                    solverOptions.suggestionMaxGuesses, solverOptions.scoringPolicy, solverOptions.suggestionBudgetMs);
+            if (guessScoresList.empty()) break;
+            const CandidatePool& guessPool = useGuessUniverse ? gameSetup.guessUniverse.getPool() : candidatePool;
+            guessLine = std::string(guessPool.view(guessScoresList.front().handle));
+        }
+        gameResult.roundMsList.push_back(
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count());
+    }
+    gameWorker.speculativePartition.cancel();  // It may still read this game's pool
+    return gameResult;
+}
+
+}  // namespace (end of anonymous)
+
+/**
+ * @brief Plays `SolverOptions::selfPlayGameCount` games and summarises them.
+ *
+ * <summary>
+ * The hidden answers are drawn up front, uniformly (`CandidateGenerator::drawExpression`),
+ * from one generator seeded with `SolverOptions::selfPlaySeed`, so a run is repeatable
+ * whatever the thread count, and no length needs the whole universe. The universe is
+ * built only for `--universe`, within `--universe-limit`. The opening is the book's,
+ * else the best guess over the universe, else the best guess against a sample of
+ * `OPENING_SAMPLE_COUNT` more drawn answers.
+ * Games are claimed one at a time by `selfPlayThreadCount` workers.
+ * </summary>
+ *
+ * @param solverOptions Game spec, thread count and seed, plus the solver's own options.
+ * @return std::optional<Summary> Summary, or nothing if the spec has no valid expression.
+ */
+std::optional<Summary> playGames(const SolverOptions& solverOptions) {
+    GameSetup gameSetup;
+    gameSetup.solverOptions = &solverOptions;
+    gameSetup.exprLength = solverOptions.selfPlayLength;
+    gameSetup.operatorsSet = std::unordered_set<char>(solverOptions.selfPlayOperators.begin(), solverOptions.selfPlayOperators.end());
+
+    // Hidden answers
+    ExpressionValidator setupValidator;
+    setupValidator.setValidOps(gameSetup.operatorsSet);
+    CandidateGenerator answerGenerator(setupValidator);
+    std::mt19937_64 randomGenerator(solverOptions.selfPlaySeed);
+    std::vector<std::string> answerLinesList;
+    answerLinesList.reserve(solverOptions.selfPlayGameCount);
+    for (size_t gameIndex = 0; gameIndex < solverOptions.selfPlayGameCount; ++gameIndex) {
+        std::optional<std::string> answerLine =
+            answerGenerator.drawExpression(gameSetup.exprLength, gameSetup.operatorsSet, randomGenerator, MAX_DRAW_ATTEMPTS);
+        if (!answerLine) {
+            AppLogger::Error(std::format("Self-play: {}{} has no valid expression.", gameSetup.exprLength, solverOptions.selfPlayOperators));
+            return std::nullopt;
+        }
+        answerLinesList.push_back(std::move(*answerLine));
+    }
+
+    // Guess universe, only if the games use it
+    if (solverOptions.useGuessUniverse) {
+        TraceRecorder::Span universeSpan("buildGuessUniverse");
+        gameSetup.useGuessUniverse = gameSetup.guessUniverse.build(
+            gameSetup.exprLength, gameSetup.operatorsSet, setupValidator, solverOptions.universeMaxEvaluations);
+        if (!gameSetup.useGuessUniverse)
+            AppLogger::Warn(std::format("Self-play: guess universe skipped, {}{} needs more than {} evaluations (--universe-limit).",
+                gameSetup.exprLength, solverOptions.selfPlayOperators, solverOptions.universeMaxEvaluations));
+    }
+
+    // Opening: the book's, the best guess over the universe, or the best guess against sampled answers
+    OpeningBook openingBook;
+    if (!solverOptions.openingBookPath.empty()) openingBook.load(solverOptions.openingBookPath);
+    gameSetup.bookEntry = openingBook.find(gameSetup.exprLength, gameSetup.operatorsSet, solverOptions.scoringPolicy);
+    if (gameSetup.bookEntry) {
+        gameSetup.openingLine = gameSetup.bookEntry->openingLine;
+    }
+    else {
+        CandidatePool samplePool;
+        if (!gameSetup.useGuessUniverse) {
+            samplePool.reset(gameSetup.exprLength);
+            std::unordered_set<std::string> sampleLinesSet;
+            for (size_t sampleIndex = 0; sampleIndex < OPENING_SAMPLE_COUNT; ++sampleIndex) {
+                std::optional<std::string> sampleLine =
+                    answerGenerator.drawExpression(gameSetup.exprLength, gameSetup.operatorsSet, randomGenerator, MAX_DRAW_ATTEMPTS);
+                if (sampleLine && sampleLinesSet.insert(*sampleLine).second) samplePool.add(*sampleLine);
+            }
+        }
+        const CandidatePool& openingPool = gameSetup.useGuessUniverse ? gameSetup.guessUniverse.getPool() : samplePool;
+        GuessSuggester openingSuggester;
+        openingSuggester.reset(openingPool);
+        const std::vector<GuessScore> openingScoresList = openingSuggester.suggest(
+            SurvivorSet::fromRange(openingPool.size()), 1, solverOptions.suggestionMaxGuesses, solverOptions.scoringPolicy);
+        if (openingScoresList.empty()) return std::nullopt;
+        gameSetup.openingLine = std::string(openingPool.view(openingScoresList.front().handle));
+    }
+
+    AppLogger::Info(std::format("Self-play: {} games of {}{}, opening {}{}.", answerLinesList.size(), gameSetup.exprLength,
+        solverOptions.selfPlayOperators, gameSetup.openingLine, gameSetup.bookEntry ? " (book)" : ""));
+
+    // Games, one per worker at a time
+    const size_t threadCount = (std::max)(size_t{1}, (std::min)(answerLinesList.size(),
+        solverOptions.selfPlayThreadCount > 0 ? solverOptions.selfPlayThreadCount : ParallelUtils::getWorkerCount(answerLinesList.size(), 1)));
+    std::vector<GameResult> gameResultsList(answerLinesList.size());
+    const auto startTime = std::chrono::steady_clock::now();
+    TraceRecorder::Span gamesSpan("selfPlayGames");
+    ParallelUtils::runBlocks(answerLinesList.size(), 1, threadCount, [&](size_t, const ParallelUtils::ChunkRange& block) {
+        const ParallelUtils::WorkerLimitScope workerLimitScope(1);
+        GameWorker gameWorker;
+        gameWorker.validator.setValidOps(gameSetup.operatorsSet);
+        for (size_t gameIndex = block.begin; gameIndex < block.end; ++gameIndex) {
+            TraceRecorder::Span gameSpan("selfPlayGame");
+            gameSpan.setArg("game", static_cast<long long>(gameIndex));
+            gameResultsList[gameIndex] = playGame(gameSetup, answerLinesList[gameIndex], gameWorker);
+        }
+    });
+
+    // Summary
+    Summary summary;
+    summary.gameCount = gameResultsList.size();
+    summary.threadCount = threadCount;
+    summary.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    summary.peakMemoryBytes = ProcessStats::getPeakMemoryBytes();
+
+    std::vector<double> roundMsList;
+    std::vector<double> firstRoundMsList;
+    size_t solvedGuessTotal = 0;
+    for (const GameResult& gameResult : gameResultsList) {
+        roundMsList.insert(roundMsList.end(), gameResult.roundMsList.begin(), gameResult.roundMsList.end());
+        if (!gameResult.roundMsList.empty()) firstRoundMsList.push_back(gameResult.roundMsList.front());
+        if (!gameResult.isSolved) {
+            AppLogger::Warn(std::format("Self-play: {} not solved after {} guesses.", gameResult.answerLine, gameResult.guessCount));
+            continue;
+        }
+        ++summary.solvedCount;
+        solvedGuessTotal += static_cast<size_t>(gameResult.guessCount);
+        summary.worstGuesses = (std::max)(summary.worstGuesses, gameResult.guessCount);
+        if (summary.guessCountsList.size() <= static_cast<size_t>(gameResult.guessCount))
+            summary.guessCountsList.resize(static_cast<size_t>(gameResult.guessCount) + 1, 0);
+        ++summary.guessCountsList[static_cast<size_t>(gameResult.guessCount)];
+    }
+    if (summary.solvedCount > 0)
+        summary.meanGuesses = static_cast<double>(solvedGuessTotal) / static_cast<double>(summary.solvedCount);
+
+    std::sort(roundMsList.begin(), roundMsList.end());
+    std::sort(firstRoundMsList.begin(), firstRoundMsList.end());
+    summary.roundCount = roundMsList.size();
+    summary.roundP50Ms = getPercentile(roundMsList, 0.50);
+    summary.roundP90Ms = getPercentile(roundMsList, 0.90);
+    summary.roundP99Ms = getPercentile(roundMsList, 0.99);
+    summary.roundMaxMs = roundMsList.empty() ? 0.0 : roundMsList.back();
+    summary.firstRoundP50Ms = getPercentile(firstRoundMsList, 0.50);
+    return summary;
+}
+
+/**
+ * @brief Plays the games and prints the summary.
+ *
+ * <summary>
+ * Debug output of the rounds is silenced while the games run.
+ * </summary>
+ *
+ * @param solverOptions Game spec, thread count and seed, plus the solver's own options.
+ * @return true if every game was solved.
+ */
+bool run(const SolverOptions& solverOptions) {
+    AppLogger::SetLogLevel(LogLevel::Info);
+    std::optional<Summary> summary = playGames(solverOptions);
+    if (!summary) return false;
+
+    std::string distributionText;
+    for (size_t guessCount = 1; guessCount < summary->guessCountsList.size(); ++guessCount) {
+        if (summary->guessCountsList[guessCount] > 0)
+            distributionText += std::format(" {}:{}", guessCount, summary->guessCountsList[guessCount]);
+    }
+    AppLogger::Info(std::format("Self-play: {}/{} solved, {:.3f} guesses on average, worst {} (games per guess count:{}).",
+        summary->solvedCount, summary->gameCount, summary->meanGuesses, summary->worstGuesses, distributionText));
+    AppLogger::Info(std::format("Self-play: {} rounds, p50 {:.2f} ms, p90 {:.2f} ms, p99 {:.2f} ms, max {:.2f} ms (round 1 p50 {:.2f} ms).",
+        summary->roundCount, summary->roundP50Ms, summary->roundP90Ms, summary->roundP99Ms, summary->roundMaxMs, summary->firstRoundP50Ms));
+    AppLogger::Info(std::format("Self-play: {:.0f} ms on {} threads ({:.1f} games/s), peak memory {:.1f} MiB.",
+        summary->elapsedMs, summary->threadCount,
+        summary->elapsedMs > 0.0 ? 1000.0 * static_cast<double>(summary->gameCount) / summary->elapsedMs : 0.0,
+        static_cast<double>(summary->peakMemoryBytes) / (1024.0 * 1024.0)));
+    return summary->solvedCount == summary->gameCount;
+}
+
+}  // namespace SelfPlay
@@ -0,0 +1,90 @@
+/* ----- ----- ----- ----- */
+// SelfPlay.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/17
+// Version: v1.2
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "SolverOptions.h"
+
+/**
+ * @namespace SelfPlay
+ * @brief Non-interactive games against hidden answers (`--selfplay=<games>`).
+ *
+ * <summary>
+ * Each game draws a hidden answer uniformly among the valid expressions
+ * (`CandidateGenerator::drawExpression`, without building them all) and plays the solver
+ * against it: the feedback of every guess is computed (`FeedbackCode::compute`) instead
+ * of typed, and the next guess is the one the interactive solver would print first:
+ * 1. Round 1 plays the book opening, or the best guess over the universe (`--universe`),
+ *    or the best guess against a sample of drawn answers.
+ * 2. The feedback updates the constraints; round 1 generates the candidates
+ *    (`CandidateGenerator`), later rounds take them from the speculative partition
+ *    (`SpeculativePartition`, if on) or filter them (`ExpressionValidator`).
+ * 3. Round 2 plays the book reply if there is one. Otherwise, at or below
+ *    `endgameMaxSurvivors` survivors, the next guess is the root of the exact endgame
+ *    strategy (`EndgameSolver`); failing that, it is the first suggestion
+ *    (`GuessSuggester`, with the session's policy and limits).
+ * Games run on several threads at once; each game runs its passes on its own thread
+ * (`ParallelUtils::WorkerLimitScope`) so the games do not compete for workers.
+ * </summary>
+ */
+namespace SelfPlay {
+
+    /**
+     * @struct GameResult
+     * @brief Outcome of one game.
+     */
+    struct GameResult {
+        std::string answerLine;        ///< Hidden answer
+        int guessCount = 0;            ///< Guesses played, the winning one included
+        bool isSolved = false;         ///< False if the round limit was reached or the answer was filtered out
+        std::vector<double> roundMsList;  ///< Wall time of every round (constraints, candidates, next guess)
+    };
+
+    /**
+     * @struct Summary
+     * @brief Totals over every game of a run.
+     */
+    struct Summary {
+        size_t gameCount = 0;               ///< Games played
+        size_t solvedCount = 0;             ///< Games whose answer was found
+        double meanGuesses = 0.0;           ///< Average guesses of the solved games
+        int worstGuesses = 0;               ///< Most guesses of a solved game
+        std::vector<size_t> guessCountsList;  ///< Solved games per guess count (index = guesses)
+        size_t roundCount = 0;              ///< Rounds timed
+        double roundP50Ms = 0.0;            ///< Median round time
+        double roundP90Ms = 0.0;            ///< 90th percentile round time
+        double roundP99Ms = 0.0;            ///< 99th percentile round time
+        double roundMaxMs = 0.0;            ///< Slowest round
+        double firstRoundP50Ms = 0.0;       ///< Median time of round 1 (candidate generation)
+        std::uint64_t peakMemoryBytes = 0;  ///< Peak resident memory of the process
+        double elapsedMs = 0.0;             ///< Wall time of the games
+        size_t threadCount = 0;             ///< Games played at once
+    };
+
+    /**
+     * @brief Plays `SolverOptions::selfPlayGameCount` games and summarises them.
+     *
+     * @param solverOptions Game spec, thread count and seed, plus the solver's own options.
+     * @return std::optional<Summary> Summary, or nothing if the spec has no valid expression.
+     */
+    std::optional<Summary> playGames(const SolverOptions& solverOptions);
+
+    /**
+     * @brief Plays the games and prints the summary.
+     *
+     * @param solverOptions Game spec, thread count and seed, plus the solver's own options.
+     * @return true if every game was solved.
+     */
+    bool run(const SolverOptions& solverOptions);
+
+}  // namespace SelfPlay
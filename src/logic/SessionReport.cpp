@@ -0,0 +1,80 @@
+/* ----- ----- ----- ----- */
+// SessionReport.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/17
+// Update Date: 2026/10/17
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#include "SessionReport.h"
+#include <algorithm>
+#include <format>
+
+#include "core/logging/AppLogger.h"
+
+namespace {
+
+/**
+ * @brief Microseconds as milliseconds with two decimals.
+ */
+std::string formatMs(std::uint64_t valueUs) {
+    return std::format("{:.2f}", static_cast<double>(valueUs) / 1000.0);
+}
+
+/**
+ * @brief One summary line: record count, p50/p95/p99 and max of a histogram, in ms.
+ */
+void logHistogram(const char* phaseName, const LatencyHistogram& latencyHistogram) {
+    if (latencyHistogram.getCount() == 0) return;
+    AppLogger::Info(std::format("  {:<12} n={:<5} p50 {:>9}  p95 {:>9}  p99 {:>9}  max {:>9}",
+        phaseName, latencyHistogram.getCount(),
+        formatMs(latencyHistogram.getPercentile(50.0)), formatMs(latencyHistogram.getPercentile(95.0)),
+        formatMs(latencyHistogram.getPercentile(99.0)), formatMs(latencyHistogram.getMax())));
+}
+
+}  // namespace (end of anonymous)
+
+void SessionReport::recordRound(const RoundTiming& roundTiming) {
+    constraintsHistogram.record(roundTiming.constraintsUs);
+    (roundTiming.isGenerated ? generateHistogram : filterHistogram).record(roundTiming.candidatesUs);
+    printHistogram.record(roundTiming.printUs);
+    suggestionsHistogram.record(roundTiming.suggestionsUs);
+    roundHistogram.record(roundTiming.totalUs);
+
+    // Keep the slowest rounds, slowest first
+    auto insertIt = std::find_if(worstRoundsList.begin(), worstRoundsList.end(),
+        [&roundTiming](const RoundTiming& worstRound) { return worstRound.totalUs < roundTiming.totalUs; });
+    if (insertIt == worstRoundsList.end() && worstRoundsList.size() >= WORST_ROUND_COUNT) return;
+    worstRoundsList.insert(insertIt, roundTiming);
+    if (worstRoundsList.size() > WORST_ROUND_COUNT) worstRoundsList.pop_back();
+}
+
+/**
+ * @brief Writes the session summary to the log.
+ *
+ * <summary>
+ * One line per phase (rounds recorded, p50/p95/p99/max in ms; percentiles are within
+ * the histogram's bucket precision), then the slowest rounds with their breakdown.
+ * </summary>
+ */
+void SessionReport::log() const {
+    if (roundHistogram.getCount() == 0) return;
+
+    AppLogger::Info(std::format("Session latency: {} round(s), mean {:.2f} ms per round; phase times in ms:",
+        roundHistogram.getCount(), roundHistogram.getMean() / 1000.0));
+    logHistogram("round", roundHistogram);
+    logHistogram("constraints", constraintsHistogram);
+    logHistogram("generate", generateHistogram);
+    logHistogram("filter", filterHistogram);
+    logHistogram("print", printHistogram);
+    logHistogram("suggestions", suggestionsHistogram);
+
+    AppLogger::Info("Slowest rounds:");
+    for (const RoundTiming& worstRound : worstRoundsList) {
+        AppLogger::Info(std::format("  game {} round {} ({}): {} ms = constraints {} + {} {} + print {} + suggestions {}",
+            worstRound.gameIndex, worstRound.roundIndex, worstRound.exprLine, formatMs(worstRound.totalUs),
+            formatMs(worstRound.constraintsUs), worstRound.isGenerated ? "generate" : "filter",
+            formatMs(worstRound.candidatesUs), formatMs(worstRound.printUs), formatMs(worstRound.suggestionsUs)));
+    }
+}
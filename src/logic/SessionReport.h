@@ -0,0 +1,68 @@
+/* ----- ----- ----- ----- */
+// SessionReport.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/17
+// Update Date: 2026/10/17
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "util/LatencyHistogram.h"
+
+/**
+ * @class SessionReport
+ * @brief Per-phase latency of every round played in a session, summarised into the log.
+ *
+ * <summary>
+ * `RoundManager` records the wall time of each round's phases (waiting for input
+ * excluded). Each phase has its own `LatencyHistogram`, and the slowest rounds are
+ * kept with their breakdown. `log` writes p50/p95/p99/max per phase plus the worst rounds;
+ * it is called at every `resetGame` (totals so far) and when the solver exits.
+ * </summary>
+ */
+class SessionReport {
+public:
+    /**
+     * @struct RoundTiming
+     * @brief Wall time of one round, per phase, in microseconds.
+     */
+    struct RoundTiming {
+        size_t gameIndex = 0;          ///< Game of the session (1-based)
+        size_t roundIndex = 0;         ///< Round of the game (1-based)
+        std::string exprLine;          ///< Guess of the round
+        bool isGenerated = false;      ///< True if candidates were generated (first round), false if filtered
+        std::uint64_t constraintsUs = 0;  ///< Constraint update
+        std::uint64_t candidatesUs = 0;   ///< Candidate generation or filtering
+        std::uint64_t printUs = 0;        ///< Printing the candidates
+        std::uint64_t suggestionsUs = 0;  ///< Ranking and printing the next guesses
+        std::uint64_t totalUs = 0;        ///< Whole round after the input was read
+    };
+
+    /**
+     * @brief Adds one round to the histograms and to the worst rounds.
+     */
+    void recordRound(const RoundTiming& roundTiming);
+
+    /**
+     * @brief Writes the summary to the log at Info level (nothing if no round was recorded).
+     */
+    void log() const;
+
+    size_t getRoundCount() const { return roundHistogram.getCount(); }
+
+    static constexpr size_t WORST_ROUND_COUNT = 5;  ///< Slowest rounds kept with their breakdown
+
+private:
+    LatencyHistogram constraintsHistogram;  ///< Constraint update
+    LatencyHistogram generateHistogram;     ///< First-round generation
+    LatencyHistogram filterHistogram;       ///< Later-round filtering
+    LatencyHistogram printHistogram;        ///< Candidate printing
+    LatencyHistogram suggestionsHistogram;  ///< Next-guess suggestions
+    LatencyHistogram roundHistogram;        ///< Whole round
+    std::vector<RoundTiming> worstRoundsList;  ///< Slowest rounds, slowest first
+};
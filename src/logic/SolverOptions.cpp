@@ -0,0 +1,206 @@
+/* ----- ----- ----- ----- */
+// SolverOptions.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/17
+// Version: v1.4
+/* ----- ----- ----- ----- */
+
+#include "SolverOptions.h"
+#include <charconv>
+
+namespace {
+
+/**
+ * @brief Parses the unsigned value of a `--name=<value>` argument.
+ *
+ * @param argument Full argument.
+ * @param prefix Expected `--name=` prefix.
+ * @param[out] value Parsed value.
+ * @return true if `argument` starts with `prefix` and is followed by a valid number.
+ */
+bool parseSizeArgument(std::string_view argument, std::string_view prefix, size_t& value) {
+    if (argument.substr(0, prefix.size()) != prefix) return false;
+    std::string_view valueText = argument.substr(prefix.size());
+    auto [parseEnd, errorCode] = std::from_chars(valueText.data(), valueText.data() + valueText.size(), value);
+    return errorCode == std::errc() && parseEnd == valueText.data() + valueText.size();
+}
+
+/**
+ * @brief Parses the `<min>-<max>` value of a `--name=<min>-<max>` argument.
+ *
+ * @param argument Full argument.
+ * @param prefix Expected `--name=` prefix.
+ * @param[out] minValue Parsed lower bound.
+ * @param[out] maxValue Parsed upper bound.
+ * @return true if `argument` starts with `prefix` and is followed by a valid range.
+ */
+bool parseRangeArgument(std::string_view argument, std::string_view prefix, int& minValue, int& maxValue) {
+    if (argument.substr(0, prefix.size()) != prefix) return false;
+    std::string_view valueText = argument.substr(prefix.size());
+    const char* valueEnd = valueText.data() + valueText.size();
+    int parsedMin = 0;
+    int parsedMax = 0;
+    auto [minEnd, minError] = std::from_chars(valueText.data(), valueEnd, parsedMin);
+    if (minError != std::errc() || minEnd == valueEnd || *minEnd != '-') return false;
+    auto [maxEnd, maxError] = std::from_chars(minEnd + 1, valueEnd, parsedMax);
+    if (maxError != std::errc() || maxEnd != valueEnd || parsedMin > parsedMax) return false;
+    minValue = parsedMin;
+    maxValue = parsedMax;
+    return true;
+}
+
+/**
+ * @brief Parses the `<length><operators>` value of a `--name=<length><operators>` argument (e.g. `8+-*\/`).
+ *
+ * @param argument Full argument.
+ * @param prefix Expected `--name=` prefix.
+ * @param[out] exprLength Parsed length.
+ * @param[out] operatorsText Parsed operators, each of `+-*\/^` at most once.
+ * @return true if `argument` starts with `prefix` and is followed by a valid spec.
+ */
+bool parseSpecArgument(std::string_view argument, std::string_view prefix, int& exprLength, std::string& operatorsText) {
+    if (argument.substr(0, prefix.size()) != prefix) return false;
+    std::string_view valueText = argument.substr(prefix.size());
+    const char* valueEnd = valueText.data() + valueText.size();
+    int parsedLength = 0;
+    auto [lengthEnd, lengthError] = std::from_chars(valueText.data(), valueEnd, parsedLength);
+    if (lengthError != std::errc() || parsedLength <= 0) return false;
+    std::string_view parsedOperators(lengthEnd, static_cast<size_t>(valueEnd - lengthEnd));
+    if (parsedOperators.empty()) return false;
+    for (size_t i = 0; i < parsedOperators.size(); ++i) {
+        if (std::string_view("+-*/^").find(parsedOperators[i]) == std::string_view::npos
+            || parsedOperators.find(parsedOperators[i]) != i)
+            return false;
+    }
+    exprLength = parsedLength;
+    operatorsText = std::string(parsedOperators);
+    return true;
+}
+
+}  // namespace (end of anonymous)
+
+/**
+ * @brief Applies one command-line argument.
+ *
+ * <summary>
+ * Recognised arguments:
+ * - `--trie`: filter rounds through a `CandidateTrie`.
+ * - `--gen-stats`: log DFS node and prune counters of the first-round generation (Debug level).
+ * - `--trace`: write a Chrome trace of the solver phases next to the log file (`<log>.trace.json`).
+ * - `--alloc-stats`: log heap allocations per round phase and per candidate (Debug level); needs a
+ *   build with `MATH_SOLVER_TRACK_ALLOCATIONS`.
+ * - `--metrics=<path>`: keep a Prometheus text file of the solver metrics (counters, latency and
+ *   survivor histograms, cache hits) for node_exporter's textfile collector.
+ * - `--metrics-interval-ms=<ms>`: time between two rewrites of the metrics file (default 5000).
+ * - `--suggest=<count>`: number of next-guess suggestions (0 disables them).
+ * - `--suggest-guesses=<count>`: most guesses scored per round (0 = no limit).
+ * - `--suggest-ms=<ms>`: time budget of the whole suggestion step, endgame search included; suggestions are ranked on survivor samples (0 = exact).
+ * - `--exact-max=<count>`: above this many survivors, only guesses still in contention on a
+ *   sample are scored exactly (0 = always score every guess exactly).
+ * - `--policy=<name>`: suggestion ranking, one of `entropy`, `minimax`, `expected`, `win`.
+ * - `--universe`: suggest guesses from every valid expression, not just the survivors.
+ * - `--universe-guesses=<count>`: most universe guesses scored per round (0 = no limit).
+ * - `--universe-limit=<count>`: most left-hand sides evaluated to build a guess universe (default
+ *   4000000, every configuration up to length 8); larger configurations go without one (0 = no limit).
+ * - `--book=<path>`: opening book looked up at game start (off unless given).
+ * - `--build-book`: fill the opening book given by `--book=<path>` for the current `--policy`, then exit.
+ * - `--book-lengths=<min>-<max>`: expression lengths filled by `--build-book` (default 5-12; configurations over `--universe-limit` are skipped).
+ * - `--endgame=<count>`: solve exactly at or below this many survivors (default 64, at most 64; 0 disables it).
+ * - `--endgame-ms=<ms>`: time budget of the exact endgame search (default 200).
+ * - `--endgame-tree`: print the whole endgame strategy.
+ * - `--endgame-export=<path>`: write the endgame strategy to a text file.
+ * - `--speculate`: partition the survivors by feedback while the color line is typed, instead of
+ *   filtering after it arrives.
+ * - `--matrix-dir=<path>`: keep universe feedback matrices in this directory (with `--universe`).
+ * - `--matrix-max-mb=<size>`: largest feedback matrix used, in MiB (default 256).
+ * - `--selfplay=<games>`: play this many games against hidden answers, print a summary, then exit.
+ * - `--selfplay-spec=<length><operators>`: game of the self-play run (default `8+-*\/`).
+ * - `--selfplay-threads=<count>`: self-play games run at once (default one per hardware thread).
+ * - `--selfplay-seed=<seed>`: seed of the hidden answers (default 1).
+ * - `--verify=<cases>`: check this many random games of the fast generation and filter
+ *   engines against the reference path, report the first divergence, then exit.
+ * - `--verify-lengths=<min>-<max>`: expression lengths of the checked games (default 5-8).
+ * - `--verify-seed=<seed>`: seed of the checked games (default 1).
+ * </summary>
+ *
+ * @param argument Argument as given on the command line.
+ * @return true if the argument was recognised, false otherwise.
+ */
+bool SolverOptions::applyArgument(std::string_view argument) {
+    if (argument == "--trie") {
+        useCandidateTrie = true;
+        return true;
+    }
+    if (parseSizeArgument(argument, "--suggest=", suggestionCount)) return true;
+    if (argument == "--gen-stats") {
+        logGenerationStats = true;
+        return true;
+    }
+    if (argument == "--trace") {
+        writeTrace = true;
+        return true;
+    }
+    if (argument == "--alloc-stats") {
+        logAllocationStats = true;
+        return true;
+    }
+    if (argument == "--universe") {
+        useGuessUniverse = true;
+        return true;
+    }
+    if (argument == "--speculate") {
+        speculateFeedback = true;
+        return true;
+    }
+    if (argument == "--endgame-tree") {
+        printEndgameTree = true;
+        return true;
+    }
+    if (argument == "--build-book") {
+        buildOpeningBook = true;
+        return true;
+    }
+    if (parseSizeArgument(argument, "--suggest-guesses=", suggestionMaxGuesses)) return true;
+    if (parseSizeArgument(argument, "--suggest-ms=", suggestionBudgetMs)) return true;
+    if (parseSizeArgument(argument, "--exact-max=", exactScoringMaxSurvivors)) return true;
+    if (parseSizeArgument(argument, "--universe-guesses=", universeMaxGuesses)) return true;
+    if (parseSizeArgument(argument, "--universe-limit=", universeMaxEvaluations)) return true;
+    if (parseSizeArgument(argument, "--endgame=", endgameMaxSurvivors)) return true;
+    if (parseSizeArgument(argument, "--endgame-ms=", endgameTimeMs)) return true;
+    if (parseSizeArgument(argument, "--matrix-max-mb=", feedbackMatrixMaxMb)) return true;
+    if (parseSizeArgument(argument, "--metrics-interval-ms=", metricsIntervalMs)) return true;
+    if (parseRangeArgument(argument, "--book-lengths=", bookMinLength, bookMaxLength)) return true;
+    if (parseSizeArgument(argument, "--selfplay=", selfPlayGameCount)) return true;
+    if (parseSizeArgument(argument, "--selfplay-threads=", selfPlayThreadCount)) return true;
+    if (parseSizeArgument(argument, "--selfplay-seed=", selfPlaySeed)) return true;
+    if (parseSpecArgument(argument, "--selfplay-spec=", selfPlayLength, selfPlayOperators)) return true;
+    if (parseSizeArgument(argument, "--verify=", verifyCaseCount)) return true;
+    if (parseSizeArgument(argument, "--verify-seed=", verifySeed)) return true;
+    if (parseRangeArgument(argument, "--verify-lengths=", verifyMinLength, verifyMaxLength)) return true;
+    constexpr std::string_view BOOK_PREFIX = "--book=";
+    if (argument.substr(0, BOOK_PREFIX.size()) == BOOK_PREFIX) {
+        openingBookPath = std::string(argument.substr(BOOK_PREFIX.size()));
+        return true;
+    }
+    constexpr std::string_view ENDGAME_EXPORT_PREFIX = "--endgame-export=";
+    if (argument.substr(0, ENDGAME_EXPORT_PREFIX.size()) == ENDGAME_EXPORT_PREFIX) {
+        endgameTreePath = std::string(argument.substr(ENDGAME_EXPORT_PREFIX.size()));
+        return true;
+    }
+    constexpr std::string_view METRICS_PREFIX = "--metrics=";
+    if (argument.substr(0, METRICS_PREFIX.size()) == METRICS_PREFIX) {
+        metricsPath = std::string(argument.substr(METRICS_PREFIX.size()));
+        return true;
+    }
+    constexpr std::string_view MATRIX_DIR_PREFIX = "--matrix-dir=";
+    if (argument.substr(0, MATRIX_DIR_PREFIX.size()) == MATRIX_DIR_PREFIX) {
+        feedbackMatrixDir = std::string(argument.substr(MATRIX_DIR_PREFIX.size()));
+        return true;
+    }
+    constexpr std::string_view POLICY_PREFIX = "--policy=";
+    if (argument.substr(0, POLICY_PREFIX.size()) == POLICY_PREFIX)
+        return parseScoringPolicy(argument.substr(POLICY_PREFIX.size()), scoringPolicy);
+    return false;
+}
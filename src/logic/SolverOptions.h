@@ -0,0 +1,73 @@
+/* ----- ----- ----- ----- */
+// SolverOptions.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/17
+// Version: v1.3
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "ScoringPolicy.h"
+
+/**
+ * @struct SolverOptions
+ * @brief Optional solver features, chosen once at start-up and held by `RoundManager`.
+ *
+ * <summary>
+ * Two features are on by default: five next-guess suggestions after each round
+ * (`suggestionCount`) and the exact endgame search at or below 64 survivors
+ * (`endgameMaxSurvivors`). Neither changes the candidate set; each can be switched
+ * off with `--suggest=0` or `--endgame=0`. Every other feature (trie filter, opening
+ * book, feedback speculation, guess universe, metrics, traces...) is off until
+ * switched on from the command line (see `applyArgument`).
+ * </summary>
+ */
+struct SolverOptions {
+    bool useCandidateTrie = false;       ///< Build a prefix trie of the candidate pool and filter by walking it
+    bool logGenerationStats = false;     ///< Count DFS nodes and prunes per '=' position and log them after generation
+    bool writeTrace = false;             ///< Record a Chrome trace of the solver phases next to the log file
+    bool logAllocationStats = false;     ///< Log heap allocations per round phase (needs `TRACK_ALLOCATIONS`)
+    std::string metricsPath;             ///< Prometheus text file rewritten with the solver metrics (empty = off)
+    size_t metricsIntervalMs = 5000;     ///< Time between two rewrites of `metricsPath`, in milliseconds
+    size_t suggestionCount = 5;          ///< Next-guess suggestions printed after each round (0 = off)
+    size_t suggestionMaxGuesses = 1000;  ///< Most guesses scored per suggestion pass (0 = every survivor)
+    size_t suggestionBudgetMs = 0;       ///< Time budget of the suggestion step (endgame included) in milliseconds (0 = exact, no budget)
+    size_t exactScoringMaxSurvivors = 50000;  ///< Above this many survivors, guesses are pre-ranked on a sample (0 = never)
+    ScoringPolicy scoringPolicy = ScoringPolicy::Entropy;  ///< How suggested guesses are ranked
+    bool useGuessUniverse = false;       ///< Draw suggested guesses from every valid expression, not just survivors
+    size_t universeMaxGuesses = 0;       ///< Most universe guesses scored per suggestion pass (0 = all)
+    size_t universeMaxEvaluations = 4000000;  ///< Most LHS evaluated to build a guess universe; larger configurations go without (0 = no limit)
+    std::string openingBookPath;         ///< Opening book looked up at game start (empty = none; set with `--book=<path>`)
+    bool buildOpeningBook = false;       ///< Fill the opening book at `openingBookPath` (required), then exit
+    int bookMinLength = 5;               ///< Shortest expression length filled by `buildOpeningBook`
+    int bookMaxLength = 12;              ///< Longest expression length filled by `buildOpeningBook`
+    size_t endgameMaxSurvivors = 64;     ///< Solve the rest of the game exactly at or below this many survivors (0 = off)
+    size_t endgameTimeMs = 200;          ///< Time budget of the exact endgame search, in milliseconds
+    bool printEndgameTree = false;       ///< Print the whole endgame strategy, not just the next guess
+    std::string endgameTreePath;         ///< File the endgame strategy is written to (empty = none)
+    bool speculateFeedback = false;      ///< Partition the survivors by feedback while the color line is typed
+    std::string feedbackMatrixDir;       ///< Directory of memory-mapped guess x answer code files (empty = off)
+    size_t feedbackMatrixMaxMb = 256;    ///< Largest feedback matrix file used, in MiB
+    size_t selfPlayGameCount = 0;        ///< Games played against hidden answers, then exit (0 = interactive)
+    int selfPlayLength = 8;              ///< Expression length of the self-play games
+    std::string selfPlayOperators = "+-*/";  ///< Operators of the self-play games
+    size_t selfPlayThreadCount = 0;      ///< Self-play games run at once (0 = one per hardware thread)
+    size_t selfPlaySeed = 1;             ///< Seed of the hidden self-play answers
+    size_t verifyCaseCount = 0;          ///< Random cases checked against the reference engines, then exit (0 = off)
+    int verifyMinLength = 5;             ///< Shortest expression length of the checked cases
+    int verifyMaxLength = 8;             ///< Longest expression length of the checked cases
+    size_t verifySeed = 1;               ///< Seed of the checked cases
+
+    /**
+     * @brief Applies one command-line argument (e.g., `"--trie"`, `"--suggest=3"`).
+     *
+     * @param argument Argument as given on the command line.
+     * @return true if the argument was recognised, false otherwise.
+     */
+    bool applyArgument(std::string_view argument);
+};
@@ -0,0 +1,114 @@
+/* ----- ----- ----- ----- */
+// SpeculativePartition.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#include "SpeculativePartition.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "util/ParallelUtils.h"
+
+namespace {
+
+constexpr size_t MIN_PARTITION_ITEMS_PER_WORKER = 8192;  ///< Below this chunk size, threads cost more than they save
+constexpr size_t CANCEL_CHECK_INTERVAL = 4096;           ///< Survivors coded between two cancellation checks
+
+}  // namespace (end of anonymous)
+
+/**
+ * @brief Starts grouping the survivors by the feedback of a guess on a background thread.
+ *
+ * @param candidatePool Pool `survivorSet` refers to.
+ * @param survivorSet Survivors before the guess.
+ * @param guessLine Guess just entered by the player.
+ */
+void SpeculativePartition::start(const CandidatePool& candidatePool, const SurvivorSet& survivorSet, std::string_view guessLine) {
+    cancel();
+    if (static_cast<int>(guessLine.size()) != candidatePool.getExprLength() || guessLine.size() > FeedbackCode::MAX_LENGTH)
+        return;
+
+    this->guessLine = std::string(guessLine);
+    isCancelled.store(false, std::memory_order_relaxed);
+    workerThread = std::thread([this, &candidatePool, &survivorSet]() { partition(candidatePool, survivorSet); });
+}
+
+/**
+ * @brief Waits for the partition and returns the survivors of one feedback.
+ *
+ * @param guessLine Guess the feedback belongs to.
+ * @param code Observed feedback.
+ * @param[out] survivorSet Survivors left by the feedback.
+ * @return true if a partition for `guessLine` was available; false if the caller must filter itself.
+ */
+bool SpeculativePartition::take(std::string_view guessLine, FeedbackCode::Code code, SurvivorSet& survivorSet) {
+    if (workerThread.joinable()) workerThread.join();
+    const bool isAvailable = !this->guessLine.empty() && this->guessLine == guessLine;
+    if (isAvailable) {
+        auto bucketBegin = std::lower_bound(bucketEntriesList.begin(), bucketEntriesList.end(),
+            std::make_pair(code, CandidateHandle{ 0 }));
+        std::vector<CandidateHandle> bucketHandlesList;
+        for (auto entryIt = bucketBegin; entryIt != bucketEntriesList.end() && entryIt->first == code; ++entryIt)
+            bucketHandlesList.push_back(entryIt->second);
+        survivorSet = SurvivorSet::fromSortedHandles(bucketHandlesList);
+    }
+
+    this->guessLine.clear();
+    bucketEntriesList.clear();
+    return isAvailable;
+}
+
+/**
+ * @brief Stops the background run, if any, and drops its result.
+ */
+void SpeculativePartition::cancel() {
+    isCancelled.store(true, std::memory_order_relaxed);
+    if (workerThread.joinable()) workerThread.join();
+    guessLine.clear();
+    bucketEntriesList.clear();
+}
+
+/**
+ * @brief Codes every survivor against the guess (in parallel), then sorts the (code, handle) pairs.
+ *
+ * <summary>
+ * Sorting by (code, handle) stores every bucket contiguously with its handles in ascending
+ * order, which is what `SurvivorSet::fromSortedHandles` needs. A cancelled run leaves no guess,
+ * so `take` reports it as unavailable.
+ * </summary>
+ */
+void SpeculativePartition::partition(const CandidatePool& candidatePool, const SurvivorSet& survivorSet) {
+    const int exprLength = candidatePool.getExprLength();
+    std::array<std::uint8_t, FeedbackCode::MAX_LENGTH> guessLanes{};
+    FeedbackCode::toLanes(guessLine, guessLanes.data());
+
+    std::vector<CandidateHandle> handlesList = survivorSet.toSortedHandles();
+    bucketEntriesList.resize(handlesList.size());
+
+    const size_t workerCount = ParallelUtils::getWorkerCount(handlesList.size(), MIN_PARTITION_ITEMS_PER_WORKER);
+    const bool isPacked = (exprLength <= FeedbackCode::MAX_PACKED_LENGTH);
+    ParallelUtils::runChunks(ParallelUtils::splitRanges(handlesList.size(), workerCount),
+        [&](size_t, const ParallelUtils::ChunkRange& range) {
+            const FeedbackCode::GuessKernel guessKernel(guessLanes.data(), isPacked ? exprLength : 0);
+            std::array<std::uint8_t, FeedbackCode::MAX_LENGTH> answerLanes{};
+            for (size_t i = range.begin; i < range.end; ++i) {
+                if ((i - range.begin) % CANCEL_CHECK_INTERVAL == 0 && isCancelled.load(std::memory_order_relaxed)) return;
+                FeedbackCode::toLanes(candidatePool.view(handlesList[i]), answerLanes.data());
+                const FeedbackCode::Code code = isPacked
+                    ? guessKernel.compute(FeedbackCode::PackedAnswer(answerLanes.data(), exprLength))
+                    : FeedbackCode::compute(guessLanes.data(), answerLanes.data(), exprLength);
+                bucketEntriesList[i] = { code, handlesList[i] };
+            }
+        });
+
+    if (isCancelled.load(std::memory_order_relaxed)) {
+        guessLine.clear();
+        return;
+    }
+    std::sort(bucketEntriesList.begin(), bucketEntriesList.end());
+}
@@ -0,0 +1,75 @@
+/* ----- ----- ----- ----- */
+// SpeculativePartition.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "CandidatePool.h"
+#include "FeedbackCode.h"
+#include "SurvivorSet.h"
+
+/**
+ * @class SpeculativePartition
+ * @brief Groups the survivors by the feedback of a guess in the background, before the feedback is known.
+ *
+ * <summary>
+ * A survivor stays after a round exactly when it would have produced the observed feedback
+ * for the guess (`FeedbackCode::compute(guess, survivor) == code`). Once the player has entered
+ * the guess, the survivors of every possible feedback can therefore be computed while the
+ * player is still typing the color line. `take` then only looks up one bucket.
+ *
+ * The pool and survivor set given to `start` are read by the background thread, so they must
+ * stay unchanged until `take` or `cancel` returns.
+ * </summary>
+ */
+class SpeculativePartition {
+public:
+    SpeculativePartition() = default;
+    ~SpeculativePartition() { cancel(); }
+
+    SpeculativePartition(const SpeculativePartition&) = delete;
+    SpeculativePartition& operator=(const SpeculativePartition&) = delete;
+
+    /**
+     * @brief Starts grouping the survivors by the feedback of a guess (cancels any previous run).
+     *
+     * @param candidatePool Pool `survivorSet` refers to.
+     * @param survivorSet Survivors before the guess.
+     * @param guessLine Guess just entered by the player.
+     */
+    void start(const CandidatePool& candidatePool, const SurvivorSet& survivorSet, std::string_view guessLine);
+
+    /**
+     * @brief Waits for the partition and returns the survivors of one feedback.
+     *
+     * @param guessLine Guess the feedback belongs to.
+     * @param code Observed feedback.
+     * @param[out] survivorSet Survivors left by the feedback.
+     * @return true if a partition for `guessLine` was available; false if the caller must filter itself.
+     */
+    bool take(std::string_view guessLine, FeedbackCode::Code code, SurvivorSet& survivorSet);
+
+    /**
+     * @brief Stops the background run, if any, and drops its result.
+     */
+    void cancel();
+
+private:
+    void partition(const CandidatePool& candidatePool, const SurvivorSet& survivorSet);
+
+    std::thread workerThread;         ///< Background partition run
+    std::atomic<bool> isCancelled{false};  ///< Asks the background run to stop early
+    std::string guessLine;            ///< Guess of the current partition (empty = none)
+    std::vector<std::pair<FeedbackCode::Code, CandidateHandle>> bucketEntriesList;  ///< (code, handle), sorted
+};
@@ -0,0 +1,307 @@
+/* ----- ----- ----- ----- */
+// SurvivorSet.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#include "SurvivorSet.h"
+#include <iterator>
+
+namespace {
+
+constexpr size_t CHUNK_SIZE = 65536;  ///< Handles per container (low 16 bits)
+
+/**
+ * @brief Counts the maximal runs of consecutive values in a sorted list.
+ */
+size_t countRuns(const std::vector<std::uint16_t>& sortedLowsList) {
+    size_t runCount = 0;
+    for (size_t i = 0; i < sortedLowsList.size(); ++i) {
+        if (i == 0 || sortedLowsList[i] != sortedLowsList[i - 1] + 1) ++runCount;
+    }
+    return runCount;
+}
+
+}  // namespace (end of anonymous)
+
+/**
+ * @brief Builds the smallest container holding `sortedLowsList`.
+ *
+ * <summary>
+ * Sizes compared: array = 2 bytes per value, bitmap = 8 KiB, run = 4 bytes per run.
+ * Ties prefer array, then bitmap.
+ * </summary>
+ *
+ * @param key High 16 bits of the chunk.
+ * @param sortedLowsList Low 16 bits of the handles, strictly ascending.
+ * @return Container The encoded chunk (cardinality 0 if the list is empty).
+ */
+SurvivorSet::Container SurvivorSet::makeContainer(std::uint16_t key, const std::vector<std::uint16_t>& sortedLowsList) {
+    Container container;
+    container.key = key;
+    container.cardinality = static_cast<std::uint32_t>(sortedLowsList.size());
+    if (sortedLowsList.empty()) return container;
+
+    const size_t arrayBytes = sortedLowsList.size() * sizeof(std::uint16_t);
+    const size_t bitmapBytes = BITMAP_WORD_COUNT * sizeof(std::uint64_t);
+    const size_t runBytes = countRuns(sortedLowsList) * 2 * sizeof(std::uint16_t);
+
+    if (runBytes < (std::min)(arrayBytes, bitmapBytes)) {
+        container.kind = ContainerKind::Run;
+        for (size_t i = 0; i < sortedLowsList.size();) {
+            size_t runEnd = i;
+            while (runEnd + 1 < sortedLowsList.size() && sortedLowsList[runEnd + 1] == sortedLowsList[runEnd] + 1)
+                ++runEnd;
+            container.valuesList.push_back(sortedLowsList[i]);
+            container.valuesList.push_back(static_cast<std::uint16_t>(runEnd - i));
+            i = runEnd + 1;
+        }
+    }
+    else if (sortedLowsList.size() <= ARRAY_MAX_CARDINALITY) {
+        container.kind = ContainerKind::Array;
+        container.valuesList = sortedLowsList;
+    }
+    else {
+        container.kind = ContainerKind::Bitmap;
+        container.wordsList.assign(BITMAP_WORD_COUNT, 0);
+        for (std::uint16_t low : sortedLowsList)
+            container.wordsList[low >> 6] |= std::uint64_t{1} << (low & 63);
+    }
+    return container;
+}
+
+/**
+ * @brief Builds a container from bitmap words with a known cardinality.
+ *
+ * Dense results stay a bitmap; sparse ones are re-encoded as the smallest container.
+ */
+SurvivorSet::Container SurvivorSet::makeContainerFromWords(
+    std::uint16_t key,
+    std::vector<std::uint64_t>&& wordsList,
+    size_t wordsCardinality
+) {
+    if (wordsCardinality > ARRAY_MAX_CARDINALITY) {
+        Container container;
+        container.key = key;
+        container.kind = ContainerKind::Bitmap;
+        container.cardinality = static_cast<std::uint32_t>(wordsCardinality);
+        container.wordsList = std::move(wordsList);
+        return container;
+    }
+
+    std::vector<std::uint16_t> lowsList;
+    lowsList.reserve(wordsCardinality);
+    for (size_t wordIndex = 0; wordIndex < wordsList.size(); ++wordIndex) {
+        std::uint64_t word = wordsList[wordIndex];
+        while (word != 0) {
+            lowsList.push_back(static_cast<std::uint16_t>(wordIndex * 64 + std::countr_zero(word)));
+            word &= word - 1;
+        }
+    }
+    return makeContainer(key, lowsList);
+}
+
+/**
+ * @brief True if the low 16 bits `low` are stored in this container.
+ */
+bool SurvivorSet::Container::containsLow(std::uint16_t low) const {
+    switch (kind) {
+    case ContainerKind::Array:
+        return std::binary_search(valuesList.begin(), valuesList.end(), low);
+    case ContainerKind::Bitmap:
+        return (wordsList[low >> 6] >> (low & 63)) & 1u;
+    case ContainerKind::Run: {
+        // Binary search for the last run starting at or before `low`
+        size_t lowRun = 0;
+        size_t highRun = valuesList.size() / 2;
+        while (lowRun < highRun) {
+            size_t midRun = (lowRun + highRun) / 2;
+            if (valuesList[midRun * 2] <= low) lowRun = midRun + 1;
+            else highRun = midRun;
+        }
+        if (lowRun == 0) return false;
+        size_t runIndex = (lowRun - 1) * 2;
+        return static_cast<std::uint32_t>(low) <= static_cast<std::uint32_t>(valuesList[runIndex]) + valuesList[runIndex + 1];
+    }
+    }
+    return false;
+}
+
+/**
+ * @brief Expands the container into bitmap words.
+ */
+std::vector<std::uint64_t> SurvivorSet::Container::toWords() const {
+    if (kind == ContainerKind::Bitmap) return wordsList;
+
+    std::vector<std::uint64_t> expandedWordsList(BITMAP_WORD_COUNT, 0);
+    forEachLow([&](std::uint16_t low) {
+        expandedWordsList[low >> 6] |= std::uint64_t{1} << (low & 63);
+    });
+    return expandedWordsList;
+}
+
+/**
+ * @brief Intersects two containers sharing the same key.
+ *
+ * <summary>
+ * - Array with anything: probe each array value in the other container (cost ~ array size).
+ * - Otherwise: AND the two bitmaps word by word and re-encode the result.
+ * </summary>
+ */
+SurvivorSet::Container SurvivorSet::intersectContainers(const Container& lhs, const Container& rhs) {
+    if (lhs.kind == ContainerKind::Array && rhs.kind == ContainerKind::Array) {
+        std::vector<std::uint16_t> lowsList;
+        std::set_intersection(lhs.valuesList.begin(), lhs.valuesList.end(),
+                              rhs.valuesList.begin(), rhs.valuesList.end(),
+                              std::back_inserter(lowsList));
+        return makeContainer(lhs.key, lowsList);
+    }
+
+    if (lhs.kind == ContainerKind::Array || rhs.kind == ContainerKind::Array) {
+        const Container& arrayContainer = (lhs.kind == ContainerKind::Array) ? lhs : rhs;
+        const Container& otherContainer = (lhs.kind == ContainerKind::Array) ? rhs : lhs;
+
+        std::vector<std::uint16_t> lowsList;
+        for (std::uint16_t low : arrayContainer.valuesList) {
+            if (otherContainer.containsLow(low)) lowsList.push_back(low);
+        }
+        return makeContainer(lhs.key, lowsList);
+    }
+
+    std::vector<std::uint64_t> wordsList = lhs.toWords();
+    std::vector<std::uint64_t> rhsWordsList = rhs.toWords();
+    size_t wordsCardinality = 0;
+    for (size_t i = 0; i < BITMAP_WORD_COUNT; ++i) {
+        wordsList[i] &= rhsWordsList[i];
+        wordsCardinality += static_cast<size_t>(std::popcount(wordsList[i]));
+    }
+    return makeContainerFromWords(lhs.key, std::move(wordsList), wordsCardinality);
+}
+
+/**
+ * @brief Builds a set from handles sorted in strictly ascending order.
+ *
+ * @param sortedHandlesList Handles to store.
+ * @return SurvivorSet The compressed set.
+ */
+SurvivorSet SurvivorSet::fromSortedHandles(const std::vector<CandidateHandle>& sortedHandlesList) {
+    SurvivorSet survivorSet;
+    std::vector<std::uint16_t> lowsList;
+
+    size_t i = 0;
+    while (i < sortedHandlesList.size()) {
+        const std::uint16_t key = static_cast<std::uint16_t>(sortedHandlesList[i] >> 16);
+        lowsList.clear();
+        while (i < sortedHandlesList.size() && static_cast<std::uint16_t>(sortedHandlesList[i] >> 16) == key) {
+            lowsList.push_back(static_cast<std::uint16_t>(sortedHandlesList[i] & 0xFFFF));
+            ++i;
+        }
+        survivorSet.containersList.push_back(makeContainer(key, lowsList));
+    }
+
+    survivorSet.cardinality = sortedHandlesList.size();
+    return survivorSet;
+}
+
+/**
+ * @brief Builds the set `{0, 1, ..., handleCount - 1}`.
+ *
+ * @param handleCount Number of handles (e.g., the size of a `CandidatePool`).
+ * @return SurvivorSet One run container per 64K chunk.
+ */
+SurvivorSet SurvivorSet::fromRange(size_t handleCount) {
+    SurvivorSet survivorSet;
+    for (size_t chunkBegin = 0; chunkBegin < handleCount; chunkBegin += CHUNK_SIZE) {
+        const size_t chunkSize = (std::min)(CHUNK_SIZE, handleCount - chunkBegin);
+
+        Container container;
+        container.key = static_cast<std::uint16_t>(chunkBegin >> 16);
+        container.kind = ContainerKind::Run;
+        container.cardinality = static_cast<std::uint32_t>(chunkSize);
+        container.valuesList = { 0, static_cast<std::uint16_t>(chunkSize - 1) };
+        survivorSet.containersList.push_back(std::move(container));
+    }
+    survivorSet.cardinality = handleCount;
+    return survivorSet;
+}
+
+/**
+ * @brief Lists every handle in ascending order.
+ *
+ * @return std::vector<CandidateHandle> Sorted handles.
+ */
+std::vector<CandidateHandle> SurvivorSet::toSortedHandles() const {
+    std::vector<CandidateHandle> handlesList;
+    handlesList.reserve(cardinality);
+    forEach([&](CandidateHandle handle) { handlesList.push_back(handle); });
+    return handlesList;
+}
+
+/**
+ * @brief True if `handle` is in the set.
+ */
+bool SurvivorSet::contains(CandidateHandle handle) const {
+    const std::uint16_t key = static_cast<std::uint16_t>(handle >> 16);
+    auto containerIt = std::lower_bound(containersList.begin(), containersList.end(), key,
+        [](const Container& container, std::uint16_t searchKey) { return container.key < searchKey; });
+    return containerIt != containersList.end() && containerIt->key == key
+        && containerIt->containsLow(static_cast<std::uint16_t>(handle & 0xFFFF));
+}
+
+/**
+ * @brief Returns the handles present in both sets.
+ *
+ * <summary>
+ * Walks both container lists by key (merge join); only chunks present on both
+ * sides are intersected.
+ * </summary>
+ *
+ * @param other Set to intersect with.
+ * @return SurvivorSet The intersection.
+ */
+SurvivorSet SurvivorSet::intersect(const SurvivorSet& other) const {
+    SurvivorSet result;
+    size_t lhsIndex = 0;
+    size_t rhsIndex = 0;
+    while (lhsIndex < containersList.size() && rhsIndex < other.containersList.size()) {
+        const Container& lhs = containersList[lhsIndex];
+        const Container& rhs = other.containersList[rhsIndex];
+        if (lhs.key < rhs.key) { ++lhsIndex; continue; }
+        if (rhs.key < lhs.key) { ++rhsIndex; continue; }
+
+        result.containersList.push_back(intersectContainers(lhs, rhs));
+        ++lhsIndex;
+        ++rhsIndex;
+    }
+    result.dropEmptyContainers();
+    return result;
+}
+
+/**
+ * @brief Heap memory held by the containers, in bytes.
+ */
+size_t SurvivorSet::getMemoryBytes() const {
+    size_t memoryBytes = containersList.capacity() * sizeof(Container);
+    for (const Container& container : containersList) {
+        memoryBytes += container.valuesList.capacity() * sizeof(std::uint16_t)
+                     + container.wordsList.capacity() * sizeof(std::uint64_t);
+    }
+    return memoryBytes;
+}
+
+/**
+ * @brief Removes empty containers and recomputes `cardinality`.
+ */
+void SurvivorSet::dropEmptyContainers() {
+    containersList.erase(
+        std::remove_if(containersList.begin(), containersList.end(),
+            [](const Container& container) { return container.cardinality == 0; }),
+        containersList.end());
+
+    cardinality = 0;
+    for (const Container& container : containersList)
+        cardinality += container.cardinality;
+}
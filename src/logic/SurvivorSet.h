@@ -0,0 +1,236 @@
+/* ----- ----- ----- ----- */
+// SurvivorSet.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/17
+// Version: v1.1
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "CandidatePool.h"
+#include "util/ParallelUtils.h"
+#include "util/PerfProbes.h"
+
+/**
+ * @class SurvivorSet
+ * @brief Compressed, sorted set of candidate handles (Roaring-style containers per 64K chunk).
+ *
+ * <summary>
+ * The first round may keep millions of candidates, while two or three rounds later only a
+ * handful survive. A flat handle list or a universe-sized bitmap costs the same either way;
+ * this set adapts to the density of each 65536-handle chunk instead:
+ * - **Array**: sorted 16-bit low parts, for sparse chunks (at most 4096 values).
+ * - **Bitmap**: 1024 x 64-bit words, for dense chunks.
+ * - **Run**: (start, length - 1) pairs, for long consecutive ranges (e.g., "every candidate").
+ * Each chunk uses whichever of the three is smallest. Empty chunks are not stored at all.
+ *
+ * Iteration, filtering and intersection work container by container, so their cost follows
+ * the number of survivors rather than the size of the candidate universe. Handles are always
+ * visited in ascending order (= generation order).
+ * </summary>
+ */
+class SurvivorSet {
+public:
+    /**
+     * @enum ContainerKind
+     * @brief Storage used by one 64K chunk.
+     */
+    enum class ContainerKind : std::uint8_t {
+        Array,   ///< Sorted list of low 16-bit values
+        Bitmap,  ///< 65536-bit bitmap
+        Run      ///< Sorted (start, length - 1) pairs
+    };
+
+    static constexpr size_t ARRAY_MAX_CARDINALITY = 4096;  ///< Above this, a bitmap is never larger than an array
+    static constexpr size_t BITMAP_WORD_COUNT = 1024;      ///< 65536 bits
+
+    SurvivorSet() = default;
+
+    /**
+     * @brief Builds a set from handles sorted in strictly ascending order.
+     */
+    static SurvivorSet fromSortedHandles(const std::vector<CandidateHandle>& sortedHandlesList);
+
+    /**
+     * @brief Builds the set `{0, 1, ..., handleCount - 1}` (run containers, a few bytes per chunk).
+     */
+    static SurvivorSet fromRange(size_t handleCount);
+
+    /**
+     * @brief Lists every handle in ascending order.
+     */
+    std::vector<CandidateHandle> toSortedHandles() const;
+
+    /**
+     * @brief Number of handles in the set.
+     */
+    size_t size() const { return cardinality; }
+
+    /**
+     * @brief True if the set holds no handles.
+     */
+    bool empty() const { return cardinality == 0; }
+
+    /**
+     * @brief Removes every handle.
+     */
+    void clear() {
+        containersList.clear();
+        cardinality = 0;
+    }
+
+    /**
+     * @brief True if `handle` is in the set.
+     */
+    bool contains(CandidateHandle handle) const;
+
+    /**
+     * @brief Returns the handles present in both sets.
+     */
+    SurvivorSet intersect(const SurvivorSet& other) const;
+
+    /**
+     * @brief Number of non-empty 64K chunks.
+     */
+    size_t getContainerCount() const { return containersList.size(); }
+
+    /**
+     * @brief Heap memory held by the containers, in bytes.
+     */
+    size_t getMemoryBytes() const;
+
+    /**
+     * @brief Calls `visitFunc(handle)` for every handle, in ascending order.
+     */
+    template <typename VisitFunc>
+    void forEach(VisitFunc&& visitFunc) const {
+        for (const Container& container : containersList)
+            container.forEach(visitFunc);
+    }
+
+    /**
+     * @brief Returns the subset of handles accepted by `keepFunc`, checking chunks in parallel.
+     *
+     * <summary>
+     * Workers normally take whole containers. When the set has fewer containers than
+     * useful workers (every set below 65536 handles sits in one), the handles are
+     * flattened and split evenly instead (`ParallelUtils::compactInPlace`), so small
+     * universes still use every core.
+     * </summary>
+     *
+     * @param keepFunc Predicate `bool(CandidateHandle)`; must be safe to call concurrently.
+     * @param minItemsPerWorker Minimum amount of handles per worker before extra threads are started.
+     * @return SurvivorSet Handles for which `keepFunc` returned true.
+     */
+    template <typename KeepFunc>
+    SurvivorSet filter(KeepFunc&& keepFunc, size_t minItemsPerWorker) const {
+        const size_t usefulWorkerCount = ParallelUtils::getWorkerCount(cardinality, minItemsPerWorker);
+        if (usefulWorkerCount > containersList.size() && usefulWorkerCount > 1) {
+            std::vector<CandidateHandle> handlesList = toSortedHandles();
+            ParallelUtils::compactInPlace(handlesList, keepFunc, minItemsPerWorker);
+            return fromSortedHandles(handlesList);
+        }
+
+        SurvivorSet result;
+        result.containersList.resize(containersList.size());
+
+        size_t workerCount = (std::min)(usefulWorkerCount, (std::max)(containersList.size(), static_cast<size_t>(1)));
+        ParallelUtils::runChunks(ParallelUtils::splitRanges(containersList.size(), workerCount),
+            [&](size_t chunkIndex, const ParallelUtils::ChunkRange& range) {
+                SOLVER_PROBE2(filter_batch_start, chunkIndex, range.end - range.begin);
+                size_t keptCount = 0;
+                std::vector<std::uint16_t> keptLowsList;
+                for (size_t index = range.begin; index < range.end; ++index) {
+                    const Container& container = containersList[index];
+                    const CandidateHandle highBits = static_cast<CandidateHandle>(container.key) << 16;
+
+                    keptLowsList.clear();
+                    container.forEachLow([&](std::uint16_t low) {
+                        if (keepFunc(highBits | low)) keptLowsList.push_back(low);
+                    });
+                    result.containersList[index] = makeContainer(container.key, keptLowsList);
+                    keptCount += keptLowsList.size();
+                }
+                SOLVER_PROBE2(filter_batch_end, chunkIndex, keptCount);
+            });
+
+        result.dropEmptyContainers();
+        return result;
+    }
+
+private:
+    /**
+     * @struct Container
+     * @brief Handles of one 64K chunk sharing the same high 16 bits.
+     */
+    struct Container {
+        std::uint16_t key = 0;                       ///< High 16 bits shared by every handle of the chunk
+        ContainerKind kind = ContainerKind::Array;   ///< Active storage
+        std::uint32_t cardinality = 0;               ///< Number of handles in the chunk
+        std::vector<std::uint16_t> valuesList;       ///< Array: sorted lows; Run: flattened (start, length - 1) pairs
+        std::vector<std::uint64_t> wordsList;        ///< Bitmap: `BITMAP_WORD_COUNT` words
+
+        template <typename LowFunc>
+        void forEachLow(LowFunc&& lowFunc) const {
+            switch (kind) {
+            case ContainerKind::Array:
+                for (std::uint16_t low : valuesList) lowFunc(low);
+                break;
+            case ContainerKind::Bitmap:
+                for (size_t wordIndex = 0; wordIndex < wordsList.size(); ++wordIndex) {
+                    std::uint64_t word = wordsList[wordIndex];
+                    while (word != 0) {
+                        lowFunc(static_cast<std::uint16_t>(wordIndex * 64 + std::countr_zero(word)));
+                        word &= word - 1;
+                    }
+                }
+                break;
+            case ContainerKind::Run:
+                for (size_t i = 0; i + 1 < valuesList.size(); i += 2) {
+                    std::uint32_t runEnd = static_cast<std::uint32_t>(valuesList[i]) + valuesList[i + 1];
+                    for (std::uint32_t low = valuesList[i]; low <= runEnd; ++low)
+                        lowFunc(static_cast<std::uint16_t>(low));
+                }
+                break;
+            }
+        }
+
+        template <typename VisitFunc>
+        void forEach(VisitFunc& visitFunc) const {
+            const CandidateHandle highBits = static_cast<CandidateHandle>(key) << 16;
+            forEachLow([&](std::uint16_t low) { visitFunc(highBits | low); });
+        }
+
+        bool containsLow(std::uint16_t low) const;
+        std::vector<std::uint64_t> toWords() const;
+    };
+
+    std::vector<Container> containersList;  ///< Non-empty chunks, sorted by key
+    size_t cardinality = 0;                 ///< Total number of handles
+
+    /**
+     * @brief Builds the smallest container holding `sortedLowsList`.
+     */
+    static Container makeContainer(std::uint16_t key, const std::vector<std::uint16_t>& sortedLowsList);
+
+    /**
+     * @brief Builds a container from bitmap words with a known cardinality.
+     */
+    static Container makeContainerFromWords(std::uint16_t key, std::vector<std::uint64_t>&& wordsList, size_t wordsCardinality);
+
+    /**
+     * @brief Intersects two containers sharing the same key.
+     */
+    static Container intersectContainers(const Container& lhs, const Container& rhs);
+
+    /**
+     * @brief Removes empty containers and recomputes `cardinality`.
+     */
+    void dropEmptyContainers();
+};
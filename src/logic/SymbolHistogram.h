@@ -0,0 +1,121 @@
+/* ----- ----- ----- ----- */
+// SymbolHistogram.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "core/constants/ExpressionConstants.h"
+
+/**
+ * @file SymbolHistogram.h
+ * @brief Packed per-expression symbol counts (16 lanes x 4 bits in one uint64).
+ *
+ * <summary>
+ * Every expression uses at most the 16 symbols of `Expression::SYMBOLS`
+ * (6 operators + 10 digits). A histogram stores the occurrence count of each symbol
+ * in its own 4-bit lane of a `uint64_t`, lane index = position in `Expression::SYMBOLS`.
+ *
+ * With all counts packed into one word, "is every count inside [min, max]" becomes a
+ * couple of SWAR (SIMD within a register) subtractions instead of a hash-map rebuild.
+ * A lane holds at most 15, so histograms are only used for expressions up to
+ * `MAX_COUNTABLE_LENGTH` characters.
+ * </summary>
+ */
+namespace SymbolHistogram {
+
+using Histogram = std::uint64_t;  ///< 16 lanes x 4-bit counters
+
+inline constexpr int LANE_COUNT = 16;            ///< One lane per symbol in `Expression::SYMBOLS`
+inline constexpr int LANE_BITS = 4;              ///< Width of a lane
+inline constexpr int LANE_MAX = 15;              ///< Largest count a lane can hold
+inline constexpr int MAX_COUNTABLE_LENGTH = 15;  ///< Longest expression whose counts always fit
+
+static_assert(Expression::SYMBOLS.size() == LANE_COUNT, "One histogram lane per expression symbol");
+
+/**
+ * @brief Builds the char -> lane lookup table at compile time (-1 for non-symbols).
+ */
+constexpr std::array<std::int8_t, 256> makeLaneLookup() {
+    std::array<std::int8_t, 256> lookup{};
+    for (auto& lane : lookup) lane = -1;
+    for (size_t i = 0; i < Expression::SYMBOLS.size(); ++i)
+        lookup[static_cast<unsigned char>(Expression::SYMBOLS[i])] = static_cast<std::int8_t>(i);
+    return lookup;
+}
+
+inline constexpr std::array<std::int8_t, 256> LANE_LOOKUP = makeLaneLookup();  ///< char -> lane index
+
+/**
+ * @brief Returns the lane index of a symbol, or -1 if it is not an expression symbol.
+ */
+constexpr int laneOf(char exprChar) {
+    return LANE_LOOKUP[static_cast<unsigned char>(exprChar)];
+}
+
+/**
+ * @brief Reads the count stored in one lane.
+ */
+constexpr int getCount(Histogram histogram, int lane) {
+    return static_cast<int>((histogram >> (lane * LANE_BITS)) & 0xF);
+}
+
+/**
+ * @brief Returns a histogram with one lane set to `count` (clamped to 0..LANE_MAX).
+ */
+constexpr Histogram setCount(Histogram histogram, int lane, int count) {
+    if (count < 0) count = 0;
+    if (count > LANE_MAX) count = LANE_MAX;
+    int shift = lane * LANE_BITS;
+    return (histogram & ~(Histogram{0xF} << shift)) | (static_cast<Histogram>(count) << shift);
+}
+
+/**
+ * @brief Counts every symbol of an expression into a packed histogram.
+ *
+ * @param exprLine Expression of at most `MAX_COUNTABLE_LENGTH` characters.
+ * @return Histogram Packed counts; characters that are not expression symbols are ignored.
+ */
+inline Histogram build(std::string_view exprLine) {
+    Histogram histogram = 0;
+    for (char exprChar : exprLine) {
+        int lane = laneOf(exprChar);
+        if (lane >= 0)
+            histogram += Histogram{1} << (lane * LANE_BITS);
+    }
+    return histogram;
+}
+
+/**
+ * @brief SWAR check that every lane of `lhs` is greater than or equal to the same lane of `rhs`.
+ *
+ * <summary>
+ * Even and odd lanes are spread into 8-bit slots (values 0..15). Setting bit 7 of each
+ * slot in `lhs` before subtracting guarantees no borrow crosses a slot; bit 7 survives
+ * exactly in the slots where `lhs >= rhs`.
+ * </summary>
+ */
+constexpr bool isAllLanesGreaterEqual(Histogram lhs, Histogram rhs) {
+    constexpr Histogram LOW_NIBBLES = 0x0F0F0F0F0F0F0F0FULL;
+    constexpr Histogram SLOT_HIGH_BITS = 0x8080808080808080ULL;
+
+    Histogram evenDiff = ((lhs & LOW_NIBBLES) | SLOT_HIGH_BITS) - (rhs & LOW_NIBBLES);
+    Histogram oddDiff = (((lhs >> 4) & LOW_NIBBLES) | SLOT_HIGH_BITS) - ((rhs >> 4) & LOW_NIBBLES);
+    return ((evenDiff & oddDiff) & SLOT_HIGH_BITS) == SLOT_HIGH_BITS;
+}
+
+/**
+ * @brief True if every lane of `histogram` lies inside `[minCounts, maxCounts]`.
+ */
+constexpr bool isWithinBounds(Histogram histogram, Histogram minCounts, Histogram maxCounts) {
+    return isAllLanesGreaterEqual(histogram, minCounts) && isAllLanesGreaterEqual(maxCounts, histogram);
+}
+
+}  // namespace (end of SymbolHistogram)
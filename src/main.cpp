@@ -3,21 +3,30 @@
 // Do not distribute or modify
 // Author: DragonTaki (https://github.com/DragonTaki)
 // Create Date: 2025/09/28
-// Update Date: 2025/10/19
-// Version: v2.1
+// Update Date: 2026/10/17
+// Version: v2.3
 /* ----- ----- ----- ----- */
 
 #include <algorithm>
+#include <filesystem>
 #include <format>
 #include <iostream>
 #include <unordered_set>
 
 #include "core/constants/ExpressionConstants.h"
 #include "core/logging/AppLogger.h"
+#include "core/logging/LogFileManager.h"
 #include "logic/CandidateGenerator.h"
+#include "logic/DifferentialCheck.h"
 #include "logic/ExpressionValidator.h"
+#include "logic/OpeningBookBuilder.h"
 #include "logic/RoundManager.h"
+#include "logic/SelfPlay.h"
+#include "logic/SolverOptions.h"
+#include "util/AllocationTracker.h"
 #include "util/ConsoleUtils.h"
+#include "util/SolverMetrics.h"
+#include "util/TraceRecorder.h"
 #include "util/Utils.h"
 
 #define FMT_HEADER_ONLY
@@ -34,9 +43,13 @@
  * The main loop handles exceptions gracefully, allows undo or end commands, and supports resetting the game.
  * </summary>
  *
+ * Command-line arguments switch on optional solver features (see `SolverOptions::applyArgument`).
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments.
  * @return int Exit status code (0 for normal termination, non-zero for error)
  */
-int main() {
+int main(int argc, char* argv[]) {
     // ------------------------------
     // Program Initialization
     // ------------------------------
@@ -48,16 +61,61 @@ int main() {
     // ------------------------------
     AppLogger::Initialize();            ///< Initialize the AppLogger system
     std::atexit([]() {                  ///< Ensure logger shutdown on program exit
+        SolverMetrics::stop();
+        TraceRecorder::stop();
         AppLogger::Shutdown();
     });
     AppLogger::EnableTestMode(true);                                 ///< Enable test mode logging (for debug/testing)
     AppLogger::SetLogLevel(LogLevel::Debug);                         ///< Set default log level to Debug
     AppLogger::Debug(std::format("__cplusplus = {}", __cplusplus));  ///< Log C++ version
 
+    // ------------------------------
+    // Solver Options
+    // ------------------------------
+    SolverOptions solverOptions;        ///< Optional solver features (suggestions and exact endgame on by default)
+    for (int argIndex = 1; argIndex < argc; ++argIndex) {
+        if (!solverOptions.applyArgument(argv[argIndex]))
+            AppLogger::Warn(std::format("Unknown argument ignored: {}", argv[argIndex]));
+    }
+
+    if (solverOptions.logAllocationStats && !AllocationTracker::isAvailable())
+        AppLogger::Warn("--alloc-stats needs a build with MATH_SOLVER_TRACK_ALLOCATIONS=ON; all counts will be 0.");
+
+    // Timeline of the solver phases, next to the log file
+    if (solverOptions.writeTrace) {
+        std::filesystem::path tracePath = LogFileManager::GetLogPath().empty()
+            ? std::filesystem::path("solver.log") : std::filesystem::path(LogFileManager::GetLogPath());
+        tracePath.replace_extension(".trace.json");
+        if (TraceRecorder::start(tracePath.string()))
+            AppLogger::Info(std::format("Recording trace to {}", tracePath.string()));
+        else
+            AppLogger::Warn(std::format("Failed to open trace file {}", tracePath.string()));
+    }
+
+    // Solver metrics for node_exporter's textfile collector
+    if (!solverOptions.metricsPath.empty()) {
+        if (SolverMetrics::start(solverOptions.metricsPath, solverOptions.metricsIntervalMs))
+            AppLogger::Info(std::format("Writing metrics to {} every {} ms", solverOptions.metricsPath, solverOptions.metricsIntervalMs));
+        else
+            AppLogger::Warn(std::format("Failed to write metrics file {}", solverOptions.metricsPath));
+    }
+
+    // Offline mode: fill the opening book and exit
+    if (solverOptions.buildOpeningBook)
+        return OpeningBookBuilder::build(solverOptions) ? 0 : 1;
+
+    // Offline mode: play games against hidden answers and exit
+    if (solverOptions.selfPlayGameCount > 0)
+        return SelfPlay::run(solverOptions) ? 0 : 1;
+
+    // Offline mode: check the fast engines against the reference path and exit
+    if (solverOptions.verifyCaseCount > 0)
+        return DifferentialCheck::run(solverOptions) ? 0 : 1;
+
     // ------------------------------
     // Round Manager Initialization
     // ------------------------------
-    RoundManager roundManager;          ///< Handles per-round input, history, constraints, and candidate generation
+    RoundManager roundManager(solverOptions);  ///< Handles per-round input, history, constraints, and candidate generation
     
     // ------------------------------
     // Main Interactive Loop
@@ -90,6 +148,9 @@ int main() {
     // ------------------------------
     // Program Termination
     // ------------------------------
+    roundManager.logSessionReport();
+    SolverMetrics::stop();
+    TraceRecorder::stop();
     AppLogger::Shutdown();  ///< Ensure logger is properly shut down
     return 0;
 }
@@ -0,0 +1,63 @@
+/* ----- ----- ----- ----- */
+// AllocationTracker.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/17
+// Update Date: 2026/10/17
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#include "AllocationTracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::uint64_t> allocationCount{0};  ///< Calls to `operator new` so far
+std::atomic<std::uint64_t> allocatedBytes{0};   ///< Bytes requested so far
+
+}  // namespace (end of anonymous)
+
+#if defined(TRACK_ALLOCATIONS)
+
+namespace {
+
+/**
+ * @brief Counts one allocation, then allocates with `std::malloc`.
+ *
+ * @param size Requested size.
+ * @return void* Allocated block (never null; throws `std::bad_alloc` instead).
+ */
+void* countedAllocate(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) return pointer;
+    throw std::bad_alloc();
+}
+
+}  // namespace (end of anonymous)
+
+// Replaced global allocation functions; the aligned and nothrow forms keep their defaults
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+bool AllocationTracker::isAvailable() {
+    return true;
+}
+
+#else
+
+bool AllocationTracker::isAvailable() {
+    return false;
+}
+
+#endif
+
+AllocationTracker::Counts AllocationTracker::getCounts() {
+    return { allocationCount.load(std::memory_order_relaxed), allocatedBytes.load(std::memory_order_relaxed) };
+}
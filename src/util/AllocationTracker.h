@@ -0,0 +1,65 @@
+/* ----- ----- ----- ----- */
+// AllocationTracker.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/17
+// Update Date: 2026/10/17
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <cstdint>
+
+/**
+ * @namespace AllocationTracker
+ * @brief Heap allocation counters of the process (`--alloc-stats`).
+ *
+ * <summary>
+ * Built with `TRACK_ALLOCATIONS` defined (CMake option `MATH_SOLVER_TRACK_ALLOCATIONS`),
+ * this module replaces the global `operator new`/`operator delete` with versions that
+ * count every allocation and its size. Without it nothing is replaced, `isAvailable()`
+ * is false and every count stays 0.
+ * Counts are process-wide: a `Meter` around a phase also sees allocations made by
+ * other threads at the same time.
+ * </summary>
+ */
+namespace AllocationTracker {
+
+    /**
+     * @struct Counts
+     * @brief Allocations and requested bytes.
+     */
+    struct Counts {
+        std::uint64_t allocationCount = 0;  ///< Calls to `operator new`
+        std::uint64_t allocatedBytes = 0;   ///< Bytes requested by those calls
+    };
+
+    /**
+     * @brief True if the allocator hook was compiled in.
+     */
+    bool isAvailable();
+
+    /**
+     * @brief Allocations made by the process so far.
+     */
+    Counts getCounts();
+
+    /**
+     * @class Meter
+     * @brief Allocations made since construction.
+     */
+    class Meter {
+    public:
+        Meter() : startCounts(getCounts()) {}
+
+        Counts elapsed() const {
+            Counts currentCounts = getCounts();
+            return { currentCounts.allocationCount - startCounts.allocationCount,
+                currentCounts.allocatedBytes - startCounts.allocatedBytes };
+        }
+
+    private:
+        Counts startCounts;  ///< Counts at construction
+    };
+
+}  // namespace AllocationTracker
@@ -3,14 +3,15 @@
 // Do not distribute or modify
 // Author: DragonTaki (https://github.com/DragonTaki)
 // Create Date: 2025/10/16
-// Update Date: 2025/10/16
-// Version: v1.0
+// Update Date: 2026/10/16
+// Version: v1.1
 /* ----- ----- ----- ----- */
 
 #include "ConsoleUtils.h"
 #include <algorithm>
 
 #include "core/logging/AppLogger.h"
+#include "TraceRecorder.h"
 
 #define FMT_HEADER_ONLY
 #include "core.h"
@@ -23,6 +24,19 @@
 #include <unistd.h>
 #endif
 
+namespace {
+
+/**
+ * @brief Shared column layout used by both `printCandidatesInline` overloads.
+ *
+ * @tparam StringLike `std::string` or `std::string_view`.
+ * @param candidatesList Candidates to display.
+ */
+template <typename StringLike>
+void printCandidatesColumns(const std::vector<StringLike>& candidatesList);
+
+}  // namespace (end of internal helpers)
+
 namespace ConsoleUtils {
 
 /**
@@ -72,9 +86,29 @@ int getConsoleWidth() {
  * @param candidatesList Vector of candidate strings to display.
  */
 void printCandidatesInline(const std::vector<std::string>& candidatesList) {
+    TraceRecorder::Span traceSpan("printCandidates");
+    printCandidatesColumns(candidatesList);
+}
+
+/**
+ * @brief Implementation of printCandidatesInline() for string views.
+ *
+ * @param candidatesList Vector of candidate views to display.
+ */
+void printCandidatesInline(const std::vector<std::string_view>& candidatesList) {
+    TraceRecorder::Span traceSpan("printCandidates");
+    printCandidatesColumns(candidatesList);
+}
+
+}  // namespace (end of ConsoleUtils)
+
+namespace {
+
+template <typename StringLike>
+void printCandidatesColumns(const std::vector<StringLike>& candidatesList) {
     if (candidatesList.empty()) return;
 
-    int displayWidth = getConsoleWidth() / 3;
+    int displayWidth = ConsoleUtils::getConsoleWidth() / 3;
     size_t exprLength = candidatesList[0].size();
     int spaceBetweenWidth = 1;
     // Calculate how many columns can fit in each row
@@ -100,4 +134,4 @@ void printCandidatesInline(const std::vector<std::string>& candidatesList) {
     AppLogger::Prompt(rowString, LogColor::Green);
 }
 
-}  // namespace (end of ConsoleUtils)
+}  // namespace (end of internal helpers)
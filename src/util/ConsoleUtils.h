@@ -3,12 +3,13 @@
 // Do not distribute or modify
 // Author: DragonTaki (https://github.com/DragonTaki)
 // Create Date: 2025/10/16
-// Update Date: 2025/10/16
-// Version: v1.0
+// Update Date: 2026/10/16
+// Version: v1.1
 /* ----- ----- ----- ----- */
 
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
@@ -67,4 +68,16 @@ int getConsoleWidth();
  */
 void printCandidatesInline(const std::vector<std::string>& candidates);
 
+/**
+ * @brief Prints candidate views (e.g., resolved from a `CandidatePool`) in multiple columns.
+ *
+ * <summary>
+ * Same layout as the `std::string` overload, but takes non-owning views so callers
+ * holding candidates by handle do not have to copy every expression before printing.
+ * </summary>
+ *
+ * @param candidates Vector of views on candidate entries to print.
+ */
+void printCandidatesInline(const std::vector<std::string_view>& candidates);
+
 }  // namespace (end of ConsoleUtils)
@@ -0,0 +1,73 @@
+/* ----- ----- ----- ----- */
+// LatencyHistogram.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/17
+// Update Date: 2026/10/17
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace {
+
+constexpr std::uint64_t HALF_SUB_BUCKET_COUNT = LatencyHistogram::SUB_BUCKET_COUNT / 2;
+constexpr int SUB_BUCKET_BITS = static_cast<int>(std::bit_width(LatencyHistogram::SUB_BUCKET_COUNT - 1));  ///< 7: values below 128 are exact
+
+// Magnitude of the largest 64-bit value, plus the exact range
+constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * HALF_SUB_BUCKET_COUNT + HALF_SUB_BUCKET_COUNT;
+
+}  // namespace (end of anonymous)
+
+LatencyHistogram::LatencyHistogram() : bucketCountsList(BUCKET_COUNT, 0) {}
+
+/**
+ * @brief Bucket of a value.
+ *
+ * <summary>
+ * The magnitude `m` is how far the value must be shifted right to fall in
+ * [SUB_BUCKET_COUNT / 2, SUB_BUCKET_COUNT); the bucket is `m * 64 + (value >> m)`, which
+ * continues the exact buckets `[0, SUB_BUCKET_COUNT)` without gaps.
+ * </summary>
+ */
+size_t LatencyHistogram::getBucketIndex(std::uint64_t valueUs) {
+    const int magnitude = (std::max)(0, static_cast<int>(std::bit_width(valueUs)) - SUB_BUCKET_BITS);
+    return static_cast<size_t>(magnitude) * HALF_SUB_BUCKET_COUNT + static_cast<size_t>(valueUs >> magnitude);
+}
+
+std::uint64_t LatencyHistogram::getBucketUpperValue(size_t bucketIndex) {
+    if (bucketIndex < SUB_BUCKET_COUNT) return bucketIndex;
+    const size_t magnitude = bucketIndex / HALF_SUB_BUCKET_COUNT - 1;
+    const std::uint64_t subBucket = bucketIndex - magnitude * HALF_SUB_BUCKET_COUNT;
+    return ((subBucket + 1) << magnitude) - 1;
+}
+
+void LatencyHistogram::record(std::uint64_t valueUs) {
+    ++bucketCountsList[getBucketIndex(valueUs)];
+    ++totalCount;
+    maxValue = (std::max)(maxValue, valueUs);
+    valueSum += valueUs;
+}
+
+/**
+ * @brief Value at a percentile of the records.
+ *
+ * @param percentile Percentile in [0, 100] (e.g. 99 for p99).
+ * @return std::uint64_t Upper edge of the bucket holding the record of that rank, clamped to `getMax()`.
+ */
+std::uint64_t LatencyHistogram::getPercentile(double percentile) const {
+    if (totalCount == 0) return 0;
+    const double clampedPercentile = (std::min)(100.0, (std::max)(0.0, percentile));
+    const size_t targetRank = (std::max)(size_t{1},
+        static_cast<size_t>(std::ceil(clampedPercentile / 100.0 * static_cast<double>(totalCount))));
+
+    size_t cumulativeCount = 0;
+    for (size_t bucketIndex = 0; bucketIndex < bucketCountsList.size(); ++bucketIndex) {
+        cumulativeCount += bucketCountsList[bucketIndex];
+        if (cumulativeCount >= targetRank) return (std::min)(getBucketUpperValue(bucketIndex), maxValue);
+    }
+    return maxValue;
+}
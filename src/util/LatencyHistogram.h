@@ -0,0 +1,64 @@
+/* ----- ----- ----- ----- */
+// LatencyHistogram.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/17
+// Update Date: 2026/10/17
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class LatencyHistogram
+ * @brief Log-linear (HDR-style) histogram of durations in microseconds.
+ *
+ * <summary>
+ * Values below `SUB_BUCKET_COUNT` get one bucket each. Above that, every power of two
+ * is split into `SUB_BUCKET_COUNT / 2` equal buckets, so a bucket is never wider than
+ * 1/64 of its values (under 1.6% error) and any 64-bit value fits in a few thousand
+ * buckets. Recording is O(1) and allocation-free once constructed.
+ * </summary>
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    /**
+     * @brief Records one duration.
+     */
+    void record(std::uint64_t valueUs);
+
+    /**
+     * @brief Smallest recorded value at or above `percentile` percent of the records.
+     *
+     * @param percentile Percentile in [0, 100].
+     * @return std::uint64_t Upper edge of the bucket holding that record, clamped to `getMax()`; 0 if empty.
+     */
+    std::uint64_t getPercentile(double percentile) const;
+
+    size_t getCount() const { return totalCount; }
+    std::uint64_t getMax() const { return maxValue; }
+    double getMean() const { return totalCount == 0 ? 0.0 : static_cast<double>(valueSum) / static_cast<double>(totalCount); }
+
+    static constexpr std::uint64_t SUB_BUCKET_COUNT = 128;  ///< Exact buckets below this value; 64 buckets per power of two above
+
+private:
+    /**
+     * @brief Bucket of `valueUs`.
+     */
+    static size_t getBucketIndex(std::uint64_t valueUs);
+
+    /**
+     * @brief Largest value that falls in bucket `bucketIndex`.
+     */
+    static std::uint64_t getBucketUpperValue(size_t bucketIndex);
+
+    std::vector<std::uint64_t> bucketCountsList;  ///< Records per bucket
+    size_t totalCount = 0;                        ///< Records in total
+    std::uint64_t maxValue = 0;                   ///< Largest record
+    std::uint64_t valueSum = 0;                   ///< Sum of the records (for the mean)
+};
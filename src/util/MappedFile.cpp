@@ -0,0 +1,90 @@
+/* ----- ----- ----- ----- */
+// MappedFile.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Maps a whole file read-only.
+ *
+ * <summary>
+ * The file handle is closed right after mapping; the mapping keeps the file alive by itself.
+ * </summary>
+ *
+ * @param filePath File to map.
+ * @return true if the file exists, is not empty and was mapped.
+ */
+bool MappedFile::open(const std::string& filePath) {
+    close();
+
+#if defined(_WIN32)
+    HANDLE fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(fileHandle);
+        return false;
+    }
+    HANDLE newMappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(fileHandle);
+    if (newMappingHandle == nullptr) return false;
+
+    const void* view = MapViewOfFile(newMappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(newMappingHandle);
+        return false;
+    }
+    mappingHandle = newMappingHandle;
+    mappedData = view;
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) return false;
+
+    struct stat fileStat{};
+    if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0) {
+        ::close(fileDescriptor);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    ::close(fileDescriptor);
+    if (view == MAP_FAILED) return false;
+
+    mappedData = view;
+    mappedSize = static_cast<size_t>(fileStat.st_size);
+#endif
+    return true;
+}
+
+/**
+ * @brief Unmaps the file, if any.
+ */
+void MappedFile::close() {
+    if (mappedData == nullptr) return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(mappedData);
+    CloseHandle(mappingHandle);
+    mappingHandle = nullptr;
+#else
+    munmap(const_cast<void*>(mappedData), mappedSize);
+#endif
+    mappedData = nullptr;
+    mappedSize = 0;
+}
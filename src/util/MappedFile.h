@@ -0,0 +1,68 @@
+/* ----- ----- ----- ----- */
+// MappedFile.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * <summary>
+ * The file is mapped, not read: pages are loaded on first access and, being read-only and
+ * backed by the file, shared by every process mapping the same file.
+ * - Windows: `CreateFileMapping` + `MapViewOfFile`.
+ * - Unix-like: `mmap` with `PROT_READ` / `MAP_SHARED`.
+ * The mapping is released by `close` or the destructor.
+ * </summary>
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Maps a file (closes any previous mapping).
+     *
+     * @param filePath File to map.
+     * @return true if the file exists, is not empty and was mapped.
+     */
+    bool open(const std::string& filePath);
+
+    /**
+     * @brief Unmaps the file, if any.
+     */
+    void close();
+
+    /**
+     * @brief True if a file is mapped.
+     */
+    bool isOpen() const { return mappedData != nullptr; }
+
+    /**
+     * @brief First byte of the mapping (nullptr if closed).
+     */
+    const unsigned char* data() const { return static_cast<const unsigned char*>(mappedData); }
+
+    /**
+     * @brief Size of the mapping in bytes.
+     */
+    size_t size() const { return mappedSize; }
+
+private:
+    const void* mappedData = nullptr;  ///< Start of the mapping
+    size_t mappedSize = 0;             ///< Length of the mapping
+#if defined(_WIN32)
+    void* mappingHandle = nullptr;     ///< File mapping object
+#endif
+};
@@ -0,0 +1,257 @@
+/* ----- ----- ----- ----- */
+// ParallelUtils.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/17
+// Version: v1.4
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "PerfProbes.h"
+#include "TraceRecorder.h"
+
+/**
+ * @file ParallelUtils.h
+ * @brief Lightweight helpers for splitting work on large candidate lists across threads.
+ *
+ * <summary>
+ * The solver repeatedly walks lists that can hold millions of candidates (first-round
+ * candidate lists, filter passes, scoring sweeps). These helpers split such a list into
+ * contiguous chunks, run one worker thread per chunk, and propagate the first worker
+ * exception back to the caller. Small inputs stay on the calling thread so that
+ * late rounds do not pay thread start-up costs.
+ * </summary>
+ */
+namespace ParallelUtils {
+
+/**
+ * @struct ChunkRange
+ * @brief Half-open index range `[begin, end)` handled by a single worker.
+ */
+struct ChunkRange {
+    size_t begin = 0;  ///< First index of the chunk
+    size_t end = 0;    ///< One past the last index of the chunk
+};
+
+/**
+ * @brief Most workers the calling thread may use per workload (0 = no limit).
+ *
+ * <summary>
+ * Set through `WorkerLimitScope` by code that already runs one job per thread (e.g.
+ * self-play games), so the passes inside each job do not start threads of their own.
+ * </summary>
+ */
+inline size_t& getThreadWorkerLimit() {
+    thread_local size_t workerLimit = 0;
+    return workerLimit;
+}
+
+/**
+ * @class WorkerLimitScope
+ * @brief Limits `getWorkerCount` on the calling thread until the scope ends.
+ */
+class WorkerLimitScope {
+public:
+    explicit WorkerLimitScope(size_t workerLimit) : previousLimit(getThreadWorkerLimit()) {
+        getThreadWorkerLimit() = workerLimit;
+    }
+    ~WorkerLimitScope() { getThreadWorkerLimit() = previousLimit; }
+
+    WorkerLimitScope(const WorkerLimitScope&) = delete;
+    WorkerLimitScope& operator=(const WorkerLimitScope&) = delete;
+
+private:
+    size_t previousLimit;  ///< Limit restored when the scope ends
+};
+
+/**
+ * @brief Decides how many worker threads are worth starting for a workload.
+ *
+ * <summary>
+ * Uses `std::thread::hardware_concurrency()` (or the calling thread's
+ * `WorkerLimitScope`, if lower) as the upper bound and guarantees
+ * every worker receives at least `minItemsPerWorker` items.
+ * Always returns at least 1.
+ * </summary>
+ *
+ * @param itemCount Number of items to process.
+ * @param minItemsPerWorker Minimum amount of items one worker should receive.
+ * @return size_t Number of workers to use.
+ */
+inline size_t getWorkerCount(size_t itemCount, size_t minItemsPerWorker) {
+    size_t hardwareCount = std::thread::hardware_concurrency();
+    if (hardwareCount == 0) hardwareCount = 1;  // Unknown on this platform => single thread
+    if (getThreadWorkerLimit() > 0) hardwareCount = (std::min)(hardwareCount, getThreadWorkerLimit());
+
+    size_t perWorker = (std::max)(static_cast<size_t>(1), minItemsPerWorker);
+    size_t usefulCount = itemCount / perWorker;
+    return (std::max)(static_cast<size_t>(1), (std::min)(hardwareCount, usefulCount));
+}
+
+/**
+ * @brief Splits `[0, itemCount)` into `chunkCount` contiguous ranges of nearly equal size.
+ *
+ * @param itemCount Number of items.
+ * @param chunkCount Number of ranges to produce (at least 1).
+ * @return std::vector<ChunkRange> Ranges in ascending order, covering every index once.
+ */
+inline std::vector<ChunkRange> splitRanges(size_t itemCount, size_t chunkCount) {
+    chunkCount = (std::max)(static_cast<size_t>(1), chunkCount);
+
+    std::vector<ChunkRange> rangesList(chunkCount);
+    size_t baseSize = itemCount / chunkCount;
+    size_t remainder = itemCount % chunkCount;
+    size_t begin = 0;
+    for (size_t i = 0; i < chunkCount; ++i) {
+        size_t size = baseSize + (i < remainder ? 1 : 0);  // Spread the remainder over the first chunks
+        rangesList[i] = {begin, begin + size};
+        begin += size;
+    }
+    return rangesList;
+}
+
+/**
+ * @brief Runs `func(chunkIndex, range)` for every range, one thread per range.
+ *
+ * <summary>
+ * The last range runs on the calling thread. If any worker throws, the
+ * remaining workers still finish and the first captured exception is rethrown.
+ * When a trace is recorded, every chunk is a span named after the caller's open span,
+ * on track `chunkIndex + 1` for workers (see `TraceRecorder`).
+ * </summary>
+ *
+ * @param rangesList Ranges produced by `splitRanges()`.
+ * @param func Callable with signature `void(size_t chunkIndex, const ChunkRange& range)`.
+ */
+template <typename Func>
+void runChunks(const std::vector<ChunkRange>& rangesList, Func&& func) {
+    if (rangesList.empty()) return;
+    if (rangesList.size() == 1) {
+        func(static_cast<size_t>(0), rangesList[0]);
+        return;
+    }
+
+    std::vector<std::exception_ptr> errorsList(rangesList.size());
+    std::vector<std::thread> workersList;
+    workersList.reserve(rangesList.size() - 1);
+
+    const char* passName = TraceRecorder::getCurrentSpanName();
+    auto runGuarded = [&](size_t chunkIndex) {
+        TraceRecorder::Span chunkSpan(passName ? passName : "chunk");
+        chunkSpan.setArg("chunk", static_cast<long long>(chunkIndex));
+        chunkSpan.setArg("items", static_cast<long long>(rangesList[chunkIndex].end - rangesList[chunkIndex].begin));
+        try {
+            func(chunkIndex, rangesList[chunkIndex]);
+        } catch (...) {
+            errorsList[chunkIndex] = std::current_exception();
+        }
+    };
+
+    for (size_t i = 0; i + 1 < rangesList.size(); ++i) {
+        workersList.emplace_back([&runGuarded, i]() {
+            TraceRecorder::TrackScope trackScope(i + 1);
+            runGuarded(i);
+        });
+    }
+    runGuarded(rangesList.size() - 1);  // Calling thread takes the last chunk
+
+    for (auto& worker : workersList)
+        worker.join();
+
+    for (auto& error : errorsList) {
+        if (error) std::rethrow_exception(error);
+    }
+}
+
+/**
+ * @brief Runs `func(workerIndex, block)` over `[0, itemCount)` in blocks claimed on demand.
+ *
+ * <summary>
+ * Unlike `runChunks`, the ranges are not fixed up front: each of the `workerCount`
+ * workers repeatedly claims the next block of `blockSize` items from a shared counter
+ * until none is left. Use it when items take very different times to process.
+ * A worker's calls are sequential, so per-worker state can be indexed by `workerIndex`.
+ * </summary>
+ *
+ * @param itemCount Number of items.
+ * @param blockSize Items per claimed block (at least 1).
+ * @param workerCount Number of workers (see `getWorkerCount()`).
+ * @param func Callable with signature `void(size_t workerIndex, const ChunkRange& block)`.
+ */
+template <typename Func>
+void runBlocks(size_t itemCount, size_t blockSize, size_t workerCount, Func&& func) {
+    blockSize = (std::max)(static_cast<size_t>(1), blockSize);
+    std::atomic<size_t> nextBegin{0};
+    runChunks(splitRanges(workerCount, workerCount), [&](size_t workerIndex, const ChunkRange&) {
+        for (size_t begin = nextBegin.fetch_add(blockSize); begin < itemCount; begin = nextBegin.fetch_add(blockSize))
+            func(workerIndex, ChunkRange{begin, (std::min)(itemCount, begin + blockSize)});
+    });
+}
+
+/**
+ * @brief Removes every item rejected by `keepFunc`, in place, keeping the original order.
+ *
+ * <summary>
+ * The list is split into chunks that are processed in parallel:
+ * 1. Each worker evaluates `keepFunc` on its own chunk and moves the survivors to the
+ *    front of that chunk (a stable, chunk-local compaction), recording the survivor count.
+ * 2. The calling thread then slides every chunk's survivor block down to its final offset
+ *    (prefix sum of the survivor counts) with `std::move`, and erases the tail.
+ *
+ * Survivors are moved, never copied. `keepFunc` must be safe to call concurrently.
+ * </summary>
+ *
+ * @param itemsList List to filter in place.
+ * @param keepFunc Predicate `bool(const T&)`; true keeps the item.
+ * @param minItemsPerWorker Minimum chunk size before extra threads are started.
+ * @return size_t Number of surviving items (the new list size).
+ */
+template <typename T, typename KeepFunc>
+size_t compactInPlace(std::vector<T>& itemsList, KeepFunc&& keepFunc, size_t minItemsPerWorker) {
+    const size_t itemCount = itemsList.size();
+    if (itemCount == 0) return 0;
+
+    std::vector<ChunkRange> rangesList = splitRanges(itemCount, getWorkerCount(itemCount, minItemsPerWorker));
+    std::vector<size_t> survivorCountsList(rangesList.size(), 0);
+
+    // Phase 1: chunk-local stable compaction
+    runChunks(rangesList, [&](size_t chunkIndex, const ChunkRange& range) {
+        SOLVER_PROBE2(filter_batch_start, chunkIndex, range.end - range.begin);
+        size_t writeIndex = range.begin;
+        for (size_t readIndex = range.begin; readIndex < range.end; ++readIndex) {
+            if (!keepFunc(itemsList[readIndex])) continue;
+            if (writeIndex != readIndex)
+                itemsList[writeIndex] = std::move(itemsList[readIndex]);
+            ++writeIndex;
+        }
+        survivorCountsList[chunkIndex] = writeIndex - range.begin;
+        SOLVER_PROBE2(filter_batch_end, chunkIndex, survivorCountsList[chunkIndex]);
+    });
+
+    // Phase 2: slide survivor blocks down to their prefix-sum offsets
+    size_t outputOffset = 0;
+    for (size_t i = 0; i < rangesList.size(); ++i) {
+        size_t blockBegin = rangesList[i].begin;
+        size_t blockSize = survivorCountsList[i];
+        if (outputOffset != blockBegin) {
+            std::move(itemsList.begin() + blockBegin,
+                      itemsList.begin() + blockBegin + blockSize,
+                      itemsList.begin() + outputOffset);
+        }
+        outputOffset += blockSize;
+    }
+
+    itemsList.erase(itemsList.begin() + outputOffset, itemsList.end());
+    return outputOffset;
+}
+
+}  // namespace (end of ParallelUtils)
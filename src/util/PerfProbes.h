@@ -0,0 +1,47 @@
+/* ----- ----- ----- ----- */
+// PerfProbes.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/17
+// Update Date: 2026/10/17
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+
+/**
+ * @file PerfProbes.h
+ * @brief Static tracepoints (USDT) for Linux perf, bpftrace and SystemTap.
+ *
+ * <summary>
+ * With `SOLVER_PERF_PROBES` defined (CMake option `MATH_SOLVER_PERF_PROBES`) and
+ * `<sys/sdt.h>` available, every `SOLVER_PROBE*` site compiles to a single `nop` plus
+ * an ELF note naming the probe and where its arguments live. Nothing runs at the
+ * site until a tracer attaches, e.g.:
+ * - `perf buildid-cache --add <solver>` then `perf probe sdt_math_solver:dfs_enter`
+ * - `bpftrace -e 'usdt:<solver>:math_solver:candidate_accept { @[str(arg1)] = count(); }'`
+ * Otherwise the macros only name their arguments in an unevaluated `sizeof`, so they
+ * generate no code and raise no unused-variable warnings; arguments must be free of
+ * side effects.
+ *
+ * Probes (provider `math_solver`):
+ * - `dfs_enter(depth, tokenCount)`: entry of `CandidateGenerator::_dfsGenerateLeftTokens`.
+ * - `leaf_eval(eqPos, lhsLength)`: a complete LHS is about to be evaluated.
+ * - `candidate_accept(eqPos, exprLine)`: a candidate passed every check (`exprLine` is a C string).
+ * - `filter_batch_start(chunkIndex, itemCount)` / `filter_batch_end(chunkIndex, keptCount)`:
+ *   one chunk of a filter pass, on the thread that runs it.
+ * </summary>
+ */
+
+#if defined(SOLVER_PERF_PROBES) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define SOLVER_PERF_PROBES_AVAILABLE 1
+#endif
+#endif
+
+#if defined(SOLVER_PERF_PROBES_AVAILABLE)
+#define SOLVER_PROBE2(name, arg1, arg2) DTRACE_PROBE2(math_solver, name, arg1, arg2)
+#else
+#define SOLVER_PROBE2(name, arg1, arg2) ((void)sizeof((arg1), (arg2)))
+#endif
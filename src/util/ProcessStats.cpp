@@ -0,0 +1,59 @@
+/* ----- ----- ----- ----- */
+// ProcessStats.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#include "ProcessStats.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fstream>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Largest resident memory of the process so far, in bytes.
+ *
+ * <summary>
+ * `ru_maxrss` is in KiB on Linux and in bytes on macOS.
+ * </summary>
+ */
+std::uint64_t ProcessStats::getPeakMemoryBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS memoryCounters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters))) return 0;
+    return static_cast<std::uint64_t>(memoryCounters.PeakWorkingSetSize);
+#else
+    rusage resourceUsage{};
+    if (getrusage(RUSAGE_SELF, &resourceUsage) != 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<std::uint64_t>(resourceUsage.ru_maxrss);
+#else
+    return static_cast<std::uint64_t>(resourceUsage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+/**
+ * @brief Current resident memory of the process, in bytes.
+ */
+std::uint64_t ProcessStats::getCurrentMemoryBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS memoryCounters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters))) return 0;
+    return static_cast<std::uint64_t>(memoryCounters.WorkingSetSize);
+#else
+    std::ifstream ifs("/proc/self/statm");
+    std::uint64_t totalPages = 0;
+    std::uint64_t residentPages = 0;
+    if (!(ifs >> totalPages >> residentPages)) return 0;
+    return residentPages * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
@@ -0,0 +1,35 @@
+/* ----- ----- ----- ----- */
+// ProcessStats.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/16
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <cstdint>
+
+/**
+ * @namespace ProcessStats
+ * @brief Resource usage of the running process, as reported by the operating system.
+ *
+ * <summary>
+ * - Windows: `GetProcessMemoryInfo`.
+ * - Unix-like: `getrusage` (peak) and `/proc/self/statm` (current, Linux only).
+ * A value the platform cannot report is 0.
+ * </summary>
+ */
+namespace ProcessStats {
+
+    /**
+     * @brief Largest resident memory of the process so far, in bytes.
+     */
+    std::uint64_t getPeakMemoryBytes();
+
+    /**
+     * @brief Current resident memory of the process, in bytes.
+     */
+    std::uint64_t getCurrentMemoryBytes();
+
+}  // namespace ProcessStats
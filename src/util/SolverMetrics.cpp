@@ -0,0 +1,203 @@
+/* ----- ----- ----- ----- */
+// SolverMetrics.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/17
+// Update Date: 2026/10/17
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#include "SolverMetrics.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+namespace SolverMetrics {
+
+namespace {
+
+constexpr size_t COUNTER_COUNT = static_cast<size_t>(Counter::Count);
+constexpr size_t HISTOGRAM_COUNT = static_cast<size_t>(Histogram::Count);
+constexpr size_t MAX_BUCKET_BOUND_COUNT = 12;  ///< Most finite buckets of a histogram (`+Inf` comes on top)
+constexpr std::uint64_t MIN_EXPORT_INTERVAL_MS = 100;  ///< Shorter export intervals are raised to this
+
+/**
+ * @struct CounterInfo
+ * @brief Exported name of a counter. Consecutive counters of the same name differ by labels.
+ */
+struct CounterInfo {
+    const char* metricName;
+    const char* labelsText;  ///< Without braces; empty if none
+    const char* helpText;
+};
+
+/**
+ * @struct HistogramInfo
+ * @brief Exported name and buckets of a histogram.
+ */
+struct HistogramInfo {
+    const char* metricName;
+    const char* helpText;
+    double unitDivisor;  ///< Recorded units per exported unit (1e6 for microseconds as seconds)
+    std::array<std::uint64_t, MAX_BUCKET_BOUND_COUNT> bucketBoundsList;  ///< Upper bounds in recorded units, ascending
+    size_t bucketBoundCount;
+};
+
+constexpr const char* CACHE_HELP = "Cache lookups of the solver, by cache and result.";
+
+constexpr std::array<CounterInfo, COUNTER_COUNT> COUNTER_INFOS = {{
+    { "math_solver_sessions_started_total", "", "Games started (an expression spec was read)." },
+    { "math_solver_rounds_processed_total", "", "Guess and feedback pairs processed." },
+    { "math_solver_candidates_generated_total", "", "Candidates produced by first-round generation." },
+    { "math_solver_cache_lookups_total", "cache=\"speculation\",result=\"hit\"", CACHE_HELP },
+    { "math_solver_cache_lookups_total", "cache=\"speculation\",result=\"miss\"", CACHE_HELP },
+    { "math_solver_cache_lookups_total", "cache=\"universe\",result=\"hit\"", CACHE_HELP },
+    { "math_solver_cache_lookups_total", "cache=\"universe\",result=\"miss\"", CACHE_HELP },
+    { "math_solver_cache_lookups_total", "cache=\"opening_book\",result=\"hit\"", CACHE_HELP },
+    { "math_solver_cache_lookups_total", "cache=\"opening_book\",result=\"miss\"", CACHE_HELP },
+    { "math_solver_cache_lookups_total", "cache=\"endgame_memo\",result=\"hit\"", CACHE_HELP },
+    { "math_solver_cache_lookups_total", "cache=\"endgame_memo\",result=\"miss\"", CACHE_HELP },
+}};
+
+constexpr std::array<HistogramInfo, HISTOGRAM_COUNT> HISTOGRAM_INFOS = {{
+    { "math_solver_generate_seconds", "First-round candidate generation time.", 1e6,
+        { 1000, 5000, 10000, 50000, 100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000 }, 11 },
+    { "math_solver_filter_seconds", "Later-round candidate filtering time.", 1e6,
+        { 100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000 }, 9 },
+    { "math_solver_round_survivors", "Candidates left after each round.", 1.0,
+        { 1, 10, 100, 1000, 10000, 100000, 1000000 }, 7 },
+}};
+
+/**
+ * @struct HistogramState
+ * @brief Live values of one histogram; buckets are not cumulative until rendered.
+ */
+struct HistogramState {
+    std::array<std::atomic<std::uint64_t>, MAX_BUCKET_BOUND_COUNT + 1> bucketCountsList{};  ///< Last bucket is `+Inf`
+    std::atomic<std::uint64_t> valueSum{0};
+};
+
+std::array<std::atomic<std::uint64_t>, COUNTER_COUNT> counterValuesList{};
+std::array<HistogramState, HISTOGRAM_COUNT> histogramStatesList;
+
+// Background export
+std::mutex exportMutex;
+std::condition_variable exportCondition;
+std::thread exportThread;
+bool isStopRequested = false;
+std::string exportPath;
+
+/**
+ * @brief Writes `render()` to `<exportPath>.tmp`, then renames it over `exportPath`.
+ *
+ * @return true if both steps succeeded.
+ */
+bool writeExportFile() {
+    const std::string tempPath = exportPath + ".tmp";
+    {
+        std::ofstream exportFile(tempPath, std::ios::binary | std::ios::trunc);
+        if (!exportFile) return false;
+        exportFile << render();
+        if (!exportFile) return false;
+    }
+    std::error_code errorCode;
+    std::filesystem::rename(tempPath, exportPath, errorCode);
+    return !errorCode;
+}
+
+}  // namespace (end of anonymous)
+
+void add(Counter counter, std::uint64_t value) {
+    counterValuesList[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+}
+
+void observe(Histogram histogram, std::uint64_t value) {
+    const HistogramInfo& histogramInfo = HISTOGRAM_INFOS[static_cast<size_t>(histogram)];
+    HistogramState& histogramState = histogramStatesList[static_cast<size_t>(histogram)];
+    size_t bucketIndex = 0;
+    while (bucketIndex < histogramInfo.bucketBoundCount && value > histogramInfo.bucketBoundsList[bucketIndex]) ++bucketIndex;
+    histogramState.bucketCountsList[bucketIndex].fetch_add(1, std::memory_order_relaxed);
+    histogramState.valueSum.fetch_add(value, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Every metric in the Prometheus text exposition format.
+ *
+ * <summary>
+ * Each metric name gets one `# HELP` and `# TYPE` line. Histogram buckets are rendered
+ * cumulatively with `le` in exported units, as the format requires. Values are read
+ * one by one, so a histogram may be off by the observations made while rendering.
+ * </summary>
+ */
+std::string render() {
+    std::string exportText;
+    const char* previousName = "";
+    for (size_t counterIndex = 0; counterIndex < COUNTER_COUNT; ++counterIndex) {
+        const CounterInfo& counterInfo = COUNTER_INFOS[counterIndex];
+        if (std::string_view(counterInfo.metricName) != previousName) {
+            exportText += std::format("# HELP {} {}\n# TYPE {} counter\n",
+                counterInfo.metricName, counterInfo.helpText, counterInfo.metricName);
+            previousName = counterInfo.metricName;
+        }
+        const std::uint64_t counterValue = counterValuesList[counterIndex].load(std::memory_order_relaxed);
+        if (*counterInfo.labelsText)
+            exportText += std::format("{}{{{}}} {}\n", counterInfo.metricName, counterInfo.labelsText, counterValue);
+        else
+            exportText += std::format("{} {}\n", counterInfo.metricName, counterValue);
+    }
+
+    for (size_t histogramIndex = 0; histogramIndex < HISTOGRAM_COUNT; ++histogramIndex) {
+        const HistogramInfo& histogramInfo = HISTOGRAM_INFOS[histogramIndex];
+        const HistogramState& histogramState = histogramStatesList[histogramIndex];
+        exportText += std::format("# HELP {} {}\n# TYPE {} histogram\n",
+            histogramInfo.metricName, histogramInfo.helpText, histogramInfo.metricName);
+        std::uint64_t cumulativeCount = 0;
+        for (size_t bucketIndex = 0; bucketIndex < histogramInfo.bucketBoundCount; ++bucketIndex) {
+            cumulativeCount += histogramState.bucketCountsList[bucketIndex].load(std::memory_order_relaxed);
+            exportText += std::format("{}_bucket{{le=\"{}\"}} {}\n", histogramInfo.metricName,
+                static_cast<double>(histogramInfo.bucketBoundsList[bucketIndex]) / histogramInfo.unitDivisor, cumulativeCount);
+        }
+        cumulativeCount += histogramState.bucketCountsList[histogramInfo.bucketBoundCount].load(std::memory_order_relaxed);
+        exportText += std::format("{}_bucket{{le=\"+Inf\"}} {}\n", histogramInfo.metricName, cumulativeCount);
+        exportText += std::format("{}_sum {}\n", histogramInfo.metricName,
+            static_cast<double>(histogramState.valueSum.load(std::memory_order_relaxed)) / histogramInfo.unitDivisor);
+        exportText += std::format("{}_count {}\n", histogramInfo.metricName, cumulativeCount);
+    }
+    return exportText;
+}
+
+bool start(const std::string& filePath, std::uint64_t intervalMs) {
+    stop();
+    exportPath = filePath;
+    if (!writeExportFile()) return false;
+
+    isStopRequested = false;
+    const std::chrono::milliseconds exportInterval((std::max)(intervalMs, MIN_EXPORT_INTERVAL_MS));
+    exportThread = std::thread([exportInterval]() {
+        std::unique_lock<std::mutex> exportLock(exportMutex);
+        while (!exportCondition.wait_for(exportLock, exportInterval, [] { return isStopRequested; }))
+            writeExportFile();
+    });
+    return true;
+}
+
+void stop() {
+    if (!exportThread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> exportLock(exportMutex);
+        isStopRequested = true;
+    }
+    exportCondition.notify_all();
+    exportThread.join();
+    writeExportFile();
+}
+
+}  // namespace SolverMetrics
@@ -0,0 +1,85 @@
+/* ----- ----- ----- ----- */
+// SolverMetrics.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/17
+// Update Date: 2026/10/17
+// Version: v1.1
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * @namespace SolverMetrics
+ * @brief Process-wide counters and histograms, exported as a Prometheus text file (`--metrics=<path>`).
+ *
+ * <summary>
+ * Recording is a relaxed atomic add, so the solver records unconditionally. When an
+ * export file is started, a background thread rewrites it every interval in the text
+ * exposition format: the content goes to `<path>.tmp`, which is then renamed over
+ * `<path>`, so node_exporter's textfile collector never reads a half-written file.
+ * `stop` writes the final values.
+ * </summary>
+ */
+namespace SolverMetrics {
+
+    /**
+     * @enum Counter
+     * @brief Monotonic counters (`_total` metrics).
+     */
+    enum class Counter {
+        SessionsStarted,      ///< Games started (an expression spec was read)
+        RoundsProcessed,      ///< Guess and feedback pairs processed
+        CandidatesGenerated,  ///< Candidates produced by first-round generation
+        SpeculationHits,      ///< Rounds answered by the speculative partition
+        SpeculationMisses,    ///< Rounds filtered because no partition matched
+        UniverseHits,         ///< Games that reused the built guess universe
+        UniverseMisses,       ///< Games that had to build the guess universe (or found it over the limit)
+        BookHits,             ///< Second guesses taken from the opening book
+        BookMisses,           ///< Second guesses the opening book had no reply for
+        EndgameMemoHits,      ///< Endgame subsets answered from the memo
+        EndgameMemoMisses,    ///< Endgame subsets searched
+        Count
+    };
+
+    /**
+     * @enum Histogram
+     * @brief Distributions with fixed buckets (`_bucket`, `_sum`, `_count` metrics).
+     */
+    enum class Histogram {
+        GenerateSeconds,  ///< First-round generation time (recorded in microseconds)
+        FilterSeconds,    ///< Later-round filtering time (recorded in microseconds)
+        RoundSurvivors,   ///< Candidates left after each round
+        Count
+    };
+
+    /**
+     * @brief Adds `value` to a counter.
+     */
+    void add(Counter counter, std::uint64_t value = 1);
+
+    /**
+     * @brief Records one value (microseconds for the `Seconds` histograms).
+     */
+    void observe(Histogram histogram, std::uint64_t value);
+
+    /**
+     * @brief Every metric in the Prometheus text exposition format.
+     */
+    std::string render();
+
+    /**
+     * @brief Starts rewriting `filePath` every `intervalMs` milliseconds (at least 100) on a background thread.
+     *
+     * @return true if the file could be written once.
+     */
+    bool start(const std::string& filePath, std::uint64_t intervalMs);
+
+    /**
+     * @brief Stops the background thread and writes the final values. Does nothing if not started.
+     */
+    void stop();
+
+}  // namespace SolverMetrics
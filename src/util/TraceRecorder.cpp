@@ -0,0 +1,158 @@
+/* ----- ----- ----- ----- */
+// TraceRecorder.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/17
+// Update Date: 2026/10/17
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#include "TraceRecorder.h"
+#include <atomic>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <unordered_set>
+
+namespace {
+
+constexpr long long UNASSIGNED_TRACK = -1;          ///< Thread has not recorded yet
+constexpr long long FIRST_OTHER_TRACK = 1000;       ///< Tracks of threads outside `runChunks` start here
+
+std::atomic<bool> isRecordingEnabled{false};        ///< Set between `start` and `stop`
+std::mutex traceMutex;                              ///< Guards the fields below
+std::ofstream traceStream;                          ///< Output file
+std::unordered_set<long long> namedTracksSet;       ///< Tracks whose name event was written
+std::chrono::steady_clock::time_point traceStartTime;  ///< Time 0 of the trace
+std::atomic<long long> nextOtherTrack{FIRST_OTHER_TRACK};
+
+thread_local long long currentTrack = UNASSIGNED_TRACK;   ///< Track of the calling thread
+thread_local const char* currentSpanName = nullptr;       ///< Innermost open span of the calling thread
+
+/**
+ * @brief Track of the calling thread, assigning a new one on first use.
+ */
+long long getTrack() {
+    if (currentTrack == UNASSIGNED_TRACK) currentTrack = nextOtherTrack.fetch_add(1);
+    return currentTrack;
+}
+
+/**
+ * @brief Microseconds since `traceStartTime`, as written in the `ts`/`dur` fields.
+ */
+double toMicroseconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+/**
+ * @brief Writes the thread-name metadata event of `track` once. Caller holds `traceMutex`.
+ */
+void nameTrack(long long track) {
+    if (!namedTracksSet.insert(track).second) return;
+    std::string trackName = (track == 0) ? "main"
+        : (track < FIRST_OTHER_TRACK) ? std::format("worker {}", track)
+        : std::format("thread {}", track - FIRST_OTHER_TRACK + 1);
+    traceStream << std::format(
+        "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"{}\"}}}},\n",
+        track, trackName);
+}
+
+}  // namespace (end of anonymous)
+
+/**
+ * @brief Starts recording into `filePath`; the calling thread becomes track 0.
+ *
+ * @param filePath Trace file, truncated.
+ * @return true if the file could be opened.
+ */
+bool TraceRecorder::start(const std::string& filePath) {
+    std::lock_guard<std::mutex> lock(traceMutex);
+    traceStream.open(filePath, std::ios::trunc);
+    if (!traceStream.is_open()) return false;
+
+    traceStream << "[\n";
+    traceStream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"MathExpressionsSolver\"}},\n";
+    namedTracksSet.clear();
+    currentTrack = 0;
+    traceStartTime = std::chrono::steady_clock::now();
+    isRecordingEnabled.store(true);
+    return true;
+}
+
+/**
+ * @brief Closes the event array and the file.
+ *
+ * <summary>
+ * The array ends with one last metadata event so the file is strict JSON
+ * (every earlier event is followed by a comma).
+ * </summary>
+ */
+void TraceRecorder::stop() {
+    if (!isRecordingEnabled.exchange(false)) return;
+    std::lock_guard<std::mutex> lock(traceMutex);
+    traceStream << "{\"name\":\"trace_end\",\"ph\":\"M\",\"pid\":1,\"args\":{}}\n]\n";
+    traceStream.close();
+}
+
+bool TraceRecorder::isEnabled() {
+    return isRecordingEnabled.load(std::memory_order_relaxed);
+}
+
+const char* TraceRecorder::getCurrentSpanName() {
+    return currentSpanName;
+}
+
+// ------------------------------
+// Span
+// ------------------------------
+
+TraceRecorder::Span::Span(const char* name)
+    : name(name), parentName(currentSpanName), isRecording(isEnabled()) {
+    currentSpanName = name;
+    if (isRecording) beginTime = std::chrono::steady_clock::now();
+}
+
+void TraceRecorder::Span::setArg(const char* key, long long value) {
+    if (argCount == MAX_ARG_COUNT) return;
+    argKeys[argCount] = key;
+    argValues[argCount] = value;
+    ++argCount;
+}
+
+/**
+ * @brief Writes the span as one complete ("X") event on the calling thread's track.
+ *
+ * <summary>
+ * The file is flushed after every top-level span of the main thread, so a process
+ * killed while waiting for input leaves a readable trace.
+ * </summary>
+ */
+TraceRecorder::Span::~Span() {
+    currentSpanName = parentName;
+    if (!isRecording || !isEnabled()) return;
+
+    const auto endTime = std::chrono::steady_clock::now();
+    std::string argsText;
+    for (size_t i = 0; i < argCount; ++i)
+        argsText += std::format("{}\"{}\":{}", (i == 0) ? "" : ",", argKeys[i], argValues[i]);
+
+    const long long track = getTrack();
+    std::lock_guard<std::mutex> lock(traceMutex);
+    nameTrack(track);
+    traceStream << std::format(
+        "{{\"name\":\"{}\",\"cat\":\"solver\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{},\"args\":{{{}}}}},\n",
+        name, toMicroseconds(beginTime - traceStartTime), toMicroseconds(endTime - beginTime), track, argsText);
+    if (track == 0 && parentName == nullptr) traceStream.flush();  // Top-level phase done; the solver may now wait for input
+}
+
+// ------------------------------
+// TrackScope
+// ------------------------------
+
+TraceRecorder::TrackScope::TrackScope(size_t trackIndex) : previousTrack(currentTrack) {
+    currentTrack = static_cast<long long>(trackIndex);
+}
+
+TraceRecorder::TrackScope::~TrackScope() {
+    currentTrack = previousTrack;
+}
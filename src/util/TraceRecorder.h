@@ -0,0 +1,107 @@
+/* ----- ----- ----- ----- */
+// TraceRecorder.h
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/17
+// Update Date: 2026/10/17
+// Version: v1.0
+/* ----- ----- ----- ----- */
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+/**
+ * @namespace TraceRecorder
+ * @brief Timeline of the solver phases, written as a Chrome trace JSON file (`--trace`).
+ *
+ * <summary>
+ * Phases open a `Span` for their duration; every finished span becomes one complete
+ * ("X") event of the file, on the track of the thread that ran it:
+ * - Track 0 is the thread that called `start` (the main thread).
+ * - Workers of `ParallelUtils::runChunks` use track `chunkIndex + 1` (`TrackScope`), and
+ *   their span repeats the name of the span that started the pass, so the chunks of one
+ *   pass line up under each other.
+ * - Any other thread gets its own track the first time it records.
+ * Events are appended as they finish and flushed after each top-level phase of the main
+ * thread, so the file can be opened (chrome://tracing, ui.perfetto.dev; both accept the
+ * unterminated array) even if the process is killed before `stop`. When no trace was
+ * started, a span only checks a flag.
+ * </summary>
+ */
+namespace TraceRecorder {
+
+    /**
+     * @brief Starts recording into `filePath` (truncated); the calling thread becomes track 0.
+     *
+     * @return true if the file could be opened.
+     */
+    bool start(const std::string& filePath);
+
+    /**
+     * @brief Closes the event array and the file. Does nothing if no trace was started.
+     */
+    void stop();
+
+    /**
+     * @brief True between `start` and `stop`.
+     */
+    bool isEnabled();
+
+    /**
+     * @brief Name of the innermost open span on the calling thread (nullptr if none).
+     */
+    const char* getCurrentSpanName();
+
+    /**
+     * @class Span
+     * @brief Records the time between construction and destruction as one event.
+     *
+     * <summary>
+     * `name` and argument keys must outlive the span (string literals); they are written
+     * to the file unescaped.
+     * </summary>
+     */
+    class Span {
+    public:
+        explicit Span(const char* name);
+        ~Span();
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+        /**
+         * @brief Attaches a numeric argument to the event (at most `MAX_ARG_COUNT`; extra ones are dropped).
+         */
+        void setArg(const char* key, long long value);
+
+        static constexpr size_t MAX_ARG_COUNT = 2;
+
+    private:
+        const char* name;                ///< Event name
+        const char* parentName;          ///< Span name restored when this one ends
+        bool isRecording;                ///< Trace was enabled at construction
+        std::chrono::steady_clock::time_point beginTime;
+        const char* argKeys[MAX_ARG_COUNT] = {};
+        long long argValues[MAX_ARG_COUNT] = {};
+        size_t argCount = 0;
+    };
+
+    /**
+     * @class TrackScope
+     * @brief Puts the calling thread's events on track `trackIndex` until the scope ends.
+     */
+    class TrackScope {
+    public:
+        explicit TrackScope(size_t trackIndex);
+        ~TrackScope();
+
+        TrackScope(const TrackScope&) = delete;
+        TrackScope& operator=(const TrackScope&) = delete;
+
+    private:
+        long long previousTrack;  ///< Track restored when the scope ends
+    };
+
+}  // namespace TraceRecorder
@@ -0,0 +1,430 @@
+/* ----- ----- ----- ----- */
+// bench_solver.cpp
+// Do not distribute or modify
+// Author: DragonTaki (https://github.com/DragonTaki)
+// Create Date: 2026/10/16
+// Update Date: 2026/10/17
+// Version: v1.3
+/* ----- ----- ----- ----- */
+
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/logging/AppLogger.h"
+#include "logic/CandidateGenerator.h"
+#include "logic/Constraint.h"
+#include "logic/ExpressionValidator.h"
+#include "logic/GuessUniverse.h"
+#include "logic/RoundManager.h"
+#include "logic/SolverOptions.h"
+#include "util/AllocationTracker.h"
+
+/**
+ * @file bench_solver.cpp
+ * @brief Fixed benchmark scenarios for the solver's hot paths (`MathExpressionsBench` target).
+ *
+ * <summary>
+ * Every scenario is run until `--min-ms` has elapsed (after one warm-up run) and reports
+ * ns/op, items/s and heap allocations per op. Allocations are counted by
+ * `AllocationTracker`, which the `MathExpressionsBench` target always builds with
+ * `TRACK_ALLOCATIONS`; without it the program refuses to run.
+ *
+ * With `--compare=<baseline.json>` (a file written by `--json`), every scenario is also
+ * checked against the baseline: it regresses if its allocations per op grew by more than
+ * `--max-alloc-growth` percent, and the program then exits with 1. Allocation counts do
+ * not depend on the machine, so the committed baseline can gate them anywhere.
+ *
+ * Throughput is only checked with `--check-throughput=<local.json>`, a baseline recorded
+ * with `--json` on the same machine: a scenario then also regresses if its items/s
+ * dropped by more than `--max-slowdown` percent. Scenarios missing from a baseline are
+ * reported but never fail.
+ *
+ * Usage: `MathExpressionsBench [--filter=<text>] [--min-ms=<ms>] [--json=<path>]
+ *         [--compare=<path>] [--max-alloc-growth=<percent>]
+ *         [--check-throughput=<path>] [--max-slowdown=<percent>]`
+ * </summary>
+ */
+
+namespace {
+
+volatile double evalSink = 0.0;  ///< Keeps the evaluated values alive
+
+// ------------------------------
+// Runner
+// ------------------------------
+
+/**
+ * @struct Scenario
+ * @brief One benchmark: `runOnce` does one op and returns the items it processed.
+ */
+struct Scenario {
+    std::string name;                   ///< Reported name
+    std::function<size_t()> runOnce;    ///< One op; returns items processed (candidates, expressions, ...)
+};
+
+/**
+ * @struct Measurement
+ * @brief Result of one scenario.
+ */
+struct Measurement {
+    std::string name;
+    size_t iterationCount = 0;
+    double nsPerOp = 0.0;
+    double itemsPerOp = 0.0;
+    double itemsPerSecond = 0.0;
+    double allocationsPerOp = 0.0;
+    double allocatedBytesPerOp = 0.0;
+};
+
+/**
+ * @brief Runs a scenario once to warm up, then until `minMs` has elapsed.
+ */
+Measurement measure(const Scenario& scenario, double minMs) {
+    scenario.runOnce();
+
+    Measurement measurement;
+    measurement.name = scenario.name;
+    size_t itemTotal = 0;
+    const AllocationTracker::Meter allocationMeter;
+    const auto startTime = std::chrono::steady_clock::now();
+    double elapsedNs = 0.0;
+    do {
+        itemTotal += scenario.runOnce();
+        ++measurement.iterationCount;
+        elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+    } while (elapsedNs < minMs * 1e6);
+
+    const double iterations = static_cast<double>(measurement.iterationCount);
+    measurement.nsPerOp = elapsedNs / iterations;
+    measurement.itemsPerOp = static_cast<double>(itemTotal) / iterations;
+    measurement.itemsPerSecond = static_cast<double>(itemTotal) / (elapsedNs / 1e9);
+    const AllocationTracker::Counts allocationCounts = allocationMeter.elapsed();
+    measurement.allocationsPerOp = static_cast<double>(allocationCounts.allocationCount) / iterations;
+    measurement.allocatedBytesPerOp = static_cast<double>(allocationCounts.allocatedBytes) / iterations;
+    return measurement;
+}
+
+/**
+ * @brief Writes the measurements as JSON (`{"benchmarks": [...]}`).
+ */
+bool writeJson(const std::string& filePath, const std::vector<Measurement>& measurementsList) {
+    std::ofstream ofs(filePath, std::ios::trunc);
+    if (!ofs.is_open()) return false;
+    ofs << "{\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < measurementsList.size(); ++i) {
+        const Measurement& measurement = measurementsList[i];
+        ofs << std::format(
+            "    {{\"name\": \"{}\", \"iterations\": {}, \"ns_per_op\": {:.1f}, \"items_per_op\": {:.1f}, "
+            "\"items_per_second\": {:.1f}, \"allocs_per_op\": {:.1f}, \"alloc_bytes_per_op\": {:.1f}}}{}\n",
+            measurement.name, measurement.iterationCount, measurement.nsPerOp, measurement.itemsPerOp,
+            measurement.itemsPerSecond, measurement.allocationsPerOp, measurement.allocatedBytesPerOp,
+            (i + 1 < measurementsList.size()) ? "," : "");
+    }
+    ofs << "  ]\n}\n";
+    return static_cast<bool>(ofs);
+}
+
+// ------------------------------
+// Baseline comparison
+// ------------------------------
+
+/**
+ * @brief Reads the number after `"key": ` in one line of a `writeJson` file.
+ */
+bool readJsonNumber(const std::string& line, std::string_view key, double& value) {
+    const std::string keyText = std::format("\"{}\": ", key);
+    const size_t keyPosition = line.find(keyText);
+    if (keyPosition == std::string::npos) return false;
+    const char* valueBegin = line.c_str() + keyPosition + keyText.size();
+    char* valueEnd = nullptr;
+    value = std::strtod(valueBegin, &valueEnd);
+    return valueEnd != valueBegin;
+}
+
+/**
+ * @brief Loads the measurements of a file written by `writeJson` (one benchmark per line).
+ *
+ * @param filePath Baseline file.
+ * @param[out] baselineMap Measurements by scenario name.
+ * @return true if the file could be read and held at least one benchmark.
+ */
+bool readBaseline(const std::string& filePath, std::unordered_map<std::string, Measurement>& baselineMap) {
+    std::ifstream ifs(filePath);
+    if (!ifs.is_open()) return false;
+
+    const std::string nameKey = "\"name\": \"";
+    std::string line;
+    while (std::getline(ifs, line)) {
+        const size_t namePosition = line.find(nameKey);
+        if (namePosition == std::string::npos) continue;
+        const size_t nameBegin = namePosition + nameKey.size();
+        const size_t nameEnd = line.find('"', nameBegin);
+        if (nameEnd == std::string::npos) continue;
+
+        Measurement measurement;
+        measurement.name = line.substr(nameBegin, nameEnd - nameBegin);
+        if (!readJsonNumber(line, "items_per_second", measurement.itemsPerSecond)
+            || !readJsonNumber(line, "allocs_per_op", measurement.allocationsPerOp))
+            continue;
+        readJsonNumber(line, "ns_per_op", measurement.nsPerOp);
+        baselineMap[measurement.name] = measurement;
+    }
+    return !baselineMap.empty();
+}
+
+/**
+ * @brief Prints every scenario against its baselines.
+ *
+ * @param measurementsList Measurements of this run.
+ * @param allocationBaselineMap Baseline of allocations per op, by scenario name (empty = not checked).
+ * @param throughputBaselineMap Local baseline of items/s, by scenario name (empty = not checked).
+ * @param maxSlowdownPercent Largest allowed drop of items/s.
+ * @param maxAllocationGrowthPercent Largest allowed growth of allocations per op.
+ * @return size_t Number of regressed scenarios.
+ */
+size_t compareWithBaseline(
+    const std::vector<Measurement>& measurementsList,
+    const std::unordered_map<std::string, Measurement>& allocationBaselineMap,
+    const std::unordered_map<std::string, Measurement>& throughputBaselineMap,
+    double maxSlowdownPercent,
+    double maxAllocationGrowthPercent
+) {
+    auto getChangePercent = [](double currentValue, double baselineValue) {
+        if (baselineValue == 0.0) return (currentValue == 0.0) ? 0.0 : 100.0;
+        return (currentValue - baselineValue) / baselineValue * 100.0;
+    };
+
+    // Change in percent of one value, or nothing if the scenario is not in the baseline
+    auto findChange = [&](const std::unordered_map<std::string, Measurement>& baselineMap, const std::string& name,
+        double Measurement::* valueMember, double currentValue) -> std::optional<double> {
+        auto baselineIt = baselineMap.find(name);
+        if (baselineIt == baselineMap.end()) return std::nullopt;
+        return getChangePercent(currentValue, baselineIt->second.*valueMember);
+    };
+    auto formatChange = [](const std::optional<double>& changePercent) {
+        return changePercent ? std::format("{:+.1f}%", *changePercent) : std::string("-");
+    };
+
+    size_t regressionCount = 0;
+    std::cout << std::format("\n{:<32} {:>12} {:>12} {}\n", "compared with baseline", "items/s", "allocs/op", "result");
+    for (const Measurement& measurement : measurementsList) {
+        const std::optional<double> throughputChange =
+            findChange(throughputBaselineMap, measurement.name, &Measurement::itemsPerSecond, measurement.itemsPerSecond);
+        const std::optional<double> allocationChange =
+            findChange(allocationBaselineMap, measurement.name, &Measurement::allocationsPerOp, measurement.allocationsPerOp);
+        const bool isSlower = throughputChange && *throughputChange < -maxSlowdownPercent;
+        const bool isAllocatingMore = allocationChange && *allocationChange > maxAllocationGrowthPercent;
+        const bool isMissing = (!allocationBaselineMap.empty() && !allocationChange)
+            || (!throughputBaselineMap.empty() && !throughputChange);
+        if (isSlower || isAllocatingMore) ++regressionCount;
+        std::cout << std::format("{:<32} {:>12} {:>12} {}\n", measurement.name, formatChange(throughputChange),
+            formatChange(allocationChange),
+            isSlower && isAllocatingMore ? "REGRESSION (slower, more allocations)"
+            : isSlower ? "REGRESSION (slower)" : isAllocatingMore ? "REGRESSION (more allocations)"
+            : isMissing ? "new (not in baseline)" : "ok");
+    }
+    return regressionCount;
+}
+
+// ------------------------------
+// Scenarios
+// ------------------------------
+
+/**
+ * @struct GenerateCase
+ * @brief First-round candidate generation from one guess and its feedback.
+ */
+struct GenerateCase {
+    std::string name;
+    int exprLength;
+    std::string operators;
+    std::string exprLine;
+    std::string exprColorLine;
+};
+
+const std::vector<GenerateCase> GENERATE_CASES = {
+    { "generate/9/198+7=205", 9, "+-*", "198+7=205", "yyyrrgrry" },        // tests/test_run.cpp case
+    { "generate/10/12*4+36=84", 10, "+-*/", "12*4+36=84", "ryrggrrgyy" },  // Answer 84/4+29=50
+    { "generate/12/36*27-90=882", 12, "+-*/", "36*27-90=882", "rrggrggryyrr" },  // Answer 48*25-9=1191
+};
+
+/**
+ * @brief Builds every scenario; the shared inputs are prepared once here.
+ */
+std::vector<Scenario> buildScenarios() {
+    std::vector<Scenario> scenariosList;
+
+    // CandidateGenerator::generate
+    for (const GenerateCase& generateCase : GENERATE_CASES) {
+        scenariosList.push_back({ generateCase.name, [generateCase]() {
+            std::unordered_set<char> operatorsSet(generateCase.operators.begin(), generateCase.operators.end());
+            ExpressionValidator validator;
+            validator.setValidOps(operatorsSet);
+            std::vector<std::string> expressions{ generateCase.exprLine };
+            std::vector<std::string> colors{ generateCase.exprColorLine };
+            std::unordered_map<char, Constraint> constraintsMap = deriveConstraints(expressions, colors, generateCase.exprLength);
+            CandidateGenerator generator(validator);
+            return generator.generate(generateCase.exprLength, operatorsSet, expressions, colors, constraintsMap).size();
+        } });
+    }
+
+    // Every valid length-8 expression: input of the eval and filter scenarios
+    static const std::unordered_set<char> operatorsSet = { '+', '-', '*', '/' };
+    static ExpressionValidator validator;
+    validator.setValidOps(operatorsSet);
+    static GuessUniverse guessUniverse;
+    guessUniverse.build(8, operatorsSet, validator, 0);  // 1761588 evaluations: no limit needed
+    static std::vector<std::string> expressionsList;
+    static std::vector<std::string> leftSidesList;
+    for (CandidateHandle handle = 0; handle < guessUniverse.size(); ++handle) {
+        std::string exprLine(guessUniverse.getPool().view(handle));
+        leftSidesList.push_back(exprLine.substr(0, exprLine.find('=')));
+        expressionsList.push_back(std::move(exprLine));
+    }
+
+    // ExpressionValidator::evalExpr
+    scenariosList.push_back({ "evalExpr/8/universe-lhs", []() {
+        double checksum = 0.0;
+        for (const std::string& leftSide : leftSidesList) checksum += validator.evalExpr(leftSide);
+        evalSink = checksum;
+        return leftSidesList.size();
+    } });
+
+    // ExpressionValidator::filterExpressions (answer 52-10=42)
+    static const std::unordered_map<char, Constraint> filterConstraintsMap =
+        deriveConstraints({ "12+34=46" }, { "ygrrrggr" }, 8);
+    scenariosList.push_back({ "filterExpressions/8/universe", []() {
+        validator.filterExpressions(expressionsList, filterConstraintsMap);
+        return expressionsList.size();
+    } });
+
+    // deriveConstraints
+    scenariosList.push_back({ "deriveConstraints/8/3-rounds", []() {
+        deriveConstraints({ "12+34=46", "58-16=42", "52-12=40" }, { "ygrrrggr", "grggrggg", "ggggrggr" }, 8);
+        return size_t{ 1 };
+    } });
+
+    // RoundManager::rollback: one op plays round 2 (filter) and undoes it, so the manager
+    // is back at the end of round 1 for the next op
+    scenariosList.push_back({ "rollback/8/filter-round-undo", []() {
+        static std::unique_ptr<RoundManager> roundManager = []() {
+            SolverOptions solverOptions;
+            solverOptions.suggestionCount = 0;
+            solverOptions.endgameMaxSurvivors = 0;
+            solverOptions.openingBookPath.clear();
+            solverOptions.speculateFeedback = false;
+            return std::make_unique<RoundManager>(solverOptions);
+        }();
+        static bool isStarted = false;
+
+        std::istringstream inputStream(isStarted ? "58-16=42\ngrggrggg\n" : "8+-*/\n12+34=46\nygrrrggr\n58-16=42\ngrggrggg\n");
+        std::streambuf* previousInput = std::cin.rdbuf(inputStream.rdbuf());
+        std::cin.clear();
+        if (!isStarted) roundManager->processRoundInput();
+        roundManager->processRoundInput();
+        isStarted = true;
+        roundManager->rollback();
+        std::cin.rdbuf(previousInput);
+        return size_t{ 1 };
+    } });
+
+    return scenariosList;
+}
+
+}  // namespace (end of anonymous)
+
+/**
+ * @brief Runs the scenarios matching `--filter`, prints a table and optionally writes JSON.
+ */
+int main(int argc, char* argv[]) {
+    std::string filterText;
+    std::string jsonPath;
+    std::string baselinePath;
+    std::string throughputBaselinePath;
+    double minMs = 500.0;
+    double maxSlowdownPercent = 10.0;
+    double maxAllocationGrowthPercent = 5.0;
+    for (int argIndex = 1; argIndex < argc; ++argIndex) {
+        std::string_view argument = argv[argIndex];
+        if (argument.starts_with("--filter=")) filterText = std::string(argument.substr(9));
+        else if (argument.starts_with("--json=")) jsonPath = std::string(argument.substr(7));
+        else if (argument.starts_with("--min-ms=")) minMs = std::atof(std::string(argument.substr(9)).c_str());
+        else if (argument.starts_with("--compare=")) baselinePath = std::string(argument.substr(10));
+        else if (argument.starts_with("--check-throughput=")) throughputBaselinePath = std::string(argument.substr(19));
+        else if (argument.starts_with("--max-slowdown=")) maxSlowdownPercent = std::atof(std::string(argument.substr(15)).c_str());
+        else if (argument.starts_with("--max-alloc-growth="))
+            maxAllocationGrowthPercent = std::atof(std::string(argument.substr(19)).c_str());
+        else {
+            std::cerr << "Unknown argument: " << argument << "\n";
+            return 2;
+        }
+    }
+
+    if (!AllocationTracker::isAvailable()) {
+        std::cerr << "Allocation counting is not compiled in; build with TRACK_ALLOCATIONS\n";
+        return 1;
+    }
+
+    AppLogger::SetLogLevel(LogLevel::Error);  // Rounds log at Debug/Info; keep the table readable
+
+    std::unordered_map<std::string, Measurement> baselineMap;
+    if (!baselinePath.empty() && !readBaseline(baselinePath, baselineMap)) {
+        std::cerr << "Failed to read baseline " << baselinePath << "\n";
+        return 1;
+    }
+    std::unordered_map<std::string, Measurement> throughputBaselineMap;
+    if (!throughputBaselinePath.empty() && !readBaseline(throughputBaselinePath, throughputBaselineMap)) {
+        std::cerr << "Failed to read throughput baseline " << throughputBaselinePath
+            << " (record one on this machine with --json=<path>)\n";
+        return 1;
+    }
+
+    std::vector<Measurement> measurementsList;
+    std::cout << std::format("{:<32} {:>10} {:>14} {:>14} {:>12} {:>14}\n",
+        "benchmark", "iterations", "ns/op", "items/s", "allocs/op", "bytes/op");
+    for (const Scenario& scenario : buildScenarios()) {
+        if (!filterText.empty() && scenario.name.find(filterText) == std::string::npos) continue;
+
+        // Round output (prompts, candidates) is not part of the table; without a log file the
+        // logger sends prompts to std::cerr
+        std::ostringstream discardStream;
+        std::streambuf* previousOutput = std::cout.rdbuf(discardStream.rdbuf());
+        std::streambuf* previousError = std::cerr.rdbuf(discardStream.rdbuf());
+        Measurement measurement = measure(scenario, minMs);
+        std::cout.rdbuf(previousOutput);
+        std::cerr.rdbuf(previousError);
+
+        std::cout << std::format("{:<32} {:>10} {:>14.0f} {:>14.0f} {:>12.1f} {:>14.0f}\n",
+            measurement.name, measurement.iterationCount, measurement.nsPerOp, measurement.itemsPerSecond,
+            measurement.allocationsPerOp, measurement.allocatedBytesPerOp);
+        measurementsList.push_back(std::move(measurement));
+    }
+
+    if (!jsonPath.empty() && !writeJson(jsonPath, measurementsList)) {
+        std::cerr << "Failed to write " << jsonPath << "\n";
+        return 1;
+    }
+
+    if (!baselineMap.empty() || !throughputBaselineMap.empty()) {
+        const size_t regressionCount = compareWithBaseline(measurementsList, baselineMap, throughputBaselineMap,
+            maxSlowdownPercent, maxAllocationGrowthPercent);
+        const std::string slowdownText = throughputBaselineMap.empty()
+            ? std::string("throughput not checked") : std::format("{:.1f}% slower", maxSlowdownPercent);
+        std::cout << std::format("{} regression(s) (tolerance: {}, {:.1f}% more allocations)\n",
+            regressionCount, slowdownText, maxAllocationGrowthPercent);
+        if (regressionCount > 0) return 1;
+    }
+    return 0;
+}
@@ -11,7 +11,7 @@
 #include <iostream>
 #include <string>
 
-#include "core/AppLogger.h"
+#include "core/logging/AppLogger.h"
 #include "logic/CandidateGenerator.h"
 #include "logic/Constraint.h"
 #include "logic/ExpressionValidator.h"
@@ -56,7 +56,7 @@ int main() {
 
         // === 6. 生成候選表達式 ===
         CandidateGenerator generator(validator);
-        vector<string> results = generator.generate(length, validOpsSet, expressions, colors);
+        vector<string> results = generator.generate(length, validOpsSet, expressions, colors, constraintsMap);
 
         AppLogger::Info(fmt::format("[Result] Total candidates = {}", results.size()));
 